@@ -168,19 +168,29 @@ group ""
 -- ========================
 -- Tests
 -- ========================
+include "test/CryptoTests.lua"
 include "test/ObjCommonTests.lua"
 include "test/ObjLoadingTests.lua"
+include "test/ObjWritingTests.lua"
 include "test/ParserTestUtils.lua"
 include "test/ParserTests.lua"
+include "test/UtilsTests.lua"
 include "test/ZoneCodeGeneratorLibTests.lua"
 include "test/ZoneCommonTests.lua"
+include "test/ZoneLoadingTests.lua"
+include "test/ZoneWritingTests.lua"
 
 -- Tests group: Unit test and other tests projects
 group "Tests"
+    CryptoTests:project()
     ObjCommonTests:project()
     ObjLoadingTests:project()
+    ObjWritingTests:project()
     ParserTestUtils:project()
     ParserTests:project()
+    UtilsTests:project()
     ZoneCodeGeneratorLibTests:project()
     ZoneCommonTests:project()
+    ZoneLoadingTests:project()
+    ZoneWritingTests:project()
 group ""
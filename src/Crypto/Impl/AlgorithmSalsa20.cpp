@@ -1,5 +1,6 @@
 #include "AlgorithmSalsa20.h"
 
+#include "Salsa20Kernel.h"
 #include "salsa20.h"
 
 #include <cassert>
@@ -8,9 +9,11 @@
 class AlgorithmSalsa20::AlgorithmSalsa20Impl
 {
     salsa20_ctx m_context{};
+    salsa20::kernel_t m_kernel;
 
 public:
     AlgorithmSalsa20Impl(const uint8_t* keyBytes, const size_t keySize)
+        : m_kernel(salsa20::GetKernel())
     {
         Salsa20_KeySetup(&m_context, keyBytes, keySize * 8);
     }
@@ -37,7 +40,7 @@ public:
 
     void Process(const void* plainText, void* cipherText, const size_t amount)
     {
-        Salsa20_Encrypt_Bytes(&m_context, static_cast<const uint8_t*>(plainText), static_cast<uint8_t*>(cipherText), amount);
+        m_kernel(m_context.m_input, static_cast<const uint8_t*>(plainText), static_cast<uint8_t*>(cipherText), amount);
     }
 };
 
@@ -0,0 +1,320 @@
+#include "Salsa20Kernel.h"
+
+#include <bit>
+
+#ifdef SALSA20_X86_KERNELS
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define SALSA20_TARGET(targetName)
+#else
+#define SALSA20_TARGET(targetName) __attribute__((target(targetName)))
+#endif
+
+// The 20 rounds of salsa20 are 10 double rounds consisting of a column round followed by a row round.
+// STEP(a, b, c, n) must perform x[a] ^= rotl(x[b] + x[c], n).
+#define SALSA20_DOUBLE_ROUND(STEP)                                                                                                                             \
+    STEP(4, 0, 12, 7);                                                                                                                                         \
+    STEP(8, 4, 0, 9);                                                                                                                                          \
+    STEP(12, 8, 4, 13);                                                                                                                                        \
+    STEP(0, 12, 8, 18);                                                                                                                                        \
+    STEP(9, 5, 1, 7);                                                                                                                                          \
+    STEP(13, 9, 5, 9);                                                                                                                                         \
+    STEP(1, 13, 9, 13);                                                                                                                                        \
+    STEP(5, 1, 13, 18);                                                                                                                                        \
+    STEP(14, 10, 6, 7);                                                                                                                                        \
+    STEP(2, 14, 10, 9);                                                                                                                                        \
+    STEP(6, 2, 14, 13);                                                                                                                                        \
+    STEP(10, 6, 2, 18);                                                                                                                                        \
+    STEP(3, 15, 11, 7);                                                                                                                                        \
+    STEP(7, 3, 15, 9);                                                                                                                                         \
+    STEP(11, 7, 3, 13);                                                                                                                                        \
+    STEP(15, 11, 7, 18);                                                                                                                                       \
+    STEP(1, 0, 3, 7);                                                                                                                                          \
+    STEP(2, 1, 0, 9);                                                                                                                                          \
+    STEP(3, 2, 1, 13);                                                                                                                                         \
+    STEP(0, 3, 2, 18);                                                                                                                                         \
+    STEP(6, 5, 4, 7);                                                                                                                                          \
+    STEP(7, 6, 5, 9);                                                                                                                                          \
+    STEP(4, 7, 6, 13);                                                                                                                                         \
+    STEP(5, 4, 7, 18);                                                                                                                                         \
+    STEP(11, 10, 9, 7);                                                                                                                                        \
+    STEP(8, 11, 10, 9);                                                                                                                                        \
+    STEP(9, 8, 11, 13);                                                                                                                                        \
+    STEP(10, 9, 8, 18);                                                                                                                                        \
+    STEP(12, 15, 14, 7);                                                                                                                                       \
+    STEP(13, 12, 15, 9);                                                                                                                                       \
+    STEP(14, 13, 12, 13);                                                                                                                                      \
+    STEP(15, 14, 13, 18)
+
+namespace
+{
+    constexpr size_t BLOCK_SIZE = 64;
+    constexpr auto DOUBLE_ROUND_COUNT = 10;
+
+    uint64_t GetCounter(const uint32_t state[16])
+    {
+        return static_cast<uint64_t>(state[8]) | static_cast<uint64_t>(state[9]) << 32;
+    }
+
+    void SetCounter(uint32_t state[16], const uint64_t counter)
+    {
+        state[8] = static_cast<uint32_t>(counter);
+        state[9] = static_cast<uint32_t>(counter >> 32);
+    }
+
+#ifdef SALSA20_X86_KERNELS
+    SALSA20_TARGET("sse2") void XorStore128(const uint8_t* input, uint8_t* output, const __m128i keyStream)
+    {
+        const auto in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_xor_si128(in, keyStream));
+    }
+
+    bool CpuSupportsSse2()
+    {
+#if defined(__x86_64__) || defined(_M_X64)
+        return true;
+#elif defined(_MSC_VER)
+        int cpuInfo[4];
+        __cpuid(cpuInfo, 1);
+        return (cpuInfo[3] & (1 << 26)) != 0;
+#else
+        return __builtin_cpu_supports("sse2");
+#endif
+    }
+
+    bool CpuSupportsAvx2()
+    {
+#ifdef _MSC_VER
+        int cpuInfo[4];
+        __cpuid(cpuInfo, 0);
+        if (cpuInfo[0] < 7)
+            return false;
+
+        // The os needs to save the ymm registers on context switches
+        __cpuid(cpuInfo, 1);
+        constexpr auto osXSaveAndAvx = (1 << 27) | (1 << 28);
+        if ((cpuInfo[2] & osXSaveAndAvx) != osXSaveAndAvx || (_xgetbv(0) & 6) != 6)
+            return false;
+
+        __cpuidex(cpuInfo, 7, 0);
+        return (cpuInfo[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif
+} // namespace
+
+namespace salsa20
+{
+    void ProcessScalar(uint32_t state[16], const uint8_t* input, uint8_t* output, size_t length)
+    {
+#define SALSA20_STEP_SCALAR(a, b, c, n) x[a] ^= std::rotl(x[b] + x[c], n)
+
+        while (length > 0)
+        {
+            uint32_t x[16];
+            for (auto i = 0; i < 16; i++)
+                x[i] = state[i];
+
+            for (auto i = 0; i < DOUBLE_ROUND_COUNT; i++)
+            {
+                SALSA20_DOUBLE_ROUND(SALSA20_STEP_SCALAR);
+            }
+
+            uint8_t keyStream[BLOCK_SIZE];
+            for (auto i = 0; i < 16; i++)
+            {
+                const auto word = x[i] + state[i];
+                keyStream[i * 4 + 0] = static_cast<uint8_t>(word);
+                keyStream[i * 4 + 1] = static_cast<uint8_t>(word >> 8);
+                keyStream[i * 4 + 2] = static_cast<uint8_t>(word >> 16);
+                keyStream[i * 4 + 3] = static_cast<uint8_t>(word >> 24);
+            }
+
+            SetCounter(state, GetCounter(state) + 1);
+
+            const auto blockLength = length < BLOCK_SIZE ? length : BLOCK_SIZE;
+            for (auto i = 0u; i < blockLength; i++)
+                output[i] = static_cast<uint8_t>(input[i] ^ keyStream[i]);
+
+            input += blockLength;
+            output += blockLength;
+            length -= blockLength;
+        }
+
+#undef SALSA20_STEP_SCALAR
+    }
+
+#ifdef SALSA20_X86_KERNELS
+    SALSA20_TARGET("sse2") void ProcessSse2(uint32_t state[16], const uint8_t* input, uint8_t* output, size_t length)
+    {
+#define SALSA20_STEP_SSE2(a, b, c, n)                                                                                                                          \
+    do                                                                                                                                                         \
+    {                                                                                                                                                          \
+        const auto sum = _mm_add_epi32(x[b], x[c]);                                                                                                            \
+        x[a] = _mm_xor_si128(x[a], _mm_or_si128(_mm_slli_epi32(sum, n), _mm_srli_epi32(sum, 32 - (n))));                                                      \
+    } while (false)
+
+        // Four blocks are processed at once with each vector holding one word of the state for all four blocks
+        constexpr auto PARALLEL_BLOCKS = 4u;
+        while (length >= BLOCK_SIZE * PARALLEL_BLOCKS)
+        {
+            const auto counter = GetCounter(state);
+
+            __m128i initial[16];
+            for (auto i = 0; i < 16; i++)
+                initial[i] = _mm_set1_epi32(static_cast<int>(state[i]));
+
+            initial[8] = _mm_set_epi32(static_cast<int>(static_cast<uint32_t>(counter + 3)),
+                                       static_cast<int>(static_cast<uint32_t>(counter + 2)),
+                                       static_cast<int>(static_cast<uint32_t>(counter + 1)),
+                                       static_cast<int>(static_cast<uint32_t>(counter)));
+            initial[9] = _mm_set_epi32(static_cast<int>(static_cast<uint32_t>((counter + 3) >> 32)),
+                                       static_cast<int>(static_cast<uint32_t>((counter + 2) >> 32)),
+                                       static_cast<int>(static_cast<uint32_t>((counter + 1) >> 32)),
+                                       static_cast<int>(static_cast<uint32_t>(counter >> 32)));
+
+            __m128i x[16];
+            for (auto i = 0; i < 16; i++)
+                x[i] = initial[i];
+
+            for (auto i = 0; i < DOUBLE_ROUND_COUNT; i++)
+            {
+                SALSA20_DOUBLE_ROUND(SALSA20_STEP_SSE2);
+            }
+
+            for (auto i = 0; i < 16; i += 4)
+            {
+                const auto w0 = _mm_add_epi32(x[i + 0], initial[i + 0]);
+                const auto w1 = _mm_add_epi32(x[i + 1], initial[i + 1]);
+                const auto w2 = _mm_add_epi32(x[i + 2], initial[i + 2]);
+                const auto w3 = _mm_add_epi32(x[i + 3], initial[i + 3]);
+
+                // Transpose to get words i to i + 3 of each block
+                const auto t0 = _mm_unpacklo_epi32(w0, w1);
+                const auto t1 = _mm_unpacklo_epi32(w2, w3);
+                const auto t2 = _mm_unpackhi_epi32(w0, w1);
+                const auto t3 = _mm_unpackhi_epi32(w2, w3);
+
+                const auto offset = static_cast<size_t>(i) * 4u;
+                XorStore128(&input[0 * BLOCK_SIZE + offset], &output[0 * BLOCK_SIZE + offset], _mm_unpacklo_epi64(t0, t1));
+                XorStore128(&input[1 * BLOCK_SIZE + offset], &output[1 * BLOCK_SIZE + offset], _mm_unpackhi_epi64(t0, t1));
+                XorStore128(&input[2 * BLOCK_SIZE + offset], &output[2 * BLOCK_SIZE + offset], _mm_unpacklo_epi64(t2, t3));
+                XorStore128(&input[3 * BLOCK_SIZE + offset], &output[3 * BLOCK_SIZE + offset], _mm_unpackhi_epi64(t2, t3));
+            }
+
+            SetCounter(state, counter + PARALLEL_BLOCKS);
+            input += BLOCK_SIZE * PARALLEL_BLOCKS;
+            output += BLOCK_SIZE * PARALLEL_BLOCKS;
+            length -= BLOCK_SIZE * PARALLEL_BLOCKS;
+        }
+
+        ProcessScalar(state, input, output, length);
+
+#undef SALSA20_STEP_SSE2
+    }
+
+    SALSA20_TARGET("avx2") void ProcessAvx2(uint32_t state[16], const uint8_t* input, uint8_t* output, size_t length)
+    {
+#define SALSA20_STEP_AVX2(a, b, c, n)                                                                                                                          \
+    do                                                                                                                                                         \
+    {                                                                                                                                                          \
+        const auto sum = _mm256_add_epi32(x[b], x[c]);                                                                                                         \
+        x[a] = _mm256_xor_si256(x[a], _mm256_or_si256(_mm256_slli_epi32(sum, n), _mm256_srli_epi32(sum, 32 - (n))));                                          \
+    } while (false)
+
+        // Eight blocks are processed at once with each vector holding one word of the state for all eight blocks
+        constexpr auto PARALLEL_BLOCKS = 8u;
+        while (length >= BLOCK_SIZE * PARALLEL_BLOCKS)
+        {
+            const auto counter = GetCounter(state);
+
+            __m256i initial[16];
+            for (auto i = 0; i < 16; i++)
+                initial[i] = _mm256_set1_epi32(static_cast<int>(state[i]));
+
+            int counterLow[PARALLEL_BLOCKS];
+            int counterHigh[PARALLEL_BLOCKS];
+            for (auto block = 0u; block < PARALLEL_BLOCKS; block++)
+            {
+                counterLow[block] = static_cast<int>(static_cast<uint32_t>(counter + block));
+                counterHigh[block] = static_cast<int>(static_cast<uint32_t>((counter + block) >> 32));
+            }
+            initial[8] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(counterLow));
+            initial[9] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(counterHigh));
+
+            __m256i x[16];
+            for (auto i = 0; i < 16; i++)
+                x[i] = initial[i];
+
+            for (auto i = 0; i < DOUBLE_ROUND_COUNT; i++)
+            {
+                SALSA20_DOUBLE_ROUND(SALSA20_STEP_AVX2);
+            }
+
+            for (auto i = 0; i < 16; i += 4)
+            {
+                const auto w0 = _mm256_add_epi32(x[i + 0], initial[i + 0]);
+                const auto w1 = _mm256_add_epi32(x[i + 1], initial[i + 1]);
+                const auto w2 = _mm256_add_epi32(x[i + 2], initial[i + 2]);
+                const auto w3 = _mm256_add_epi32(x[i + 3], initial[i + 3]);
+
+                // Transpose within both 128 bit lanes: The low lane holds blocks 0 to 3, the high lane blocks 4 to 7
+                const auto t0 = _mm256_unpacklo_epi32(w0, w1);
+                const auto t1 = _mm256_unpacklo_epi32(w2, w3);
+                const auto t2 = _mm256_unpackhi_epi32(w0, w1);
+                const auto t3 = _mm256_unpackhi_epi32(w2, w3);
+
+                const __m256i blockWords[4]{
+                    _mm256_unpacklo_epi64(t0, t1),
+                    _mm256_unpackhi_epi64(t0, t1),
+                    _mm256_unpacklo_epi64(t2, t3),
+                    _mm256_unpackhi_epi64(t2, t3),
+                };
+
+                const auto offset = static_cast<size_t>(i) * 4u;
+                for (auto block = 0u; block < 4u; block++)
+                {
+                    const auto lowOffset = block * BLOCK_SIZE + offset;
+                    const auto highOffset = (block + 4u) * BLOCK_SIZE + offset;
+                    const auto lowIn = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[lowOffset]));
+                    const auto highIn = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[highOffset]));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(&output[lowOffset]), _mm_xor_si128(lowIn, _mm256_castsi256_si128(blockWords[block])));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(&output[highOffset]), _mm_xor_si128(highIn, _mm256_extracti128_si256(blockWords[block], 1)));
+                }
+            }
+
+            SetCounter(state, counter + PARALLEL_BLOCKS);
+            input += BLOCK_SIZE * PARALLEL_BLOCKS;
+            output += BLOCK_SIZE * PARALLEL_BLOCKS;
+            length -= BLOCK_SIZE * PARALLEL_BLOCKS;
+        }
+
+        ProcessSse2(state, input, output, length);
+
+#undef SALSA20_STEP_AVX2
+    }
+#endif
+
+    kernel_t GetKernel()
+    {
+        static const kernel_t kernel = []() -> kernel_t
+        {
+#ifdef SALSA20_X86_KERNELS
+            if (CpuSupportsAvx2())
+                return ProcessAvx2;
+            if (CpuSupportsSse2())
+                return ProcessSse2;
+#endif
+            return ProcessScalar;
+        }();
+
+        return kernel;
+    }
+} // namespace salsa20
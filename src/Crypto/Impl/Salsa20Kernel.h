@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace salsa20
+{
+    /**
+     * \brief Xors the keystream of the specified salsa20 state onto the input and writes it to the output.
+     * Every call starts at a new keystream block. The block counter in state words 8 and 9 is advanced by every started block,
+     * which makes all kernels behave exactly like Salsa20_Encrypt_Bytes.
+     * Input and output may be the same buffer.
+     */
+    using kernel_t = void (*)(uint32_t state[16], const uint8_t* input, uint8_t* output, size_t length);
+
+    void ProcessScalar(uint32_t state[16], const uint8_t* input, uint8_t* output, size_t length);
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SALSA20_X86_KERNELS
+    void ProcessSse2(uint32_t state[16], const uint8_t* input, uint8_t* output, size_t length);
+    void ProcessAvx2(uint32_t state[16], const uint8_t* input, uint8_t* output, size_t length);
+#endif
+
+    /**
+     * \brief Returns the fastest kernel that is supported by the cpu of this machine.
+     */
+    kernel_t GetKernel();
+} // namespace salsa20
@@ -52,13 +52,11 @@ std::unique_ptr<Zone> ZoneCreator::CreateZoneForDefinition(ZoneCreationContext&
 
     const auto assetLoadingContext = std::make_unique<AssetLoadingContext>(*zone, *context.m_asset_search_path, CreateGdtList(context));
     ApplyIgnoredAssets(context, *assetLoadingContext);
+    assetLoadingContext->m_output_folder = context.m_output_folder;
 
     const auto* objLoader = IObjLoader::GetObjLoaderForGame(GameId::IW5);
-    for (const auto& assetEntry : context.m_definition->m_assets)
-    {
-        if (!objLoader->LoadAssetForZone(*assetLoadingContext, assetEntry.m_asset_type, assetEntry.m_asset_name))
-            return nullptr;
-    }
+    if (!LoadAssetsOfDefinition(*objLoader, *assetLoadingContext, *context.m_definition))
+        return nullptr;
 
     objLoader->FinalizeAssetsForZone(*assetLoadingContext);
 
@@ -4,11 +4,13 @@
 #include "LinkerSearchPaths.h"
 #include "ObjContainer/IPak/IPakWriter.h"
 #include "ObjContainer/IWD/IWD.h"
-#include "ObjContainer/SoundBank/SoundBankWriter.h"
 #include "ObjLoading.h"
 #include "ObjWriting.h"
+#include "Pool/GlobalAssetPoolIsolation.h"
 #include "SearchPath/SearchPaths.h"
 #include "Utils/ObjFileStream.h"
+#include "Utils/OutputCapture.h"
+#include "Utils/ThreadPool.h"
 #include "Zone/AssetList/AssetList.h"
 #include "Zone/AssetList/AssetListStream.h"
 #include "Zone/Definition/ZoneDefinitionStream.h"
@@ -17,16 +19,55 @@
 #include "ZoneLoading.h"
 #include "ZoneWriting.h"
 
+#include <atomic>
 #include <deque>
 #include <filesystem>
 #include <format>
 #include <fstream>
+#include <future>
+#include <optional>
 #include <set>
 
 namespace fs = std::filesystem;
 
 class LinkerImpl final : public Linker
 {
+    class ProjectTarget
+    {
+    public:
+        std::string m_project_name;
+        std::string m_target_name;
+        std::unique_ptr<ZoneDefinition> m_definition;
+        bool m_referenced;
+    };
+
+    /**
+     * \brief Unloads the project specific search paths of a target when building it is done, also when building it threw.
+     */
+    class ProjectSearchPathsUnloader
+    {
+    public:
+        ProjectSearchPathsUnloader(LinkerSearchPaths& searchPaths, SearchPaths& assetSearchPaths)
+            : m_search_paths(searchPaths),
+              m_asset_search_paths(assetSearchPaths)
+        {
+        }
+
+        ~ProjectSearchPathsUnloader()
+        {
+            m_search_paths.UnloadProjectSpecificSearchPaths(m_asset_search_paths);
+        }
+
+        ProjectSearchPathsUnloader(const ProjectSearchPathsUnloader& other) = delete;
+        ProjectSearchPathsUnloader(ProjectSearchPathsUnloader&& other) noexcept = delete;
+        ProjectSearchPathsUnloader& operator=(const ProjectSearchPathsUnloader& other) = delete;
+        ProjectSearchPathsUnloader& operator=(ProjectSearchPathsUnloader&& other) noexcept = delete;
+
+    private:
+        LinkerSearchPaths& m_search_paths;
+        SearchPaths& m_asset_search_paths;
+    };
+
     LinkerArgs m_args;
     LinkerSearchPaths m_search_paths;
     std::vector<std::unique_ptr<Zone>> m_loaded_zones;
@@ -215,13 +256,15 @@ class LinkerImpl final : public Linker
         return true;
     }
 
-    std::unique_ptr<Zone> CreateZoneForDefinition(const std::string& targetName,
+    std::unique_ptr<Zone> CreateZoneForDefinition(const std::string& projectName,
+                                                  const std::string& targetName,
                                                   ZoneDefinition& zoneDefinition,
                                                   ISearchPath* assetSearchPath,
                                                   ISearchPath* gdtSearchPath,
                                                   ISearchPath* sourceSearchPath) const
     {
         const auto context = std::make_unique<ZoneCreationContext>(&zoneDefinition, assetSearchPath);
+        context->m_output_folder = fs::path(m_args.GetOutputFolderPathForProject(projectName));
         if (!ProcessZoneDefinitionIgnores(targetName, *context, sourceSearchPath))
             return nullptr;
         if (!LoadGdtFilesFromZoneDefinition(context->m_gdt_files, zoneDefinition, gdtSearchPath))
@@ -268,9 +311,10 @@ class LinkerImpl final : public Linker
                        SearchPaths& gdtSearchPaths,
                        SearchPaths& sourceSearchPaths) const
     {
-        SoundBankWriter::OutputPath = fs::path(m_args.GetOutputFolderPathForProject(projectName));
+        // Other targets may be built at the same time and must not be able to use the assets of this zone
+        const GlobalAssetPoolIsolation isolation;
 
-        const auto zone = CreateZoneForDefinition(targetName, zoneDefinition, &assetSearchPaths, &gdtSearchPaths, &sourceSearchPaths);
+        const auto zone = CreateZoneForDefinition(projectName, targetName, zoneDefinition, &assetSearchPaths, &gdtSearchPaths, &sourceSearchPaths);
         auto result = zone != nullptr;
         if (zone)
             result = WriteZoneToFile(projectName, zone.get());
@@ -314,10 +358,29 @@ class LinkerImpl final : public Linker
         return true;
     }
 
-    bool BuildReferencedTargets(const std::string& projectName, const std::string& targetName, const ZoneDefinition& zoneDefinition)
+    /**
+     * \brief Reads the definition of a target and of all targets it references. Each target is only added once, before the targets it references.
+     */
+    bool ResolveProjectTargets(const std::string& projectName, const std::string& targetName, const bool referenced, std::vector<ProjectTarget>& targets)
     {
-        return std::ranges::all_of(zoneDefinition.m_targets_to_build,
-                                   [this, &projectName, &targetName](const std::string& buildTargetName)
+        const auto alreadyResolved = std::ranges::any_of(targets,
+                                                         [&projectName, &targetName](const ProjectTarget& target)
+                                                         {
+                                                             return target.m_project_name == projectName && target.m_target_name == targetName;
+                                                         });
+        if (alreadyResolved)
+            return true;
+
+        auto sourceSearchPaths = m_search_paths.GetSourceSearchPathsForProject(projectName);
+        auto zoneDefinition = ReadZoneDefinition(targetName, &sourceSearchPaths);
+        if (!zoneDefinition)
+            return false;
+
+        const auto targetsToBuild = zoneDefinition->m_targets_to_build;
+        targets.emplace_back(ProjectTarget{projectName, targetName, std::move(zoneDefinition), referenced});
+
+        return std::ranges::all_of(targetsToBuild,
+                                   [this, &projectName, &targetName, &targets](const std::string& buildTargetName)
                                    {
                                        if (buildTargetName == targetName)
                                        {
@@ -325,50 +388,192 @@ class LinkerImpl final : public Linker
                                            return false;
                                        }
 
-                                       std::cout << std::format("Building referenced target \"{}\"\n", buildTargetName);
-                                       return BuildProject(projectName, buildTargetName);
+                                       return ResolveProjectTargets(projectName, buildTargetName, true, targets);
                                    });
     }
 
-    bool BuildProject(const std::string& projectName, const std::string& targetName)
+    bool BuildProjectTarget(const ProjectTarget& target)
     {
+        auto& zoneDefinition = *target.m_definition;
+        if (zoneDefinition.m_type == ProjectType::NONE)
+            return true;
+
+        const auto& projectName = target.m_project_name;
+        const auto& gameName = GameId_Names[static_cast<unsigned>(zoneDefinition.m_game)];
         auto sourceSearchPaths = m_search_paths.GetSourceSearchPathsForProject(projectName);
+        auto assetSearchPaths = m_search_paths.GetAssetSearchPathsForProject(gameName, projectName);
+        auto gdtSearchPaths = m_search_paths.GetGdtSearchPathsForProject(gameName, projectName);
+        const ProjectSearchPathsUnloader searchPathsUnloader(m_search_paths, assetSearchPaths);
+
+        bool result;
+        switch (zoneDefinition.m_type)
+        {
+        case ProjectType::FASTFILE:
+            result = BuildFastFile(projectName, target.m_target_name, zoneDefinition, assetSearchPaths, gdtSearchPaths, sourceSearchPaths);
+            break;
+
+        case ProjectType::IPAK:
+            result = BuildIPak(projectName, zoneDefinition, assetSearchPaths);
+            break;
+
+        default:
+            assert(false);
+            result = false;
+            break;
+        }
+
+        return result;
+    }
 
-        const auto zoneDefinition = ReadZoneDefinition(targetName, &sourceSearchPaths);
+    /**
+     * \brief Reads the definition of a target, builds it and then does the same for the targets it references.
+     * Each target is only built once.
+     */
+    bool BuildProjectTargetAndReferences(const std::string& projectName,
+                                         const std::string& targetName,
+                                         const bool referenced,
+                                         std::set<std::pair<std::string, std::string>>& builtTargets)
+    {
+        if (!builtTargets.emplace(projectName, targetName).second)
+            return true;
+
+        if (referenced)
+            std::cout << std::format("Building referenced target \"{}\"\n", targetName);
+
+        auto sourceSearchPaths = m_search_paths.GetSourceSearchPathsForProject(projectName);
+        auto zoneDefinition = ReadZoneDefinition(targetName, &sourceSearchPaths);
         if (!zoneDefinition)
             return false;
 
-        auto result = true;
-        if (zoneDefinition->m_type != ProjectType::NONE)
+        const ProjectTarget target{projectName, targetName, std::move(zoneDefinition), referenced};
+        if (!BuildProjectTarget(target))
+            return false;
+
+        return std::ranges::all_of(target.m_definition->m_targets_to_build,
+                                   [this, &projectName, &targetName, &builtTargets](const std::string& buildTargetName)
+                                   {
+                                       if (buildTargetName == targetName)
+                                       {
+                                           std::cerr << std::format("Cannot build target with same name: \"{}\"\n", targetName);
+                                           return false;
+                                       }
+
+                                       return BuildProjectTargetAndReferences(projectName, buildTargetName, true, builtTargets);
+                                   });
+    }
+
+    /**
+     * \brief Builds all targets at the same time with as many threads as jobs were specified.
+     * The output of each target is collected and printed in the order of the targets once it is finished.
+     */
+    bool BuildProjectTargetsConcurrently(const std::vector<ProjectTarget>& targets)
+    {
+        class TargetBuild
         {
-            const auto& gameName = GameId_Names[static_cast<unsigned>(zoneDefinition->m_game)];
-            auto assetSearchPaths = m_search_paths.GetAssetSearchPathsForProject(gameName, projectName);
-            auto gdtSearchPaths = m_search_paths.GetGdtSearchPathsForProject(gameName, projectName);
+        public:
+            OutputCapture m_output;
+            std::promise<bool> m_result;
+        };
 
-            switch (zoneDefinition->m_type)
-            {
-            case ProjectType::FASTFILE:
-                result = BuildFastFile(projectName, targetName, *zoneDefinition, assetSearchPaths, gdtSearchPaths, sourceSearchPaths);
-                break;
+        std::vector<TargetBuild> builds(targets.size());
+        std::atomic_bool failed = false;
 
-            case ProjectType::IPAK:
-                result = BuildIPak(projectName, *zoneDefinition, assetSearchPaths);
-                break;
+        const OutputCapture::Redirection redirection;
+        std::vector<std::future<bool>> results;
+        results.reserve(builds.size());
 
-            default:
-                assert(false);
-                result = false;
-                break;
-            }
+        // Destroying the pool waits for all started builds, so it must be destroyed before anything they use
+        ThreadPool pool(m_args.m_jobs);
+        for (auto i = 0u; i < targets.size(); i++)
+        {
+            results.emplace_back(builds[i].m_result.get_future());
+            pool.Submit(
+                [this, &target = targets[i], &build = builds[i], &failed]
+                {
+                    // Like building sequentially, no new targets are started after one failed
+                    if (failed)
+                    {
+                        build.m_result.set_value(false);
+                        return;
+                    }
+
+                    try
+                    {
+                        bool result;
+                        {
+                            const OutputCapture::Activation activation(build.m_output);
+                            if (target.m_referenced)
+                                std::cout << std::format("Building referenced target \"{}\"\n", target.m_target_name);
+
+                            result = BuildProjectTarget(target);
+                        }
+
+                        if (!result)
+                            failed = true;
+                        build.m_result.set_value(result);
+                    }
+                    catch (...)
+                    {
+                        failed = true;
+                        build.m_result.set_exception(std::current_exception());
+                    }
+                });
         }
 
-        m_search_paths.UnloadProjectSpecificSearchPaths();
+        auto result = true;
+        for (auto i = 0u; i < builds.size(); i++)
+        {
+            results[i].wait();
+            builds[i].m_output.Print();
 
-        result = result && BuildReferencedTargets(projectName, targetName, *zoneDefinition);
+            if (!results[i].get())
+                result = false;
+        }
 
         return result;
     }
 
+    /**
+     * \brief Builds the specified projects one after another, each target followed by the targets it references.
+     * Reads the definition of a target only when it is about to be built, so a build fails at the same point as it always did.
+     */
+    bool BuildProjectsSequentially()
+    {
+        std::set<std::pair<std::string, std::string>> builtTargets;
+        for (const auto& projectSpecifier : m_args.m_project_specifiers_to_build)
+        {
+            std::string projectName;
+            std::string targetName;
+            if (!GetProjectAndTargetFromProjectSpecifier(projectSpecifier, projectName, targetName))
+                return false;
+
+            if (!BuildProjectTargetAndReferences(projectName, targetName, false, builtTargets))
+                return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * \brief Resolves all targets of the specified projects up front so the ones that don't depend on each other can be built at the same time.
+     */
+    bool BuildProjectsConcurrently()
+    {
+        std::vector<ProjectTarget> targets;
+        for (const auto& projectSpecifier : m_args.m_project_specifiers_to_build)
+        {
+            std::string projectName;
+            std::string targetName;
+            if (!GetProjectAndTargetFromProjectSpecifier(projectSpecifier, projectName, targetName)
+                || !ResolveProjectTargets(projectName, targetName, false, targets))
+            {
+                return false;
+            }
+        }
+
+        return BuildProjectTargetsConcurrently(targets);
+    }
+
     bool LoadZones()
     {
         for (const auto& zonePath : m_args.m_zones_to_load)
@@ -472,22 +677,14 @@ public:
         if (!LoadZones())
             return false;
 
-        auto result = true;
-        for (const auto& projectSpecifier : m_args.m_project_specifiers_to_build)
+        bool result;
         {
-            std::string projectName;
-            std::string targetName;
-            if (!GetProjectAndTargetFromProjectSpecifier(projectSpecifier, projectName, targetName))
-            {
-                result = false;
-                break;
-            }
+            // Preloads of assets print on worker threads. Their output is captured and shown once their asset is loaded.
+            std::optional<OutputCapture::Redirection> redirection;
+            if (ObjLoading::Configuration.ParallelLoading)
+                redirection.emplace();
 
-            if (!BuildProject(projectName, targetName))
-            {
-                result = false;
-                break;
-            }
+            result = m_args.m_jobs > 1 ? BuildProjectsConcurrently() : BuildProjectsSequentially();
         }
 
         UnloadZones();
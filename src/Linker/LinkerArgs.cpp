@@ -5,7 +5,10 @@
 #include "ObjWriting.h"
 #include "Utils/Arguments/UsageInformation.h"
 #include "Utils/FileUtils.h"
+#include "ZoneLoading.h"
+#include "ZoneWriting.h"
 
+#include <charconv>
 #include <filesystem>
 #include <format>
 #include <iostream>
@@ -96,6 +99,21 @@ const CommandLineOption* const OPTION_LOAD =
     .Reusable()
     .Build();
 
+const CommandLineOption* const OPTION_JOBS =
+    CommandLineOption::Builder::Create()
+    .WithShortName("j")
+    .WithLongName("jobs")
+    .WithDescription("Builds up to the specified amount of projects and referenced targets at the same time. Each build needs its own memory. "
+                        "Defaults to 1.")
+    .WithParameter("jobCount")
+    .Build();
+
+const CommandLineOption* const OPTION_PARALLEL_LOADING =
+    CommandLineOption::Builder::Create()
+    .WithLongName("parallel-loading")
+    .WithDescription("Reads the files of assets on worker threads while other assets are loaded. Does not change the built zones.")
+    .Build();
+
 const CommandLineOption* const OPTION_MENU_PERMISSIVE =
     CommandLineOption::Builder::Create()
     .WithLongName("menu-permissive")
@@ -109,6 +127,66 @@ const CommandLineOption* const OPTION_MENU_NO_OPTIMIZATION =
                         "information when dumped though.)")
     .Build();
 
+const CommandLineOption* const OPTION_ZONE_CACHE =
+    CommandLineOption::Builder::Create()
+    .WithLongName("zone-cache")
+    .WithDescription("Caches decrypted and decompressed zone data in the specified folder to speed up loading the same zones again.")
+    .WithParameter("cacheFolderPath")
+    .Build();
+
+const CommandLineOption* const OPTION_PROFILE =
+    CommandLineOption::Builder::Create()
+    .WithLongName("profile")
+    .WithDescription("Prints where the time of loading each zone was spent.")
+    .Build();
+
+const CommandLineOption* const OPTION_PROFILE_JSON =
+    CommandLineOption::Builder::Create()
+    .WithLongName("profile-json")
+    .WithDescription("Appends a JSON report of where the time of loading each zone was spent to the specified file, one zone per line.")
+    .WithParameter("profileFilePath")
+    .Build();
+
+const CommandLineOption* const OPTION_COMPRESSION_LEVEL =
+    CommandLineOption::Builder::Create()
+    .WithLongName("compression-level")
+    .WithDescription("Compresses zones with the specified deflate level from 0 to 9 for faster iteration builds. 1 is the fastest level, 0 stores the data "
+                        "uncompressed. Defaults to the level of the original linker of the game.")
+    .WithParameter("level")
+    .Build();
+
+const CommandLineOption* const OPTION_RELEASE =
+    CommandLineOption::Builder::Create()
+    .WithLongName("release")
+    .WithDescription("Compresses zones with the level of the original linker of the game, ignoring any other specified compression level.")
+    .Build();
+
+const CommandLineOption* const OPTION_DEDUPLICATE_CONTENT =
+    CommandLineOption::Builder::Create()
+    .WithLongName("deduplicate-content")
+    .WithDescription("Writes data of zones that is identical to previously written data only once. With --verbose, prints how many bytes that saved.")
+    .Build();
+
+const CommandLineOption* const OPTION_STREAM_CONTENT =
+    CommandLineOption::Builder::Create()
+    .WithLongName("stream-content")
+    .WithDescription("Writes the content of zones in two passes to compress it while it is being written instead of keeping all of it in memory. "
+                        "Lowers the memory usage for big zones.")
+    .Build();
+
+const CommandLineOption* const OPTION_SIZE_REPORT =
+    CommandLineOption::Builder::Create()
+    .WithLongName("size-report")
+    .WithDescription("Prints how many bytes each asset takes up in each block of the written zones and its share of the compressed size.")
+    .Build();
+
+const CommandLineOption* const OPTION_SIZE_REPORT_JSON =
+    CommandLineOption::Builder::Create()
+    .WithLongName("size-report-json")
+    .WithDescription("Appends a JSON report of how many bytes each asset takes up in the written zones to the specified file, one zone per line.")
+    .WithParameter("reportFilePath")
+    .Build();
+
 // clang-format on
 
 const CommandLineOption* const COMMAND_LINE_OPTIONS[]{
@@ -123,12 +201,24 @@ const CommandLineOption* const COMMAND_LINE_OPTIONS[]{
     OPTION_ADD_SOURCE_SEARCH_PATH,
     OPTION_SOURCE_SEARCH_PATH,
     OPTION_LOAD,
+    OPTION_JOBS,
+    OPTION_PARALLEL_LOADING,
     OPTION_MENU_PERMISSIVE,
     OPTION_MENU_NO_OPTIMIZATION,
+    OPTION_ZONE_CACHE,
+    OPTION_PROFILE,
+    OPTION_PROFILE_JSON,
+    OPTION_COMPRESSION_LEVEL,
+    OPTION_RELEASE,
+    OPTION_DEDUPLICATE_CONTENT,
+    OPTION_STREAM_CONTENT,
+    OPTION_SIZE_REPORT,
+    OPTION_SIZE_REPORT_JSON,
 };
 
 LinkerArgs::LinkerArgs()
     : m_verbose(false),
+      m_jobs(1u),
       m_base_folder_depends_on_project(false),
       m_out_folder_depends_on_project(false),
       m_argument_parser(COMMAND_LINE_OPTIONS, std::extent_v<decltype(COMMAND_LINE_OPTIONS)>),
@@ -170,6 +260,8 @@ void LinkerArgs::SetVerbose(const bool isVerbose)
     m_verbose = isVerbose;
     ObjLoading::Configuration.Verbose = isVerbose;
     ObjWriting::Configuration.Verbose = isVerbose;
+    ZoneLoading::Configuration.Verbose = isVerbose;
+    ZoneWriting::Configuration.Verbose = isVerbose;
 }
 
 std::string LinkerArgs::GetBasePathForProject(const std::string& projectName) const
@@ -348,6 +440,22 @@ bool LinkerArgs::ParseArgs(const int argc, const char** argv, bool& shouldContin
     if (m_argument_parser.IsOptionSpecified(OPTION_LOAD))
         m_zones_to_load = m_argument_parser.GetParametersForOption(OPTION_LOAD);
 
+    // -j; --jobs
+    if (m_argument_parser.IsOptionSpecified(OPTION_JOBS))
+    {
+        const auto jobsString = m_argument_parser.GetValueForOption(OPTION_JOBS);
+        const auto* jobsEnd = jobsString.data() + jobsString.size();
+        const auto [parseEnd, error] = std::from_chars(jobsString.data(), jobsEnd, m_jobs);
+        if (error != std::errc() || parseEnd != jobsEnd || m_jobs == 0)
+        {
+            std::cerr << std::format("Invalid job count \"{}\". Must be a number greater than 0.\n", jobsString);
+            return false;
+        }
+    }
+
+    // --parallel-loading
+    ObjLoading::Configuration.ParallelLoading = m_argument_parser.IsOptionSpecified(OPTION_PARALLEL_LOADING);
+
     // --menu-permissive
     if (m_argument_parser.IsOptionSpecified(OPTION_MENU_PERMISSIVE))
         ObjLoading::Configuration.MenuPermissiveParsing = true;
@@ -356,6 +464,47 @@ bool LinkerArgs::ParseArgs(const int argc, const char** argv, bool& shouldContin
     if (m_argument_parser.IsOptionSpecified(OPTION_MENU_NO_OPTIMIZATION))
         ObjLoading::Configuration.MenuNoOptimization = true;
 
+    // --zone-cache
+    if (m_argument_parser.IsOptionSpecified(OPTION_ZONE_CACHE))
+        ZoneLoading::Configuration.CacheDirectory = m_argument_parser.GetValueForOption(OPTION_ZONE_CACHE);
+
+    // --profile
+    ZoneLoading::Configuration.Profile = m_argument_parser.IsOptionSpecified(OPTION_PROFILE);
+
+    // --profile-json
+    if (m_argument_parser.IsOptionSpecified(OPTION_PROFILE_JSON))
+        ZoneLoading::Configuration.ProfileJsonPath = m_argument_parser.GetValueForOption(OPTION_PROFILE_JSON);
+
+    // --compression-level
+    if (m_argument_parser.IsOptionSpecified(OPTION_COMPRESSION_LEVEL))
+    {
+        const auto levelString = m_argument_parser.GetValueForOption(OPTION_COMPRESSION_LEVEL);
+        if (levelString.size() != 1 || levelString[0] < '0' || levelString[0] > '9')
+        {
+            std::cerr << std::format("Invalid compression level \"{}\". Must be a number from 0 to 9.\n", levelString);
+            return false;
+        }
+
+        ZoneWriting::Configuration.CompressionLevel = levelString[0] - '0';
+    }
+
+    // --release
+    if (m_argument_parser.IsOptionSpecified(OPTION_RELEASE))
+        ZoneWriting::Configuration.CompressionLevel.reset();
+
+    // --deduplicate-content
+    ZoneWriting::Configuration.DeduplicateContent = m_argument_parser.IsOptionSpecified(OPTION_DEDUPLICATE_CONTENT);
+
+    // --stream-content
+    ZoneWriting::Configuration.StreamContent = m_argument_parser.IsOptionSpecified(OPTION_STREAM_CONTENT);
+
+    // --size-report
+    ZoneWriting::Configuration.SizeReport = m_argument_parser.IsOptionSpecified(OPTION_SIZE_REPORT);
+
+    // --size-report-json
+    if (m_argument_parser.IsOptionSpecified(OPTION_SIZE_REPORT_JSON))
+        ZoneWriting::Configuration.SizeReportJsonPath = m_argument_parser.GetValueForOption(OPTION_SIZE_REPORT_JSON);
+
     return true;
 }
 
@@ -41,6 +41,7 @@ public:
     _NODISCARD std::set<std::string> GetSourceSearchPathsForProject(const std::string& projectName) const;
 
     bool m_verbose;
+    unsigned m_jobs;
 
     std::vector<std::string> m_zones_to_load;
     std::vector<std::string> m_project_specifiers_to_build;
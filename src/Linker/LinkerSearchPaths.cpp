@@ -4,6 +4,7 @@
 #include "ObjLoading.h"
 #include "SearchPath/SearchPathFilesystem.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <format>
 #include <iostream>
@@ -38,6 +39,9 @@ void LinkerSearchPaths::UnloadSearchPath(ISearchPath& searchPath) const
 SearchPaths LinkerSearchPaths::GetAssetSearchPathsForProject(const std::string& gameName, const std::string& projectName)
 {
     SearchPaths searchPathsForProject;
+    std::vector<ISearchPath*> projectSearchPaths;
+
+    std::lock_guard lock(m_project_search_paths_mutex);
 
     for (const auto& searchPathStr : m_args.GetAssetSearchPathsForProject(gameName, projectName))
     {
@@ -56,14 +60,23 @@ SearchPaths LinkerSearchPaths::GetAssetSearchPathsForProject(const std::string&
         auto searchPath = std::make_unique<SearchPathFilesystem>(searchPathStr);
         LoadSearchPath(*searchPath);
         searchPathsForProject.IncludeSearchPath(searchPath.get());
+        projectSearchPaths.emplace_back(searchPath.get());
         m_loaded_project_search_paths.emplace_back(std::move(searchPath));
     }
 
     searchPathsForProject.IncludeSearchPath(&m_asset_search_paths);
 
-    for (auto* iwd : IWD::Repository)
+    // Only include the iwds of this project since other projects may be built at the same time
+    for (auto* searchPath : m_asset_search_paths)
+    {
+        for (auto* iwd : IWD::Repository.GetContainersReferencedBy(searchPath))
+            searchPathsForProject.IncludeSearchPath(iwd);
+    }
+
+    for (auto* searchPath : projectSearchPaths)
     {
-        searchPathsForProject.IncludeSearchPath(iwd);
+        for (auto* iwd : IWD::Repository.GetContainersReferencedBy(searchPath))
+            searchPathsForProject.IncludeSearchPath(iwd);
     }
 
     return searchPathsForProject;
@@ -179,12 +192,21 @@ bool LinkerSearchPaths::BuildProjectIndependentSearchPaths()
     return true;
 }
 
-void LinkerSearchPaths::UnloadProjectSpecificSearchPaths()
+void LinkerSearchPaths::UnloadProjectSpecificSearchPaths(SearchPaths& assetSearchPaths)
 {
-    for (const auto& loadedSearchPath : m_loaded_project_search_paths)
+    std::lock_guard lock(m_project_search_paths_mutex);
+
+    for (auto* searchPath : assetSearchPaths)
     {
-        UnloadSearchPath(*loadedSearchPath);
-    }
+        const auto loadedSearchPath = std::ranges::find_if(m_loaded_project_search_paths,
+                                                           [searchPath](const std::unique_ptr<ISearchPath>& loaded)
+                                                           {
+                                                               return loaded.get() == searchPath;
+                                                           });
+        if (loadedSearchPath == m_loaded_project_search_paths.end())
+            continue;
 
-    m_loaded_project_search_paths.clear();
+        UnloadSearchPath(**loadedSearchPath);
+        m_loaded_project_search_paths.erase(loadedSearchPath);
+    }
 }
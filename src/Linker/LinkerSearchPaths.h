@@ -3,6 +3,7 @@
 #include "SearchPath/SearchPaths.h"
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 class LinkerSearchPaths
@@ -22,6 +23,10 @@ public:
      */
     void UnloadSearchPath(ISearchPath& searchPath) const;
 
+    /**
+     * \brief Loads the project specific asset search paths. They stay loaded until they are unloaded with \c UnloadProjectSpecificSearchPaths.
+     * Can be called for multiple projects at the same time.
+     */
     SearchPaths GetAssetSearchPathsForProject(const std::string& gameName, const std::string& projectName);
 
     SearchPaths GetGdtSearchPathsForProject(const std::string& gameName, const std::string& projectName);
@@ -34,10 +39,16 @@ public:
      */
     bool BuildProjectIndependentSearchPaths();
 
-    void UnloadProjectSpecificSearchPaths();
+    /**
+     * \brief Unloads the project specific search paths that were loaded for the specified asset search paths.
+     * The asset search paths must not be used anymore afterwards.
+     * \param assetSearchPaths The search paths returned by \c GetAssetSearchPathsForProject.
+     */
+    void UnloadProjectSpecificSearchPaths(SearchPaths& assetSearchPaths);
 
 private:
     const LinkerArgs& m_args;
+    std::mutex m_project_search_paths_mutex;
     std::vector<std::unique_ptr<ISearchPath>> m_loaded_project_search_paths;
     SearchPaths m_asset_search_paths;
     SearchPaths m_gdt_search_paths;
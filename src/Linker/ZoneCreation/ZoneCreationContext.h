@@ -4,6 +4,7 @@
 #include "Zone/AssetList/AssetList.h"
 #include "Zone/Definition/ZoneDefinition.h"
 
+#include <filesystem>
 #include <memory>
 #include <vector>
 
@@ -14,6 +15,7 @@ public:
     ISearchPath* m_asset_search_path;
     std::vector<std::unique_ptr<Gdt>> m_gdt_files;
     AssetList m_ignored_assets;
+    std::filesystem::path m_output_folder;
 
     ZoneCreationContext();
     ZoneCreationContext(ZoneDefinition* definition, ISearchPath* assetSearchPath);
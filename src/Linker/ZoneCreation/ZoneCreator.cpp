@@ -6,6 +6,7 @@
 #include "Game/IW5/ZoneCreatorIW5.h"
 #include "Game/T5/ZoneCreatorT5.h"
 #include "Game/T6/ZoneCreatorT6.h"
+#include "ObjLoading.h"
 
 #include <cassert>
 
@@ -25,3 +26,27 @@ const IZoneCreator* IZoneCreator::GetCreatorForGame(GameId game)
 
     return result;
 }
+
+bool IZoneCreator::LoadAssetsOfDefinition(const IObjLoader& objLoader, AssetLoadingContext& context, const ZoneDefinition& definition)
+{
+    if (ObjLoading::Configuration.ParallelLoading)
+    {
+        // Assets are still added to the zone in the order of the definition, which keeps the output the same
+        for (const auto& assetEntry : definition.m_assets)
+        {
+            if (!assetEntry.m_is_reference)
+                objLoader.PreloadAssetForZone(context, assetEntry.m_asset_type, assetEntry.m_asset_name);
+        }
+    }
+
+    for (const auto& assetEntry : definition.m_assets)
+    {
+        if (!objLoader.LoadAssetForZone(context, assetEntry.m_asset_type, assetEntry.m_asset_name))
+            return false;
+
+        // The asset may have been loaded without its preloaded data, for example from a gdt
+        context.ReleasePreloadedAsset(assetEntry.m_asset_type, assetEntry.m_asset_name);
+    }
+
+    return true;
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "AssetLoading/AssetLoadingContext.h"
+#include "IObjLoader.h"
 #include "Zone/Zone.h"
 #include "ZoneCreationContext.h"
 
@@ -18,4 +20,12 @@ public:
     [[nodiscard]] virtual asset_type_t GetImageAssetType() const = 0;
 
     static const IZoneCreator* GetCreatorForGame(GameId game);
+
+protected:
+    /**
+     * \brief Loads all assets of a zone definition in the order of the definition.
+     * With parallel loading the files of the assets are preloaded on worker threads ahead of loading them.
+     * \return \c true if all assets were loaded successfully, otherwise \c false.
+     */
+    static bool LoadAssetsOfDefinition(const IObjLoader& objLoader, AssetLoadingContext& context, const ZoneDefinition& definition);
 };
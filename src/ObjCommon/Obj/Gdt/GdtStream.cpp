@@ -382,6 +382,19 @@ void GdtOutputStream::EndStream()
     }
 }
 
+std::unique_ptr<GdtOutputStream> GdtOutputStream::CreateDeferred(std::ostream& stream) const
+{
+    auto deferred = std::make_unique<GdtOutputStream>(stream);
+    deferred->m_intendation_level = m_intendation_level;
+
+    return deferred;
+}
+
+void GdtOutputStream::WriteDeferred(const std::string& deferredEntries) const
+{
+    m_stream << deferredEntries;
+}
+
 void GdtOutputStream::WriteGdt(const Gdt& gdt, std::ostream& stream)
 {
     GdtOutputStream out(stream);
@@ -2,6 +2,7 @@
 #include "Gdt.h"
 
 #include <iostream>
+#include <memory>
 
 class GdtReader
 {
@@ -40,5 +41,13 @@ public:
     void WriteEntry(const GdtEntry& entry);
     void EndStream();
 
+    /**
+     * \brief Creates a stream that writes entries formatted like the entries of this stream.
+     * Allows writing entries separately, for example on multiple threads, and adding them to this stream in a fixed order with \c WriteDeferred.
+     * \param stream The stream to write the deferred entries to.
+     */
+    [[nodiscard]] std::unique_ptr<GdtOutputStream> CreateDeferred(std::ostream& stream) const;
+    void WriteDeferred(const std::string& deferredEntries) const;
+
     static void WriteGdt(const Gdt& gdt, std::ostream& stream);
 };
@@ -1,13 +1,95 @@
 #include "AssetLoadingContext.h"
 
+#include "IAssetLoader.h"
+#include "Utils/OutputCapture.h"
+#include "Utils/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <future>
+
+class AssetLoadingContext::PreloadTask
+{
+public:
+    PreloadTask(const IAssetLoader& loader, const asset_type_t assetType, std::string assetName)
+        : m_loader(loader),
+          m_asset_type(assetType),
+          m_asset_name(std::move(assetName)),
+          m_started(false),
+          m_claimed(false),
+          m_result(m_promise.get_future())
+    {
+    }
+
+    /**
+     * \brief Runs the preload unless it was already run or cancelled on another thread.
+     * \return \c true if the preload was run by this call, otherwise \c false.
+     */
+    bool TryRun(ISearchPath& searchPath)
+    {
+        if (m_claimed.exchange(true))
+            return false;
+
+        std::unique_ptr<IPreloadedAsset> preloadedAsset;
+        {
+            // The output of a preload is only shown when its data is used, in the order of loading
+            const OutputCapture::Activation activation(m_output);
+            try
+            {
+                preloadedAsset = m_loader.PreloadFromRaw(m_asset_name, &searchPath);
+            }
+            catch (...)
+            {
+                preloadedAsset = nullptr;
+            }
+        }
+
+        m_promise.set_value(std::move(preloadedAsset));
+        return true;
+    }
+
+    /**
+     * \brief Makes sure the preload is not run anymore.
+     * \return \c true if the preload was not run yet, otherwise \c false.
+     */
+    bool Cancel()
+    {
+        return !m_claimed.exchange(true);
+    }
+
+    const IAssetLoader& m_loader;
+    asset_type_t m_asset_type;
+    std::string m_asset_name;
+
+    // Whether the preload was submitted to the thread pool. Only used by the loading thread.
+    bool m_started;
+
+    std::atomic_bool m_claimed;
+    std::promise<std::unique_ptr<IPreloadedAsset>> m_promise;
+    std::future<std::unique_ptr<IPreloadedAsset>> m_result;
+    OutputCapture m_output;
+};
+
 AssetLoadingContext::AssetLoadingContext(Zone& zone, ISearchPath& rawSearchPath, std::vector<Gdt*> gdtFiles)
     : m_zone(zone),
       m_raw_search_path(rawSearchPath),
-      m_gdt_files(std::move(gdtFiles))
+      m_gdt_files(std::move(gdtFiles)),
+      m_started_preload_count(0u)
 {
     BuildGdtEntryCache();
 }
 
+AssetLoadingContext::~AssetLoadingContext()
+{
+    // Preloads use the search path, which may be unloaded as soon as the zone is created
+    for (const auto& [key, task] : m_preloads)
+    {
+        if (!task->Cancel())
+            task->m_result.wait();
+    }
+}
+
 void AssetLoadingContext::BuildGdtEntryCache()
 {
     for (const auto* gdt : m_gdt_files)
@@ -48,3 +130,99 @@ GdtEntry* AssetLoadingContext::GetGdtEntryByGdfAndName(const std::string& gdfNam
 
     return foundGdtEntry->second;
 }
+
+void AssetLoadingContext::PreloadAsset(const IAssetLoader& loader, const asset_type_t assetType, const std::string& assetName)
+{
+    const auto ignoreEntry = m_ignored_asset_map.find(assetName);
+    if (ignoreEntry != m_ignored_asset_map.end() && ignoreEntry->second == assetType)
+        return;
+
+    auto key = std::make_pair(assetType, assetName);
+    if (m_preloads.contains(key))
+        return;
+
+    auto task = std::make_shared<PreloadTask>(loader, assetType, assetName);
+    m_preloads.emplace(std::move(key), task);
+    m_queued_preloads.emplace_back(std::move(task));
+
+    StartQueuedPreloads();
+}
+
+std::unique_ptr<IPreloadedAsset> AssetLoadingContext::TakePreloadedAsset(const asset_type_t assetType, const std::string& assetName)
+{
+    const auto foundPreload = m_preloads.find(std::make_pair(assetType, assetName));
+    if (foundPreload == m_preloads.end())
+        return nullptr;
+
+    const auto task = foundPreload->second;
+    RemovePreload(*task);
+
+    // A preload that was not picked up by a worker yet is run right away instead of waiting for it
+    if (!task->TryRun(m_raw_search_path))
+        task->m_result.wait();
+
+    auto preloadedAsset = task->m_result.get();
+    StartQueuedPreloads();
+
+    // Loading the asset from raw reports the error of a failed preload itself
+    if (preloadedAsset)
+        task->m_output.Print();
+
+    return preloadedAsset;
+}
+
+void AssetLoadingContext::ReleasePreloadedAsset(const asset_type_t assetType, const std::string& assetName)
+{
+    const auto foundPreload = m_preloads.find(std::make_pair(assetType, assetName));
+    if (foundPreload == m_preloads.end())
+        return;
+
+    const auto task = foundPreload->second;
+    RemovePreload(*task);
+
+    if (!task->Cancel())
+        task->m_result.wait();
+
+    StartQueuedPreloads();
+}
+
+void AssetLoadingContext::StartQueuedPreloads()
+{
+    // Leave workers of the pool free for other tasks, like compressing the zones of other targets
+    const auto maxStartedPreloadCount = std::max(ThreadPool::Default().ThreadCount() / 2u, 1u);
+
+    while (m_started_preload_count < maxStartedPreloadCount && !m_queued_preloads.empty())
+    {
+        auto task = std::move(m_queued_preloads.front());
+        m_queued_preloads.pop_front();
+
+        task->m_started = true;
+        m_started_preload_count++;
+
+        ThreadPool::Default().Submit(
+            [task, searchPath = &m_raw_search_path]
+            {
+                // Does not touch the search path when the preload was taken or cancelled in the meantime
+                task->TryRun(*searchPath);
+            });
+    }
+}
+
+void AssetLoadingContext::RemovePreload(const PreloadTask& task)
+{
+    if (task.m_started)
+    {
+        assert(m_started_preload_count > 0u);
+        m_started_preload_count--;
+    }
+    else
+    {
+        std::erase_if(m_queued_preloads,
+                      [&task](const std::shared_ptr<PreloadTask>& queuedTask)
+                      {
+                          return queuedTask.get() == &task;
+                      });
+    }
+
+    m_preloads.erase(std::make_pair(task.m_asset_type, task.m_asset_name));
+}
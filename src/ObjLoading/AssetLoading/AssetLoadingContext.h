@@ -1,19 +1,34 @@
 #pragma once
 
 #include "IGdtQueryable.h"
+#include "IPreloadedAsset.h"
 #include "IZoneAssetLoaderState.h"
 #include "Obj/Gdt/Gdt.h"
 #include "SearchPath/ISearchPath.h"
 #include "Zone/Zone.h"
 
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <memory>
 #include <type_traits>
 #include <typeindex>
 #include <unordered_map>
+#include <utility>
+#include <vector>
+
+class IAssetLoader;
 
 class AssetLoadingContext final : public IGdtQueryable
 {
 public:
     AssetLoadingContext(Zone& zone, ISearchPath& rawSearchPath, std::vector<Gdt*> gdtFiles);
+    ~AssetLoadingContext() override;
+    AssetLoadingContext(const AssetLoadingContext& other) = delete;
+    AssetLoadingContext(AssetLoadingContext&& other) noexcept = delete;
+    AssetLoadingContext& operator=(const AssetLoadingContext& other) = delete;
+    AssetLoadingContext& operator=(AssetLoadingContext&& other) noexcept = delete;
+
     GdtEntry* GetGdtEntryByGdfAndName(const std::string& gdfName, const std::string& entryName) override;
 
     template<typename T> T* GetZoneAssetLoaderState()
@@ -32,8 +47,37 @@ public:
         return newStatePtr;
     }
 
+    /**
+     * \brief Queues preloading an asset from raw on a worker thread unless it is ignored or already queued.
+     * Only a limited amount of preloads is started ahead of loading. Further ones are started when earlier ones are taken or released.
+     * \param loader The loader of the asset. Must be able to preload from raw.
+     */
+    void PreloadAsset(const IAssetLoader& loader, asset_type_t assetType, const std::string& assetName);
+
+    /**
+     * \brief Removes the preloaded data of an asset from the context.
+     * Waits for the preload if it is running and runs it on the calling thread if it was not started yet.
+     * \return The preloaded data or \c nullptr if the asset was not queued for preloading or preloading it failed.
+     */
+    std::unique_ptr<IPreloadedAsset> TakePreloadedAsset(asset_type_t assetType, const std::string& assetName);
+
+    /**
+     * \brief Discards the preloaded data of an asset that was loaded without taking it, for example because it was loaded from a GDT.
+     */
+    void ReleasePreloadedAsset(asset_type_t assetType, const std::string& assetName);
+
 private:
+    class PreloadTask;
+
     void BuildGdtEntryCache();
+    void StartQueuedPreloads();
+    void RemovePreload(const PreloadTask& task);
+
+    std::map<std::pair<asset_type_t, std::string>, std::shared_ptr<PreloadTask>> m_preloads;
+    std::deque<std::shared_ptr<PreloadTask>> m_queued_preloads;
+
+    // Preloads that were started and were neither taken nor released yet. Bounds how far ahead of loading files are read and kept in memory.
+    unsigned m_started_preload_count;
 
 public:
     Zone& m_zone;
@@ -41,6 +85,9 @@ public:
     const std::vector<Gdt*> m_gdt_files;
     std::unordered_map<std::string, asset_type_t> m_ignored_asset_map;
 
+    // Folder that files which are built alongside the zone, like sound banks, are written to
+    std::filesystem::path m_output_folder;
+
     std::unordered_map<std::string, std::unordered_map<std::string, GdtEntry*>> m_entries_by_gdf_and_by_name;
     std::unordered_map<std::type_index, std::unique_ptr<IZoneAssetLoaderState>> m_zone_asset_loader_states;
 };
@@ -70,6 +70,18 @@ XAssetInfoGeneric* AssetLoadingManager::LoadIgnoredDependency(const asset_type_t
     return nullptr;
 }
 
+bool AssetLoadingManager::LoadFromRaw(const asset_type_t assetType, const std::string& assetName, const IAssetLoader* loader)
+{
+    if (loader->CanPreloadFromRaw())
+    {
+        const auto preloadedAsset = m_context.TakePreloadedAsset(assetType, assetName);
+        if (preloadedAsset)
+            return loader->LoadFromPreloaded(assetName, *preloadedAsset, m_context.m_zone.GetMemory(), this, &m_context.m_zone);
+    }
+
+    return loader->LoadFromRaw(assetName, &m_context.m_raw_search_path, m_context.m_zone.GetMemory(), this, &m_context.m_zone);
+}
+
 XAssetInfoGeneric* AssetLoadingManager::LoadAssetDependency(const asset_type_t assetType, const std::string& assetName, const IAssetLoader* loader)
 {
     if (loader->CanLoadFromGdt() && !m_context.m_gdt_files.empty()
@@ -80,7 +92,7 @@ XAssetInfoGeneric* AssetLoadingManager::LoadAssetDependency(const asset_type_t a
         return lastDependency;
     }
 
-    if (loader->CanLoadFromRaw() && loader->LoadFromRaw(assetName, &m_context.m_raw_search_path, m_context.m_zone.GetMemory(), this, &m_context.m_zone))
+    if (loader->CanLoadFromRaw() && LoadFromRaw(assetType, assetName, loader))
     {
         auto* lastDependency = m_last_dependency_loaded;
         m_last_dependency_loaded = nullptr;
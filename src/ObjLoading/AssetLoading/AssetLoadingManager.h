@@ -21,6 +21,7 @@ public:
 
 private:
     XAssetInfoGeneric* LoadIgnoredDependency(asset_type_t assetType, const std::string& assetName, IAssetLoader* loader);
+    bool LoadFromRaw(asset_type_t assetType, const std::string& assetName, const IAssetLoader* loader);
     XAssetInfoGeneric* LoadAssetDependency(asset_type_t assetType, const std::string& assetName, const IAssetLoader* loader);
 
     XAssetInfoGeneric* AddAssetInternal(std::unique_ptr<XAssetInfoGeneric> xAssetInfo);
@@ -1,10 +1,12 @@
 #pragma once
 #include "IAssetLoadingManager.h"
 #include "IGdtQueryable.h"
+#include "IPreloadedAsset.h"
 #include "SearchPath/ISearchPath.h"
 #include "Utils/ClassUtils.h"
 #include "Zone/ZoneTypes.h"
 
+#include <memory>
 #include <string>
 
 class IAssetLoader
@@ -46,6 +48,28 @@ public:
         return false;
     }
 
+    _NODISCARD virtual bool CanPreloadFromRaw() const
+    {
+        return false;
+    }
+
+    /**
+     * \brief Does the part of loading an asset from raw that only depends on its files, like reading them.
+     * Is called on worker threads while other assets are loaded, so it must not access a zone.
+     * What it prints is only shown once the asset is loaded from the preloaded data.
+     * \return The data to pass to \c LoadFromPreloaded or \c nullptr if the asset could not be preloaded.
+     */
+    _NODISCARD virtual std::unique_ptr<IPreloadedAsset> PreloadFromRaw(const std::string& assetName, ISearchPath* searchPath) const
+    {
+        return nullptr;
+    }
+
+    virtual bool LoadFromPreloaded(
+        const std::string& assetName, IPreloadedAsset& preloadedAsset, MemoryManager* memory, IAssetLoadingManager* manager, Zone* zone) const
+    {
+        return false;
+    }
+
     virtual void FinalizeAssetsForZone(AssetLoadingContext& context) const
     {
         // Do nothing by default
@@ -0,0 +1,15 @@
+#pragma once
+
+/**
+ * \brief Data of an asset that was read ahead of loading the asset into a zone.
+ */
+class IPreloadedAsset
+{
+public:
+    IPreloadedAsset() = default;
+    virtual ~IPreloadedAsset() = default;
+    IPreloadedAsset(const IPreloadedAsset& other) = default;
+    IPreloadedAsset(IPreloadedAsset&& other) noexcept = default;
+    IPreloadedAsset& operator=(const IPreloadedAsset& other) = default;
+    IPreloadedAsset& operator=(IPreloadedAsset&& other) noexcept = default;
+};
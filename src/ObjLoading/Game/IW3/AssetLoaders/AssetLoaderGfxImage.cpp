@@ -12,6 +12,16 @@
 
 using namespace IW3;
 
+namespace
+{
+    class PreloadedImage final : public IPreloadedAsset
+    {
+    public:
+        // Is null when the file could not be decoded
+        std::unique_ptr<Texture> m_texture;
+    };
+} // namespace
+
 void* AssetLoaderGfxImage::CreateEmptyAsset(const std::string& assetName, MemoryManager* memory)
 {
     auto* image = memory->Create<GfxImage>();
@@ -27,20 +37,40 @@ bool AssetLoaderGfxImage::CanLoadFromRaw() const
 
 bool AssetLoaderGfxImage::LoadFromRaw(
     const std::string& assetName, ISearchPath* searchPath, MemoryManager* memory, IAssetLoadingManager* manager, Zone* zone) const
+{
+    const auto preloadedImage = PreloadFromRaw(assetName, searchPath);
+    return preloadedImage && LoadFromPreloaded(assetName, *preloadedImage, memory, manager, zone);
+}
+
+bool AssetLoaderGfxImage::CanPreloadFromRaw() const
+{
+    return true;
+}
+
+std::unique_ptr<IPreloadedAsset> AssetLoaderGfxImage::PreloadFromRaw(const std::string& assetName, ISearchPath* searchPath) const
 {
     // Do not load any GfxImages from raw for now that are not loaded
     // TODO: Load iwis and add streaming info to asset
     if (assetName.empty() || assetName[0] != '*')
-        return false;
+        return nullptr;
 
     std::string safeAssetName = assetName;
     std::ranges::replace(safeAssetName, '*', '_');
 
     const auto file = searchPath->Open(std::format("images/{}.dds", safeAssetName));
     if (!file.IsOpen())
-        return false;
+        return nullptr;
 
-    const auto texture = dds::LoadDds(*file.m_stream);
+    auto preloadedImage = std::make_unique<PreloadedImage>();
+    preloadedImage->m_texture = dds::LoadDds(*file.m_stream);
+
+    return preloadedImage;
+}
+
+bool AssetLoaderGfxImage::LoadFromPreloaded(
+    const std::string& assetName, IPreloadedAsset& preloadedAsset, MemoryManager* memory, IAssetLoadingManager* manager, Zone* zone) const
+{
+    const auto& texture = dynamic_cast<const PreloadedImage&>(preloadedAsset).m_texture;
     if (!texture)
     {
         std::cerr << std::format("Failed to load dds file for image asset \"{}\"\n", assetName);
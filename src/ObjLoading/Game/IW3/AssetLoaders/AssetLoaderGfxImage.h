@@ -13,5 +13,12 @@ namespace IW3
         _NODISCARD bool CanLoadFromRaw() const override;
         bool
             LoadFromRaw(const std::string& assetName, ISearchPath* searchPath, MemoryManager* memory, IAssetLoadingManager* manager, Zone* zone) const override;
+        _NODISCARD bool CanPreloadFromRaw() const override;
+        _NODISCARD std::unique_ptr<IPreloadedAsset> PreloadFromRaw(const std::string& assetName, ISearchPath* searchPath) const override;
+        bool LoadFromPreloaded(const std::string& assetName,
+                               IPreloadedAsset& preloadedAsset,
+                               MemoryManager* memory,
+                               IAssetLoadingManager* manager,
+                               Zone* zone) const override;
     };
 } // namespace IW3
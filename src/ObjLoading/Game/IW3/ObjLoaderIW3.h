@@ -11,8 +11,6 @@ namespace IW3
 {
     class ObjLoader final : public IObjLoader
     {
-        std::unordered_map<asset_type_t, std::unique_ptr<IAssetLoader>> m_asset_loaders_by_type;
-
         static bool IsMpZone(const Zone& zone);
         static bool IsZmZone(const Zone& zone);
 
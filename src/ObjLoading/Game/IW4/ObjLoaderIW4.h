@@ -23,7 +23,5 @@ namespace IW4
     private:
         static bool IsMpZone(const Zone& zone);
         static bool IsZmZone(const Zone& zone);
-
-        std::unordered_map<asset_type_t, std::unique_ptr<IAssetLoader>> m_asset_loaders_by_type;
     };
 } // namespace IW4
@@ -7,10 +7,21 @@
 #include <cstring>
 #include <format>
 #include <iostream>
-#include <sstream>
 
 using namespace IW5;
 
+namespace
+{
+    class PreloadedImage final : public IPreloadedAsset
+    {
+    public:
+        std::string m_file_name;
+
+        // Is null when the file could not be decoded
+        std::unique_ptr<Texture> m_texture;
+    };
+} // namespace
+
 void* AssetLoaderGfxImage::CreateEmptyAsset(const std::string& assetName, MemoryManager* memory)
 {
     auto* asset = memory->Alloc<AssetImage::Type>();
@@ -26,20 +37,36 @@ bool AssetLoaderGfxImage::CanLoadFromRaw() const
 bool AssetLoaderGfxImage::LoadFromRaw(
     const std::string& assetName, ISearchPath* searchPath, MemoryManager* memory, IAssetLoadingManager* manager, Zone* zone) const
 {
-    const auto fileName = std::format("images/{}.iwi", assetName);
-    const auto file = searchPath->Open(fileName);
+    const auto preloadedImage = PreloadFromRaw(assetName, searchPath);
+    return preloadedImage && LoadFromPreloaded(assetName, *preloadedImage, memory, manager, zone);
+}
+
+bool AssetLoaderGfxImage::CanPreloadFromRaw() const
+{
+    return true;
+}
+
+std::unique_ptr<IPreloadedAsset> AssetLoaderGfxImage::PreloadFromRaw(const std::string& assetName, ISearchPath* searchPath) const
+{
+    auto preloadedImage = std::make_unique<PreloadedImage>();
+    preloadedImage->m_file_name = std::format("images/{}.iwi", assetName);
+    const auto file = searchPath->Open(preloadedImage->m_file_name);
     if (!file.IsOpen())
-        return false;
+        return nullptr;
 
-    const auto fileSize = static_cast<size_t>(file.m_length);
-    const auto fileData = std::make_unique<char[]>(fileSize);
-    file.m_stream->read(fileData.get(), fileSize);
+    preloadedImage->m_texture = iwi::LoadIwi(*file.m_stream);
 
-    std::istringstream ss(std::string(fileData.get(), fileSize));
-    const auto texture = iwi::LoadIwi(ss);
+    return preloadedImage;
+}
+
+bool AssetLoaderGfxImage::LoadFromPreloaded(
+    const std::string& assetName, IPreloadedAsset& preloadedAsset, MemoryManager* memory, IAssetLoadingManager* manager, Zone* zone) const
+{
+    const auto& preloadedImage = dynamic_cast<const PreloadedImage&>(preloadedAsset);
+    const auto& texture = preloadedImage.m_texture;
     if (!texture)
     {
-        std::cerr << std::format("Failed to load texture from: {}\n", fileName);
+        std::cerr << std::format("Failed to load texture from: {}\n", preloadedImage.m_file_name);
         return false;
     }
 
@@ -6,10 +6,21 @@
 #include <cstring>
 #include <filesystem>
 #include <iostream>
+#include <vector>
 #include <zlib.h>
 
 using namespace IW5;
 
+namespace
+{
+    class PreloadedRawFile final : public IPreloadedAsset
+    {
+    public:
+        size_t m_uncompressed_size = 0;
+        std::vector<char> m_compressed_data;
+    };
+} // namespace
+
 void* AssetLoaderRawFile::CreateEmptyAsset(const std::string& assetName, MemoryManager* memory)
 {
     auto* rawFile = memory->Create<RawFile>();
@@ -25,18 +36,32 @@ bool AssetLoaderRawFile::CanLoadFromRaw() const
 
 bool AssetLoaderRawFile::LoadFromRaw(
     const std::string& assetName, ISearchPath* searchPath, MemoryManager* memory, IAssetLoadingManager* manager, Zone* zone) const
+{
+    const auto preloadedRawFile = PreloadFromRaw(assetName, searchPath);
+    return preloadedRawFile && LoadFromPreloaded(assetName, *preloadedRawFile, memory, manager, zone);
+}
+
+bool AssetLoaderRawFile::CanPreloadFromRaw() const
+{
+    return true;
+}
+
+std::unique_ptr<IPreloadedAsset> AssetLoaderRawFile::PreloadFromRaw(const std::string& assetName, ISearchPath* searchPath) const
 {
     const auto file = searchPath->Open(assetName);
     if (!file.IsOpen())
-        return false;
+        return nullptr;
 
     const auto uncompressedBuffer = std::make_unique<char[]>(static_cast<size_t>(file.m_length));
     file.m_stream->read(uncompressedBuffer.get(), file.m_length);
     if (file.m_stream->gcount() != file.m_length)
-        return false;
+        return nullptr;
+
+    auto preloadedRawFile = std::make_unique<PreloadedRawFile>();
+    preloadedRawFile->m_uncompressed_size = static_cast<size_t>(file.m_length);
 
     const auto compressionBufferSize = static_cast<size_t>(file.m_length + COMPRESSED_BUFFER_SIZE_PADDING);
-    auto* compressedBuffer = memory->Alloc<char>(compressionBufferSize);
+    preloadedRawFile->m_compressed_data.resize(compressionBufferSize);
 
     z_stream_s zs{};
 
@@ -46,7 +71,7 @@ bool AssetLoaderRawFile::LoadFromRaw(
     zs.avail_in = static_cast<uInt>(file.m_length);
     zs.avail_out = compressionBufferSize;
     zs.next_in = reinterpret_cast<const Bytef*>(uncompressedBuffer.get());
-    zs.next_out = reinterpret_cast<Bytef*>(compressedBuffer);
+    zs.next_out = reinterpret_cast<Bytef*>(preloadedRawFile->m_compressed_data.data());
 
     int ret = deflateInit(&zs, Z_DEFAULT_COMPRESSION);
 
@@ -61,19 +86,31 @@ bool AssetLoaderRawFile::LoadFromRaw(
     {
         std::cerr << "Deflate failed for loading rawfile \"" << assetName << "\"\n";
         deflateEnd(&zs);
-        return false;
+        return nullptr;
     }
 
-    const auto compressedSize = compressionBufferSize - zs.avail_out;
+    preloadedRawFile->m_compressed_data.resize(compressionBufferSize - zs.avail_out);
+
+    deflateEnd(&zs);
+
+    return preloadedRawFile;
+}
+
+bool AssetLoaderRawFile::LoadFromPreloaded(
+    const std::string& assetName, IPreloadedAsset& preloadedAsset, MemoryManager* memory, IAssetLoadingManager* manager, Zone* zone) const
+{
+    const auto& preloadedRawFile = dynamic_cast<const PreloadedRawFile&>(preloadedAsset);
+    const auto compressedSize = preloadedRawFile.m_compressed_data.size();
+
+    auto* compressedBuffer = memory->Alloc<char>(compressedSize);
+    std::memcpy(compressedBuffer, preloadedRawFile.m_compressed_data.data(), compressedSize);
 
     auto* rawFile = memory->Create<RawFile>();
     rawFile->name = memory->Dup(assetName.c_str());
     rawFile->compressedLen = static_cast<int>(compressedSize);
-    rawFile->len = static_cast<int>(file.m_length);
+    rawFile->len = static_cast<int>(preloadedRawFile.m_uncompressed_size);
     rawFile->buffer = static_cast<const char*>(compressedBuffer);
 
-    deflateEnd(&zs);
-
     manager->AddAsset<AssetRawFile>(assetName, rawFile);
 
     return true;
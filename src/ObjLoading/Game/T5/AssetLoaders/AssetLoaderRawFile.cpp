@@ -6,12 +6,23 @@
 #include <cstring>
 #include <filesystem>
 #include <iostream>
+#include <vector>
 #include <zlib.h>
 
 using namespace T5;
 
 namespace fs = std::filesystem;
 
+namespace
+{
+    class PreloadedRawFile final : public IPreloadedAsset
+    {
+    public:
+        int m_len = 0;
+        std::vector<char> m_buffer;
+    };
+} // namespace
+
 void* AssetLoaderRawFile::CreateEmptyAsset(const std::string& assetName, MemoryManager* memory)
 {
     auto* rawFile = memory->Create<RawFile>();
@@ -25,17 +36,18 @@ bool AssetLoaderRawFile::CanLoadFromRaw() const
     return true;
 }
 
-bool AssetLoaderRawFile::LoadGsc(
-    const SearchPathOpenFile& file, const std::string& assetName, ISearchPath* searchPath, MemoryManager* memory, IAssetLoadingManager* manager)
+std::unique_ptr<IPreloadedAsset> AssetLoaderRawFile::PreloadGsc(const SearchPathOpenFile& file, const std::string& assetName)
 {
     const auto uncompressedBuffer = std::make_unique<char[]>(static_cast<size_t>(file.m_length + 1));
     file.m_stream->read(uncompressedBuffer.get(), file.m_length);
     if (file.m_stream->gcount() != file.m_length)
-        return false;
+        return nullptr;
     uncompressedBuffer[static_cast<size_t>(file.m_length)] = '\0';
 
+    auto preloadedRawFile = std::make_unique<PreloadedRawFile>();
     const auto compressionBufferSize = static_cast<size_t>(file.m_length + 1 + sizeof(uint32_t) + sizeof(uint32_t) + COMPRESSED_BUFFER_SIZE_PADDING);
-    auto* compressedBuffer = memory->Alloc<char>(compressionBufferSize);
+    preloadedRawFile->m_buffer.resize(compressionBufferSize);
+    auto* compressedBuffer = preloadedRawFile->m_buffer.data();
 
     z_stream_s zs{};
 
@@ -60,7 +72,7 @@ bool AssetLoaderRawFile::LoadGsc(
     {
         std::cerr << "Deflate failed for loading gsc file \"" << assetName << "\"\n";
         deflateEnd(&zs);
-        return false;
+        return nullptr;
     }
 
     const auto compressedSize = compressionBufferSize - zs.avail_out;
@@ -68,49 +80,69 @@ bool AssetLoaderRawFile::LoadGsc(
     reinterpret_cast<uint32_t*>(compressedBuffer)[0] = static_cast<uint32_t>(file.m_length + 1); // outLen
     reinterpret_cast<uint32_t*>(compressedBuffer)[1] = compressedSize;                           // inLen
 
-    auto* rawFile = memory->Create<RawFile>();
-    rawFile->name = memory->Dup(assetName.c_str());
-    rawFile->len = static_cast<int>(compressedSize + sizeof(uint32_t) + sizeof(uint32_t));
-    rawFile->buffer = static_cast<const char*>(compressedBuffer);
+    preloadedRawFile->m_len = static_cast<int>(compressedSize + sizeof(uint32_t) + sizeof(uint32_t));
+    preloadedRawFile->m_buffer.resize(static_cast<size_t>(preloadedRawFile->m_len));
 
     deflateEnd(&zs);
 
-    manager->AddAsset<AssetRawFile>(assetName, rawFile);
-
-    return true;
+    return preloadedRawFile;
 }
 
-bool AssetLoaderRawFile::LoadDefault(
-    const SearchPathOpenFile& file, const std::string& assetName, ISearchPath* searchPath, MemoryManager* memory, IAssetLoadingManager* manager)
+std::unique_ptr<IPreloadedAsset> AssetLoaderRawFile::PreloadDefault(const SearchPathOpenFile& file)
 {
-    auto* rawFile = memory->Create<RawFile>();
-    rawFile->name = memory->Dup(assetName.c_str());
-    rawFile->len = static_cast<int>(file.m_length);
+    auto preloadedRawFile = std::make_unique<PreloadedRawFile>();
+    preloadedRawFile->m_len = static_cast<int>(file.m_length);
+    preloadedRawFile->m_buffer.resize(static_cast<size_t>(file.m_length + 1));
 
-    auto* fileBuffer = memory->Alloc<char>(static_cast<size_t>(file.m_length + 1));
-    file.m_stream->read(fileBuffer, file.m_length);
+    file.m_stream->read(preloadedRawFile->m_buffer.data(), file.m_length);
     if (file.m_stream->gcount() != file.m_length)
-        return false;
-    fileBuffer[rawFile->len] = '\0';
-
-    rawFile->buffer = fileBuffer;
-    manager->AddAsset<AssetRawFile>(assetName, rawFile);
+        return nullptr;
+    preloadedRawFile->m_buffer[static_cast<size_t>(preloadedRawFile->m_len)] = '\0';
 
-    return true;
+    return preloadedRawFile;
 }
 
 bool AssetLoaderRawFile::LoadFromRaw(
     const std::string& assetName, ISearchPath* searchPath, MemoryManager* memory, IAssetLoadingManager* manager, Zone* zone) const
+{
+    const auto preloadedRawFile = PreloadFromRaw(assetName, searchPath);
+    return preloadedRawFile && LoadFromPreloaded(assetName, *preloadedRawFile, memory, manager, zone);
+}
+
+bool AssetLoaderRawFile::CanPreloadFromRaw() const
+{
+    return true;
+}
+
+std::unique_ptr<IPreloadedAsset> AssetLoaderRawFile::PreloadFromRaw(const std::string& assetName, ISearchPath* searchPath) const
 {
     const auto file = searchPath->Open(assetName);
     if (!file.IsOpen())
-        return false;
+        return nullptr;
 
     const fs::path rawFilePath(assetName);
     const auto extension = rawFilePath.extension().string();
 
     if (extension == ".gsc" || extension == ".csc")
-        return LoadGsc(file, assetName, searchPath, memory, manager);
+        return PreloadGsc(file, assetName);
+
+    return PreloadDefault(file);
+}
+
+bool AssetLoaderRawFile::LoadFromPreloaded(
+    const std::string& assetName, IPreloadedAsset& preloadedAsset, MemoryManager* memory, IAssetLoadingManager* manager, Zone* zone) const
+{
+    const auto& preloadedRawFile = dynamic_cast<const PreloadedRawFile&>(preloadedAsset);
 
-    return LoadDefault(file, assetName, searchPath, memory, manager);
+    auto* buffer = memory->Alloc<char>(preloadedRawFile.m_buffer.size());
+    std::memcpy(buffer, preloadedRawFile.m_buffer.data(), preloadedRawFile.m_buffer.size());
+
+    auto* rawFile = memory->Create<RawFile>();
+    rawFile->name = memory->Dup(assetName.c_str());
+    rawFile->len = preloadedRawFile.m_len;
+    rawFile->buffer = buffer;
+
+    manager->AddAsset<AssetRawFile>(assetName, rawFile);
+
+    return true;
 }
@@ -10,15 +10,20 @@ namespace T5
     {
         static constexpr size_t COMPRESSED_BUFFER_SIZE_PADDING = 64;
 
-        static bool LoadGsc(
-            const SearchPathOpenFile& file, const std::string& assetName, ISearchPath* searchPath, MemoryManager* memory, IAssetLoadingManager* manager);
-        static bool LoadDefault(
-            const SearchPathOpenFile& file, const std::string& assetName, ISearchPath* searchPath, MemoryManager* memory, IAssetLoadingManager* manager);
+        static std::unique_ptr<IPreloadedAsset> PreloadGsc(const SearchPathOpenFile& file, const std::string& assetName);
+        static std::unique_ptr<IPreloadedAsset> PreloadDefault(const SearchPathOpenFile& file);
 
     public:
         _NODISCARD void* CreateEmptyAsset(const std::string& assetName, MemoryManager* memory) override;
         _NODISCARD bool CanLoadFromRaw() const override;
         bool
             LoadFromRaw(const std::string& assetName, ISearchPath* searchPath, MemoryManager* memory, IAssetLoadingManager* manager, Zone* zone) const override;
+        _NODISCARD bool CanPreloadFromRaw() const override;
+        _NODISCARD std::unique_ptr<IPreloadedAsset> PreloadFromRaw(const std::string& assetName, ISearchPath* searchPath) const override;
+        bool LoadFromPreloaded(const std::string& assetName,
+                               IPreloadedAsset& preloadedAsset,
+                               MemoryManager* memory,
+                               IAssetLoadingManager* manager,
+                               Zone* zone) const override;
     };
 } // namespace T5
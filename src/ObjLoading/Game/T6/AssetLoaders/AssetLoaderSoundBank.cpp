@@ -11,6 +11,7 @@
 
 #include <cmath>
 #include <cstring>
+#include <filesystem>
 #include <format>
 #include <fstream>
 #include <iostream>
@@ -43,9 +44,9 @@ namespace
         return soundFilePath;
     }
 
-    [[nodiscard]] std::unique_ptr<std::ofstream> OpenSoundBankOutputFile(const std::string& bankName)
+    [[nodiscard]] std::unique_ptr<std::ofstream> OpenSoundBankOutputFile(const fs::path& outputFolder, const std::string& bankName)
     {
-        fs::path assetPath = SoundBankWriter::OutputPath / bankName;
+        fs::path assetPath = outputFolder / bankName;
 
         auto assetDir(assetPath);
         assetDir.remove_filename();
@@ -1007,7 +1008,7 @@ bool AssetLoaderSoundBank::LoadFromRaw(
         sndBank->runtimeAssetLoad = true;
 
         const auto sablName = std::format("{}.sabl", assetName);
-        sablStream = OpenSoundBankOutputFile(sablName);
+        sablStream = OpenSoundBankOutputFile(manager->GetAssetLoadingContext()->m_output_folder, sablName);
         if (sablStream)
             sablWriter = SoundBankWriter::Create(sablName, *sablStream, searchPath);
     }
@@ -1019,7 +1020,7 @@ bool AssetLoaderSoundBank::LoadFromRaw(
         memset(sndBank->streamAssetBank.linkTimeChecksum, 0xCC, 16);
 
         const auto sabsName = std::format("{}.sabs", assetName);
-        sabsStream = OpenSoundBankOutputFile(sabsName);
+        sabsStream = OpenSoundBankOutputFile(manager->GetAssetLoadingContext()->m_output_folder, sabsName);
         if (sabsStream)
             sabsWriter = SoundBankWriter::Create(sabsName, *sabsStream, searchPath);
     }
@@ -140,13 +140,12 @@ namespace T6
         if (ObjLoading::Configuration.Verbose)
             std::cout << std::format("Trying to load sound bank '{}' for zone '{}'\n", soundBankFileName, zone.m_name);
 
-        auto* existingSoundBank = SoundBank::Repository.GetContainerByName(soundBankFileName);
+        auto* existingSoundBank = SoundBank::Repository.AddContainerReferenceByName(soundBankFileName, &zone);
         if (existingSoundBank != nullptr)
         {
             if (ObjLoading::Configuration.Verbose)
                 std::cout << std::format("Referencing loaded sound bank '{}'.\n", soundBankFileName);
 
-            SoundBank::Repository.AddContainerReference(existingSoundBank, &zone);
             return existingSoundBank;
         }
 
@@ -241,13 +240,12 @@ namespace T6
         if (ObjLoading::Configuration.Verbose)
             std::cout << std::format("Trying to load ipak '{}' for zone '{}'\n", ipakName, zone.m_name);
 
-        auto* existingIPak = IPak::Repository.GetContainerByName(ipakName);
+        const auto* existingIPak = IPak::Repository.AddContainerReferenceByName(ipakName, &zone);
         if (existingIPak != nullptr)
         {
             if (ObjLoading::Configuration.Verbose)
                 std::cout << std::format("Referencing loaded ipak '{}'.\n", ipakName);
 
-            IPak::Repository.AddContainerReference(existingIPak, &zone);
             return;
         }
 
@@ -354,6 +352,7 @@ namespace T6
     void ObjLoader::UnloadContainersOfZone(Zone& zone) const
     {
         IPak::Repository.RemoveContainerReferences(&zone);
+        SoundBank::Repository.RemoveContainerReferences(&zone);
     }
 
     bool ObjLoader::LoadAssetForZone(AssetLoadingContext& context, const asset_type_t assetType, const std::string& assetName) const
@@ -41,7 +41,5 @@ namespace T6
 
         static bool IsMpZone(const Zone& zone);
         static bool IsZmZone(const Zone& zone);
-
-        std::unordered_map<asset_type_t, std::unique_ptr<IAssetLoader>> m_asset_loaders_by_type;
     };
 } // namespace T6
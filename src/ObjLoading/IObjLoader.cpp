@@ -25,3 +25,10 @@ const IObjLoader* IObjLoader::GetObjLoaderForGame(GameId game)
 
     return result;
 }
+
+void IObjLoader::PreloadAssetForZone(AssetLoadingContext& context, const asset_type_t assetType, const std::string& assetName) const
+{
+    const auto loader = m_asset_loaders_by_type.find(assetType);
+    if (loader != m_asset_loaders_by_type.end() && loader->second->CanPreloadFromRaw())
+        context.PreloadAsset(*loader->second, assetType, assetName);
+}
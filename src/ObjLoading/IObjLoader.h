@@ -1,9 +1,14 @@
 #pragma once
 
 #include "AssetLoading/AssetLoadingContext.h"
+#include "AssetLoading/IAssetLoader.h"
 #include "SearchPath/ISearchPath.h"
 #include "Zone/Zone.h"
 
+#include <memory>
+#include <string>
+#include <unordered_map>
+
 class IObjLoader
 {
 public:
@@ -27,8 +32,16 @@ public:
      */
     virtual void UnloadContainersOfZone(Zone& zone) const = 0;
 
+    /**
+     * \brief Queues reading and decoding the files of an asset on a worker thread to speed up loading it into the zone later on.
+     * Does nothing if the loader of the asset type does not support preloading.
+     */
+    void PreloadAssetForZone(AssetLoadingContext& context, asset_type_t assetType, const std::string& assetName) const;
     virtual bool LoadAssetForZone(AssetLoadingContext& context, asset_type_t assetType, const std::string& assetName) const = 0;
     virtual void FinalizeAssetsForZone(AssetLoadingContext& context) const = 0;
 
     static const IObjLoader* GetObjLoaderForGame(GameId game);
+
+protected:
+    std::unordered_map<asset_type_t, std::unique_ptr<IAssetLoader>> m_asset_loaders_by_type;
 };
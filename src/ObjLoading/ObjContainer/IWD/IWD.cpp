@@ -8,12 +8,46 @@
 #include <fstream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <unzip.h>
+#include <vector>
 
 namespace fs = std::filesystem;
 
 ObjContainerRepository<IWD, ISearchPath> IWD::Repository;
 
+/**
+ * \brief An opened instance of the archive of an IWD. Can read one file at a time.
+ */
+class IWDHandle
+{
+public:
+    std::unique_ptr<std::istream> m_stream;
+    unzFile m_unz_file;
+
+    explicit IWDHandle(std::unique_ptr<std::istream> stream)
+        : m_stream(std::move(stream)),
+          m_unz_file(nullptr)
+    {
+        auto ioFunctions = FileToZlibWrapper::CreateFunctions32ForFile(m_stream.get());
+        m_unz_file = unzOpen2("", &ioFunctions);
+    }
+
+    ~IWDHandle()
+    {
+        if (m_unz_file != nullptr)
+        {
+            unzClose(m_unz_file);
+            m_unz_file = nullptr;
+        }
+    }
+
+    IWDHandle(const IWDHandle& other) = delete;
+    IWDHandle(IWDHandle&& other) noexcept = delete;
+    IWDHandle& operator=(const IWDHandle& other) = delete;
+    IWDHandle& operator=(IWDHandle&& other) noexcept = delete;
+};
+
 class IWDFile final : public objbuf
 {
 public:
@@ -22,23 +56,25 @@ public:
     public:
         virtual ~IParent() = default;
 
-        virtual void OnIWDFileClose() = 0;
+        virtual void OnIWDFileClose(std::unique_ptr<IWDHandle> handle) = 0;
     };
 
 private:
     IParent* m_parent;
     bool m_open;
     int64_t m_size;
+    std::unique_ptr<IWDHandle> m_handle;
     unzFile m_container;
     bool m_peeked;
     int_type m_peek_symbol;
 
 public:
-    IWDFile(IParent* parent, const unzFile container, const int64_t size)
+    IWDFile(IParent* parent, std::unique_ptr<IWDHandle> handle, const int64_t size)
         : m_parent(parent),
           m_open(true),
           m_size(size),
-          m_container(container),
+          m_handle(std::move(handle)),
+          m_container(m_handle->m_unz_file),
           m_peeked(false),
           m_peek_symbol(0)
     {
@@ -154,7 +190,7 @@ public:
         unzCloseCurrentFile(m_container);
         m_open = false;
 
-        m_parent->OnIWDFileClose();
+        m_parent->OnIWDFileClose(std::move(m_handle));
 
         return true;
     }
@@ -171,52 +207,65 @@ class IWD::Impl : public ISearchPath, public IObjContainer, public IWDFile::IPar
 
     std::string m_path;
     std::unique_ptr<std::istream> m_stream;
-    unzFile m_unz_file;
+    bool m_initialized;
 
-    IWDFile* m_last_file;
+    // Each opened file reads through its own handle, so files can be read at the same time and on different threads.
+    // Handles of closed files are kept to be reused.
+    std::vector<std::unique_ptr<IWDHandle>> m_idle_handles;
+    std::mutex m_handle_mutex;
 
     std::map<std::string, IWDEntry> m_entry_map;
 
+    std::unique_ptr<IWDHandle> AcquireHandle()
+    {
+        {
+            std::lock_guard lock(m_handle_mutex);
+            if (!m_idle_handles.empty())
+            {
+                auto handle = std::move(m_idle_handles.back());
+                m_idle_handles.pop_back();
+                return handle;
+            }
+        }
+
+        auto handle = std::make_unique<IWDHandle>(std::make_unique<std::ifstream>(m_path, std::fstream::in | std::fstream::binary));
+        if (handle->m_unz_file == nullptr)
+            return nullptr;
+
+        return handle;
+    }
+
 public:
     Impl(std::string path, std::unique_ptr<std::istream> stream)
         : m_path(std::move(path)),
           m_stream(std::move(stream)),
-          m_unz_file(nullptr),
-          m_last_file(nullptr)
+          m_initialized(false)
     {
     }
 
-    ~Impl() override
-    {
-        if (m_unz_file != nullptr)
-        {
-            unzClose(m_unz_file);
-            m_unz_file = nullptr;
-        }
-    }
+    ~Impl() override = default;
 
     Impl(const Impl& other) = delete;
-    Impl(Impl&& other) noexcept = default;
+    Impl(Impl&& other) noexcept = delete;
     Impl& operator=(const Impl& other) = delete;
-    Impl& operator=(Impl&& other) noexcept = default;
+    Impl& operator=(Impl&& other) noexcept = delete;
 
     bool Initialize()
     {
-        auto ioFunctions = FileToZlibWrapper::CreateFunctions32ForFile(m_stream.get());
-        m_unz_file = unzOpen2("", &ioFunctions);
+        auto handle = std::make_unique<IWDHandle>(std::move(m_stream));
 
-        if (m_unz_file == nullptr)
+        if (handle->m_unz_file == nullptr)
         {
             printf("Could not open IWD \"%s\"\n", m_path.c_str());
             return false;
         }
 
-        auto ret = unzGoToFirstFile(m_unz_file);
+        auto ret = unzGoToFirstFile(handle->m_unz_file);
         while (ret == Z_OK)
         {
             unz_file_info64 info;
             char fileNameBuffer[256];
-            unzGetCurrentFileInfo64(m_unz_file, &info, fileNameBuffer, sizeof(fileNameBuffer), nullptr, 0, nullptr, 0);
+            unzGetCurrentFileInfo64(handle->m_unz_file, &info, fileNameBuffer, sizeof(fileNameBuffer), nullptr, 0, nullptr, 0);
 
             std::string fileName(fileNameBuffer);
             std::filesystem::path path(fileName);
@@ -225,13 +274,16 @@ public:
             {
                 IWDEntry entry;
                 entry.m_size = info.uncompressed_size;
-                unzGetFilePos(m_unz_file, &entry.m_file_pos);
+                unzGetFilePos(handle->m_unz_file, &entry.m_file_pos);
                 m_entry_map.emplace(std::move(fileName), entry);
             }
 
-            ret = unzGoToNextFile(m_unz_file);
+            ret = unzGoToNextFile(handle->m_unz_file);
         }
 
+        m_idle_handles.emplace_back(std::move(handle));
+        m_initialized = true;
+
         if (ObjLoading::Configuration.Verbose)
         {
             printf("Loaded IWD \"%s\" with %u entries\n", m_path.c_str(), m_entry_map.size());
@@ -242,7 +294,7 @@ public:
 
     SearchPathOpenFile Open(const std::string& fileName) override
     {
-        if (m_unz_file == nullptr)
+        if (!m_initialized)
         {
             return SearchPathOpenFile();
         }
@@ -254,21 +306,20 @@ public:
 
         if (iwdEntry != m_entry_map.end())
         {
-            if (m_last_file != nullptr)
-            {
-                throw std::runtime_error("Trying to open new IWD file while last one was not yet closed.");
-            }
+            auto handle = AcquireHandle();
+            if (!handle)
+                return SearchPathOpenFile();
 
             auto pos = iwdEntry->second.m_file_pos;
-            unzGoToFilePos(m_unz_file, &pos);
+            unzGoToFilePos(handle->m_unz_file, &pos);
 
-            if (unzOpenCurrentFile(m_unz_file) == UNZ_OK)
+            if (unzOpenCurrentFile(handle->m_unz_file) == UNZ_OK)
             {
-                auto result = std::make_unique<IWDFile>(this, m_unz_file, iwdEntry->second.m_size);
-                m_last_file = result.get();
+                auto result = std::make_unique<IWDFile>(this, std::move(handle), iwdEntry->second.m_size);
                 return SearchPathOpenFile(std::make_unique<iobjstream>(std::move(result)), iwdEntry->second.m_size);
             }
 
+            OnIWDFileClose(std::move(handle));
             return SearchPathOpenFile();
         }
 
@@ -306,9 +357,10 @@ public:
         }
     }
 
-    void OnIWDFileClose() override
+    void OnIWDFileClose(std::unique_ptr<IWDHandle> handle) override
     {
-        m_last_file = nullptr;
+        std::lock_guard lock(m_handle_mutex);
+        m_idle_handles.emplace_back(std::move(handle));
     }
 };
 
@@ -5,7 +5,9 @@
 
 #include <algorithm>
 #include <memory>
+#include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 
@@ -33,19 +35,22 @@ public:
     ObjContainerRepository() = default;
     ~ObjContainerRepository() = default;
     ObjContainerRepository(const ObjContainerRepository& other) = delete;
-    ObjContainerRepository(ObjContainerRepository&& other) noexcept = default;
+    ObjContainerRepository(ObjContainerRepository&& other) noexcept = delete;
     ObjContainerRepository& operator=(const ObjContainerRepository& other) = delete;
-    ObjContainerRepository& operator=(ObjContainerRepository&& other) noexcept = default;
+    ObjContainerRepository& operator=(ObjContainerRepository&& other) noexcept = delete;
 
     void AddContainer(std::unique_ptr<ContainerType> container, ReferencerType* referencer)
     {
         ObjContainerEntry entry(std::move(container));
         entry.m_references.insert(referencer);
+
+        std::lock_guard lock(m_mutex);
         m_containers.emplace_back(std::move(entry));
     }
 
     bool AddContainerReference(ContainerType* container, ReferencerType* referencer)
     {
+        std::lock_guard lock(m_mutex);
         auto firstEntry = std::find_if(m_containers.begin(),
                                        m_containers.end(),
                                        [container](const ObjContainerEntry& entry)
@@ -62,8 +67,33 @@ public:
         return false;
     }
 
+    /**
+     * \brief Adds a reference to the container with the specified name if there is one.
+     * Unlike looking the container up and referencing it separately, the container cannot be removed in between by another thread.
+     * \return The referenced container or \c nullptr if there is no container with the specified name.
+     */
+    ContainerType* AddContainerReferenceByName(const std::string& name, ReferencerType* referencer)
+    {
+        std::lock_guard lock(m_mutex);
+        auto foundEntry = std::find_if(m_containers.begin(),
+                                       m_containers.end(),
+                                       [&name](const ObjContainerEntry& entry)
+                                       {
+                                           return entry.m_container->GetName() == name;
+                                       });
+
+        if (foundEntry != m_containers.end())
+        {
+            foundEntry->m_references.insert(referencer);
+            return foundEntry->m_container.get();
+        }
+
+        return nullptr;
+    }
+
     void RemoveContainerReferences(ReferencerType* referencer)
     {
+        std::lock_guard lock(m_mutex);
         for (auto iEntry = m_containers.begin(); iEntry != m_containers.end();)
         {
             auto foundReference = iEntry->m_references.find(referencer);
@@ -86,6 +116,7 @@ public:
 
     ContainerType* GetContainerByName(const std::string& name)
     {
+        std::shared_lock lock(m_mutex);
         auto foundEntry = std::find_if(m_containers.begin(),
                                        m_containers.end(),
                                        [name](ObjContainerEntry& entry)
@@ -101,6 +132,21 @@ public:
         return nullptr;
     }
 
+    std::vector<ContainerType*> GetContainersReferencedBy(ReferencerType* referencer)
+    {
+        std::vector<ContainerType*> containers;
+
+        std::shared_lock lock(m_mutex);
+        for (const auto& entry : m_containers)
+        {
+            if (entry.m_references.contains(referencer))
+                containers.emplace_back(entry.m_container.get());
+        }
+
+        return containers;
+    }
+
+    // Iterating is not synchronized with containers being added or removed on other threads
     TransformIterator<typename std::vector<ObjContainerEntry>::iterator, ObjContainerEntry&, ContainerType*> begin()
     {
         return TransformIterator<typename std::vector<ObjContainerEntry>::iterator, ObjContainerEntry&, ContainerType*>(m_containers.begin(),
@@ -121,4 +167,5 @@ public:
 
 private:
     std::vector<ObjContainerEntry> m_containers;
+    std::shared_mutex m_mutex;
 };
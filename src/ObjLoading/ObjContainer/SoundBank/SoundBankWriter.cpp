@@ -334,8 +334,6 @@ private:
     int64_t m_checksum_section_offset;
 };
 
-std::filesystem::path SoundBankWriter::OutputPath;
-
 std::unique_ptr<SoundBankWriter> SoundBankWriter::Create(const std::string& fileName, std::ostream& stream, ISearchPath* assetSearchPath)
 {
     return std::make_unique<SoundBankWriterImpl>(fileName, stream, assetSearchPath);
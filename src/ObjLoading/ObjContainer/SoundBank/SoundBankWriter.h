@@ -1,7 +1,6 @@
 #pragma once
 #include "SearchPath/ISearchPath.h"
 
-#include <filesystem>
 #include <memory>
 #include <ostream>
 
@@ -20,6 +19,4 @@ public:
     virtual bool Write(size_t& dataSize) = 0;
 
     static std::unique_ptr<SoundBankWriter> Create(const std::string& fileName, std::ostream& stream, ISearchPath* assetSearchPath);
-
-    static std::filesystem::path OutputPath;
 };
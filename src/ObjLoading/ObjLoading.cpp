@@ -44,3 +44,15 @@ SearchPaths ObjLoading::GetIWDSearchPaths()
 
     return iwdPaths;
 }
+
+SearchPaths ObjLoading::GetIWDSearchPaths(ISearchPath& searchPath)
+{
+    SearchPaths iwdPaths;
+
+    for (auto* iwd : IWD::Repository.GetContainersReferencedBy(&searchPath))
+    {
+        iwdPaths.IncludeSearchPath(iwd);
+    }
+
+    return iwdPaths;
+}
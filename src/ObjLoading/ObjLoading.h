@@ -12,6 +12,9 @@ public:
         bool Verbose = false;
         bool MenuPermissiveParsing = false;
         bool MenuNoOptimization = false;
+
+        // Reads the files of the assets of a zone on worker threads ahead of loading them
+        bool ParallelLoading = false;
     } Configuration;
 
     /**
@@ -31,4 +34,11 @@ public:
      * \return A \c SearchPaths object containing all IWDs that are currently loaded.
      */
     static SearchPaths GetIWDSearchPaths();
+
+    /**
+     * \brief Creates a \c SearchPaths object containing only the IWDs that were loaded from the specified search path.
+     * \param searchPath The search path that was used to load the IWDs.
+     * \return A \c SearchPaths object containing the IWDs of the search path.
+     */
+    static SearchPaths GetIWDSearchPaths(ISearchPath& searchPath);
 };
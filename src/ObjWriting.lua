@@ -19,6 +19,7 @@ function ObjWriting:link(links)
 	links:linkto(ObjImage)
 	links:linkto(ObjLoading)
 	links:linkto(ZoneCommon)
+	links:linkto(Crypto)
 	links:linkto(minilzo)
 	links:linkto(minizip)
 	links:linkto(libtomcrypt)
@@ -56,6 +57,7 @@ function ObjWriting:project()
 		useSourceTemplating("ObjWriting")
 		
         self:include(includes)
+		Crypto:include(includes)
 		Utils:include(includes)
 		minilzo:include(includes)
 		minizip:include(includes)
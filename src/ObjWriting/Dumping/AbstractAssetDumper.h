@@ -1,20 +1,112 @@
 #pragma once
 
 #include "IAssetDumper.h"
+#include "Utils/OutputCapture.h"
+#include "Utils/ThreadPool.h"
+
+#include <exception>
+#include <future>
+#include <sstream>
+#include <vector>
 
 template<class T> class AbstractAssetDumper : public IAssetDumper<T>
 {
+    class ConcurrentAssetDump
+    {
+    public:
+        XAssetInfo<T>* m_asset = nullptr;
+        OutputCapture m_output;
+        std::ostringstream m_gdt_entries;
+        std::promise<void> m_done;
+    };
+
+    /**
+     * \brief Dumps the assets of a pool on the thread pool of the context.
+     * Printed output and GDT entries of the assets are written afterwards in the order of the pool to keep them deterministic.
+     */
+    void DumpPoolConcurrently(AssetDumpingContext& context, AssetPool<T>* pool)
+    {
+        std::vector<XAssetInfo<T>*> assets;
+        for (auto assetInfo : *pool)
+        {
+            if (assetInfo->m_name[0] == ',' || !ShouldDump(assetInfo))
+            {
+                continue;
+            }
+
+            assets.emplace_back(assetInfo);
+        }
+
+        std::vector<ConcurrentAssetDump> dumps(assets.size());
+        std::vector<std::future<void>> dumpsDone;
+        dumpsDone.reserve(dumps.size());
+        for (auto i = 0u; i < dumps.size(); i++)
+        {
+            auto& dump = dumps[i];
+            dump.m_asset = assets[i];
+            dumpsDone.emplace_back(dump.m_done.get_future());
+
+            context.m_thread_pool->Submit(
+                [this, &context, &dump]
+                {
+                    const OutputCapture::Activation outputActivation(dump.m_output);
+                    try
+                    {
+                        AssetDumpingContext assetContext(context, dump.m_gdt_entries);
+                        DumpAsset(assetContext, dump.m_asset);
+                        dump.m_done.set_value();
+                    }
+                    catch (...)
+                    {
+                        dump.m_done.set_exception(std::current_exception());
+                    }
+                });
+        }
+
+        // All dumps must be done before leaving, even if one of them failed, since they reference the dumps
+        std::exception_ptr exception;
+        for (auto i = 0u; i < dumps.size(); i++)
+        {
+            try
+            {
+                dumpsDone[i].get();
+            }
+            catch (...)
+            {
+                if (!exception)
+                    exception = std::current_exception();
+            }
+
+            dumps[i].m_output.Print();
+            if (context.m_gdt)
+                context.m_gdt->WriteDeferred(dumps[i].m_gdt_entries.str());
+        }
+
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+
 protected:
     virtual bool ShouldDump(XAssetInfo<T>* asset)
     {
         return true;
     }
 
+    /**
+     * \brief Dumps a single asset. Is called concurrently for the assets of a pool when the context has a thread pool,
+     * so any zone asset dumper state used in here must be safe to use from multiple threads.
+     */
     virtual void DumpAsset(AssetDumpingContext& context, XAssetInfo<T>* asset) = 0;
 
 public:
     void DumpPool(AssetDumpingContext& context, AssetPool<T>* pool) override
     {
+        if (context.m_thread_pool)
+        {
+            DumpPoolConcurrently(context, pool);
+            return;
+        }
+
         for (auto assetInfo : *pool)
         {
             if (assetInfo->m_name[0] == ',' || !ShouldDump(assetInfo))
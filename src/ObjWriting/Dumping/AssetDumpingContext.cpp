@@ -1,10 +1,25 @@
 #include "AssetDumpingContext.h"
 
 #include <filesystem>
-#include <fstream>
+#include <iostream>
 
 AssetDumpingContext::AssetDumpingContext()
-    : m_zone(nullptr)
+    : m_parent(nullptr),
+      m_zone(nullptr),
+      m_output(std::make_shared<AssetFileOutput>(AssetFileOutput::DEFAULT_WRITE_BUFFER_SIZE, false)),
+      m_obj_search_path(nullptr),
+      m_thread_pool(nullptr)
+{
+}
+
+AssetDumpingContext::AssetDumpingContext(AssetDumpingContext& parent, std::ostream& gdtEntryStream)
+    : m_parent(&parent),
+      m_zone(parent.m_zone),
+      m_base_path(parent.m_base_path),
+      m_output(parent.m_output),
+      m_gdt(parent.m_gdt ? parent.m_gdt->CreateDeferred(gdtEntryStream) : nullptr),
+      m_obj_search_path(parent.m_obj_search_path),
+      m_thread_pool(nullptr)
 {
 }
 
@@ -13,17 +28,13 @@ std::unique_ptr<std::ostream> AssetDumpingContext::OpenAssetFile(const std::stri
     std::filesystem::path assetFilePath(m_base_path);
     assetFilePath.append(fileName);
 
-    auto assetFileFolder(assetFilePath);
-    assetFileFolder.replace_filename("");
-    create_directories(assetFileFolder);
-
-    auto file = std::make_unique<std::ofstream>(assetFilePath, std::fstream::out | std::fstream::binary);
+    auto file = m_output->Open(assetFilePath);
 
-    if (!file->is_open())
+    if (!file)
     {
         std::cout << "Failed to open file '" << assetFilePath.string() << "' to dump asset '" << fileName << "'\n";
         return nullptr;
     }
 
-    return std::move(file);
+    return file;
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "AssetFileOutput.h"
 #include "IZoneAssetDumperState.h"
 #include "Obj/Gdt/GdtStream.h"
 #include "SearchPath/ISearchPath.h"
@@ -7,22 +8,41 @@
 #include "Zone/Zone.h"
 
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <typeindex>
 
+class ThreadPool;
+
 class AssetDumpingContext
 {
     std::unordered_map<std::type_index, std::unique_ptr<IZoneAssetDumperState>> m_zone_asset_dumper_states;
+    std::mutex m_zone_asset_dumper_states_mutex;
+    AssetDumpingContext* m_parent;
 
 public:
     Zone* m_zone;
     std::string m_base_path;
+
+    // Opens the asset files below the base path. Shared with child contexts.
+    std::shared_ptr<AssetFileOutput> m_output;
     std::unique_ptr<GdtOutputStream> m_gdt;
     ISearchPath* m_obj_search_path;
 
+    // Pool to dump the assets of a pool concurrently on. Assets are dumped one after another when not set.
+    ThreadPool* m_thread_pool;
+
     AssetDumpingContext();
 
+    /**
+     * \brief Creates a context for dumping a single asset on a worker thread of the thread pool of a parent context.
+     * Zone asset dumper states are shared with the parent.
+     * \param parent The context to dump the asset for.
+     * \param gdtEntryStream The stream to write GDT entries to, for adding them to the GDT of the parent afterwards.
+     */
+    AssetDumpingContext(AssetDumpingContext& parent, std::ostream& gdtEntryStream);
+
     _NODISCARD std::unique_ptr<std::ostream> OpenAssetFile(const std::string& fileName) const;
 
     template<typename T> T* GetZoneAssetDumperState()
@@ -30,6 +50,10 @@ public:
         static_assert(std::is_base_of_v<IZoneAssetDumperState, T>, "T must inherit IZoneAssetDumperState");
         // T must also have a public default constructor
 
+        if (m_parent)
+            return m_parent->GetZoneAssetDumperState<T>();
+
+        std::lock_guard lock(m_zone_asset_dumper_states_mutex);
         const auto foundEntry = m_zone_asset_dumper_states.find(typeid(T));
         if (foundEntry != m_zone_asset_dumper_states.end())
             return dynamic_cast<T*>(foundEntry->second.get());
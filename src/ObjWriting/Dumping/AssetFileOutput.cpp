@@ -0,0 +1,380 @@
+#include "AssetFileOutput.h"
+
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+class AssetFileOutput::BufferedFileStream final : public std::ofstream
+{
+public:
+    BufferedFileStream(AssetFileOutput& output, const fs::path& filePath, const size_t bufferSize)
+        : m_output(output),
+          m_file_path(filePath),
+          m_buffer(std::make_unique<char[]>(bufferSize))
+    {
+        // The buffer must be set before opening the file to take effect
+        rdbuf()->pubsetbuf(m_buffer.get(), static_cast<std::streamsize>(bufferSize));
+        open(filePath, std::fstream::out | std::fstream::binary);
+    }
+
+    ~BufferedFileStream() override
+    {
+        if (!is_open())
+            return;
+
+        // Must be closed before the buffer is freed
+        const auto size = tellp();
+        close();
+
+        if (fail())
+        {
+            std::cerr << std::format("Failed to write dumped asset file '{}'\n", m_file_path.string());
+            m_output.m_failed = true;
+            return;
+        }
+
+        m_output.AddWrittenFile(static_cast<uint64_t>(size));
+    }
+
+    BufferedFileStream(const BufferedFileStream& other) = delete;
+    BufferedFileStream(BufferedFileStream&& other) noexcept = delete;
+    BufferedFileStream& operator=(const BufferedFileStream& other) = delete;
+    BufferedFileStream& operator=(BufferedFileStream&& other) noexcept = delete;
+
+private:
+    AssetFileOutput& m_output;
+    fs::path m_file_path;
+    std::unique_ptr<char[]> m_buffer;
+};
+
+class AssetFileOutput::DeferredFileStream final : public std::ostream
+{
+public:
+    DeferredFileStream(AssetFileOutput& output, fs::path filePath)
+        : std::ostream(nullptr),
+          m_output(output),
+          m_file_path(std::move(filePath))
+    {
+        rdbuf(&m_buffer);
+    }
+
+    ~DeferredFileStream() override
+    {
+        m_output.QueueFile(std::move(m_file_path), std::move(m_buffer).str());
+    }
+
+    DeferredFileStream(const DeferredFileStream& other) = delete;
+    DeferredFileStream(DeferredFileStream&& other) noexcept = delete;
+    DeferredFileStream& operator=(const DeferredFileStream& other) = delete;
+    DeferredFileStream& operator=(DeferredFileStream&& other) noexcept = delete;
+
+private:
+    AssetFileOutput& m_output;
+    fs::path m_file_path;
+    std::stringbuf m_buffer;
+};
+
+AssetFileOutput::AssetFileOutput(const size_t writeBufferSize, const bool asyncWrite)
+    : m_write_buffer_size(writeBufferSize),
+      m_async_write(asyncWrite),
+      m_incremental(false),
+      m_written_file_count(0u),
+      m_written_byte_count(0u),
+      m_unchanged_file_count(0u),
+      m_failed(false),
+      m_pending_bytes(0u),
+      m_writing(false),
+      m_stopping(false)
+{
+    if (m_async_write)
+        m_writer = std::thread(&AssetFileOutput::WriterMain, this);
+}
+
+AssetFileOutput::AssetFileOutput(std::unique_ptr<std::ostream> archiveStream, std::unique_ptr<IArchiveWriter> archive, fs::path archiveRoot)
+    : m_write_buffer_size(DEFAULT_WRITE_BUFFER_SIZE),
+      m_async_write(false),
+      m_archive_stream(std::move(archiveStream)),
+      m_archive(std::move(archive)),
+      m_archive_root(std::move(archiveRoot)),
+      m_incremental(false),
+      m_written_file_count(0u),
+      m_written_byte_count(0u),
+      m_unchanged_file_count(0u),
+      m_failed(false),
+      m_pending_bytes(0u),
+      m_writing(false),
+      m_stopping(false)
+{
+}
+
+AssetFileOutput::~AssetFileOutput()
+{
+    if (!m_writer.joinable())
+        return;
+
+    {
+        std::lock_guard lock(m_pending_mutex);
+        m_stopping = true;
+    }
+    m_pending_changed.notify_all();
+
+    m_writer.join();
+}
+
+void AssetFileOutput::EnableIncremental(fs::path outputFolder, std::unique_ptr<DumpManifest> previousManifest)
+{
+    if (m_archive)
+        return;
+
+    m_incremental = true;
+    m_output_folder = std::move(outputFolder);
+    m_previous_manifest = std::move(previousManifest);
+}
+
+std::unique_ptr<std::ostream> AssetFileOutput::Open(const fs::path& filePath)
+{
+    // Incremental mode needs the complete content of a file to compare it with the existing one
+    if (m_async_write || m_archive || m_incremental)
+        return std::make_unique<DeferredFileStream>(*this, filePath);
+
+    if (!CreateDirectoriesForFile(filePath))
+    {
+        m_failed = true;
+        return nullptr;
+    }
+
+    auto file = std::make_unique<BufferedFileStream>(*this, filePath, m_write_buffer_size);
+    if (!file->is_open())
+    {
+        m_failed = true;
+        return nullptr;
+    }
+
+    return std::move(file);
+}
+
+void AssetFileOutput::Flush()
+{
+    std::unique_lock lock(m_pending_mutex);
+    m_pending_changed.wait(lock,
+                           [this]
+                           {
+                               return m_pending_files.empty() && !m_writing;
+                           });
+}
+
+bool AssetFileOutput::Close()
+{
+    Flush();
+
+    if (!m_archive)
+        return !m_failed;
+
+    const auto result = m_archive->Write();
+    m_archive_stream->flush();
+
+    return result && m_archive_stream->good() && !m_failed;
+}
+
+DumpManifest AssetFileOutput::CreateManifest(std::string key) const
+{
+    DumpManifest manifest;
+    manifest.m_key = std::move(key);
+
+    std::lock_guard lock(m_manifest_mutex);
+    manifest.m_files = m_manifest_files;
+
+    return manifest;
+}
+
+uint64_t AssetFileOutput::GetWrittenFileCount() const
+{
+    return m_written_file_count;
+}
+
+uint64_t AssetFileOutput::GetWrittenByteCount() const
+{
+    return m_written_byte_count;
+}
+
+uint64_t AssetFileOutput::GetUnchangedFileCount() const
+{
+    return m_unchanged_file_count;
+}
+
+bool AssetFileOutput::CreateDirectoriesForFile(const fs::path& filePath)
+{
+    const auto directory = filePath.parent_path();
+    if (directory.empty())
+        return true;
+
+    std::lock_guard lock(m_created_directories_mutex);
+    if (m_created_directories.contains(directory.string()))
+        return true;
+
+    std::error_code ec;
+    create_directories(directory, ec);
+    if (ec)
+        return false;
+
+    m_created_directories.emplace(directory.string());
+    return true;
+}
+
+void AssetFileOutput::AddWrittenFile(const uint64_t size)
+{
+    ++m_written_file_count;
+    m_written_byte_count += size;
+}
+
+void AssetFileOutput::AddManifestEntry(const fs::path& filePath, const uint64_t size, std::string hash)
+{
+    std::error_code ec;
+    const auto lastWriteTime = fs::last_write_time(filePath, ec);
+    if (ec)
+        return;
+
+    std::lock_guard lock(m_manifest_mutex);
+    m_manifest_files[filePath.lexically_relative(m_output_folder).generic_string()] = DumpManifest::Entry{
+        .m_size = size,
+        .m_last_write_time = DumpManifest::ToManifestTime(lastWriteTime),
+        .m_hash = std::move(hash),
+    };
+}
+
+bool AssetFileOutput::IsFileUnchanged(const fs::path& filePath, const std::string& data, const std::string& hash) const
+{
+    std::error_code ec;
+    const auto existingSize = fs::file_size(filePath, ec);
+    if (ec || existingSize != data.size())
+        return false;
+
+    const auto lastWriteTime = fs::last_write_time(filePath, ec);
+    if (ec)
+        return false;
+
+    // A file that was not modified since the previous dump still has the content it was dumped with
+    if (m_previous_manifest)
+    {
+        const auto previousEntry = m_previous_manifest->m_files.find(filePath.lexically_relative(m_output_folder).generic_string());
+        if (previousEntry != m_previous_manifest->m_files.end() && previousEntry->second.m_size == existingSize
+            && previousEntry->second.m_last_write_time == DumpManifest::ToManifestTime(lastWriteTime))
+        {
+            return previousEntry->second.m_hash == hash;
+        }
+    }
+
+    std::ifstream existingFile(filePath, std::fstream::in | std::fstream::binary);
+    if (!existingFile.is_open())
+        return false;
+
+    std::string existingData(data.size(), '\0');
+    existingFile.read(existingData.data(), static_cast<std::streamsize>(existingData.size()));
+
+    return static_cast<size_t>(existingFile.gcount()) == data.size() && existingData == data;
+}
+
+void AssetFileOutput::QueueFile(fs::path filePath, std::string data)
+{
+    if (m_archive)
+    {
+        const auto size = data.size();
+        m_archive->AddFile(filePath.lexically_relative(m_archive_root).generic_string(), std::move(data));
+        AddWrittenFile(size);
+        return;
+    }
+
+    std::string hash;
+    if (m_incremental)
+    {
+        hash = DumpManifest::ComputeHash(data.data(), data.size());
+
+        // Unchanged files are left untouched, so they keep their last write time
+        if (IsFileUnchanged(filePath, data, hash))
+        {
+            ++m_unchanged_file_count;
+            AddManifestEntry(filePath, data.size(), std::move(hash));
+            return;
+        }
+
+        if (!m_async_write)
+        {
+            WriteFile(PendingFile{std::move(filePath), std::move(data), std::move(hash)});
+            return;
+        }
+    }
+
+    {
+        // Do not let converting assets run too far ahead of writing them
+        std::unique_lock lock(m_pending_mutex);
+        m_pending_changed.wait(lock,
+                               [this]
+                               {
+                                   return m_pending_bytes <= MAX_PENDING_BYTES || m_pending_files.empty();
+                               });
+
+        m_pending_bytes += data.size();
+        m_pending_files.emplace(PendingFile{std::move(filePath), std::move(data), std::move(hash)});
+    }
+    m_pending_changed.notify_all();
+}
+
+void AssetFileOutput::WriteFile(const PendingFile& file)
+{
+    std::ofstream stream;
+    if (CreateDirectoriesForFile(file.m_path))
+        stream.open(file.m_path, std::fstream::out | std::fstream::binary);
+
+    if (!stream.is_open())
+    {
+        std::cerr << std::format("Failed to open file '{}' to write dumped asset\n", file.m_path.string());
+        m_failed = true;
+        return;
+    }
+
+    stream.write(file.m_data.data(), static_cast<std::streamsize>(file.m_data.size()));
+    stream.close();
+
+    if (stream.fail())
+    {
+        std::cerr << std::format("Failed to write dumped asset file '{}'\n", file.m_path.string());
+        m_failed = true;
+        return;
+    }
+
+    AddWrittenFile(file.m_data.size());
+    if (m_incremental)
+        AddManifestEntry(file.m_path, file.m_data.size(), file.m_hash);
+}
+
+void AssetFileOutput::WriterMain()
+{
+    std::unique_lock lock(m_pending_mutex);
+    while (true)
+    {
+        m_pending_changed.wait(lock,
+                               [this]
+                               {
+                                   return !m_pending_files.empty() || m_stopping;
+                               });
+
+        // All queued files are still written when stopping
+        if (m_pending_files.empty())
+            return;
+
+        const auto file = std::move(m_pending_files.front());
+        m_pending_files.pop();
+        m_writing = true;
+
+        lock.unlock();
+        WriteFile(file);
+        lock.lock();
+
+        m_pending_bytes -= file.m_data.size();
+        m_writing = false;
+        m_pending_changed.notify_all();
+    }
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "DumpManifest.h"
+#include "ObjContainer/IArchiveWriter.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_set>
+
+/**
+ * \brief Opens the files that dumped assets are written to.
+ * Directories that were already created are remembered, so they are only created once instead of for every file.
+ * Files can optionally be written on a separate writer thread, so that writing them overlaps with converting further assets.
+ * Alternatively all files can be written into a single archive.
+ * In incremental mode, files whose content did not change are not written again, so they keep their last write time.
+ */
+class AssetFileOutput
+{
+public:
+    static constexpr size_t DEFAULT_WRITE_BUFFER_SIZE = 64u * 1024u;
+    static constexpr size_t MAX_PENDING_BYTES = 64u * 1024u * 1024u;
+
+    /**
+     * \param writeBufferSize The size of the buffer of each opened file.
+     * \param asyncWrite Whether to write files on a separate writer thread. The content of each file is then kept in memory until the file is closed.
+     */
+    AssetFileOutput(size_t writeBufferSize, bool asyncWrite);
+
+    /**
+     * \param archiveStream The stream the archive is written to.
+     * \param archive The archive to add all files to. It must write to the archive stream.
+     * \param archiveRoot The path that corresponds to the root of the archive. The paths of opened files are made relative to it.
+     */
+    AssetFileOutput(std::unique_ptr<std::ostream> archiveStream, std::unique_ptr<IArchiveWriter> archive, std::filesystem::path archiveRoot);
+    ~AssetFileOutput();
+    AssetFileOutput(const AssetFileOutput& other) = delete;
+    AssetFileOutput(AssetFileOutput&& other) noexcept = delete;
+    AssetFileOutput& operator=(const AssetFileOutput& other) = delete;
+    AssetFileOutput& operator=(AssetFileOutput&& other) noexcept = delete;
+
+    /**
+     * \brief Only writes files whose content differs from the existing file and records the written files in a manifest.
+     * Must be called before any file is opened. Has no effect when writing into an archive.
+     * \param outputFolder The folder that the paths recorded in the manifest are relative to.
+     * \param previousManifest The manifest of the previous dump or \c nullptr if there is none.
+     * Existing files that were not modified since the previous dump are compared by their hash instead of by reading them.
+     */
+    void EnableIncremental(std::filesystem::path outputFolder, std::unique_ptr<DumpManifest> previousManifest);
+
+    /**
+     * \brief Opens a file for writing and creates its directory if necessary.
+     * With async writing, failing to write the file is only reported once it is written. Any failure makes \c Close fail.
+     * \param filePath The path of the file to open.
+     * \return A stream to write the file with or \c nullptr if the file could not be opened.
+     */
+    [[nodiscard]] std::unique_ptr<std::ostream> Open(const std::filesystem::path& filePath);
+
+    /**
+     * \brief Waits until all files that were closed are written.
+     */
+    void Flush();
+
+    /**
+     * \brief Writes all files that were closed and finishes the archive, if there is one. No files can be opened afterwards.
+     * \return \c true if all files and the archive were written successfully, otherwise \c false.
+     */
+    bool Close();
+
+    /**
+     * \brief Creates a manifest of all files that were written or left unchanged in incremental mode. Must be called after closing.
+     * \param key The key of everything the files were dumped from.
+     */
+    [[nodiscard]] DumpManifest CreateManifest(std::string key) const;
+
+    [[nodiscard]] uint64_t GetWrittenFileCount() const;
+    [[nodiscard]] uint64_t GetWrittenByteCount() const;
+    [[nodiscard]] uint64_t GetUnchangedFileCount() const;
+
+private:
+    class BufferedFileStream;
+    class DeferredFileStream;
+
+    class PendingFile
+    {
+    public:
+        std::filesystem::path m_path;
+        std::string m_data;
+        std::string m_hash;
+    };
+
+    bool CreateDirectoriesForFile(const std::filesystem::path& filePath);
+    void AddWrittenFile(uint64_t size);
+    void AddManifestEntry(const std::filesystem::path& filePath, uint64_t size, std::string hash);
+    [[nodiscard]] bool IsFileUnchanged(const std::filesystem::path& filePath, const std::string& data, const std::string& hash) const;
+    void QueueFile(std::filesystem::path filePath, std::string data);
+    void WriteFile(const PendingFile& file);
+    void WriterMain();
+
+    size_t m_write_buffer_size;
+    bool m_async_write;
+
+    std::unique_ptr<std::ostream> m_archive_stream;
+    std::unique_ptr<IArchiveWriter> m_archive;
+    std::filesystem::path m_archive_root;
+
+    bool m_incremental;
+    std::filesystem::path m_output_folder;
+    std::unique_ptr<DumpManifest> m_previous_manifest;
+    std::map<std::string, DumpManifest::Entry> m_manifest_files;
+    mutable std::mutex m_manifest_mutex;
+
+    std::unordered_set<std::string> m_created_directories;
+    std::mutex m_created_directories_mutex;
+
+    std::atomic_uint64_t m_written_file_count;
+    std::atomic_uint64_t m_written_byte_count;
+    std::atomic_uint64_t m_unchanged_file_count;
+    std::atomic_bool m_failed;
+
+    std::queue<PendingFile> m_pending_files;
+    size_t m_pending_bytes;
+    bool m_writing;
+    bool m_stopping;
+    std::mutex m_pending_mutex;
+    std::condition_variable m_pending_changed;
+    std::thread m_writer;
+};
@@ -0,0 +1,139 @@
+#include "DumpManifest.h"
+
+#include "Crypto.h"
+
+#include <format>
+#include <fstream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    constexpr auto MANIFEST_MAGIC = "OAT_DUMP_MANIFEST";
+    constexpr unsigned MANIFEST_VERSION = 1u;
+} // namespace
+
+std::string DumpManifest::ComputeHash(const void* data, const size_t dataSize)
+{
+    const auto hash = Crypto::CreateSHA1();
+    hash->Init();
+    hash->Process(data, dataSize);
+
+    const auto hashSize = hash->GetHashSize();
+    const auto hashValue = std::make_unique<uint8_t[]>(hashSize);
+    hash->Finish(hashValue.get());
+
+    std::ostringstream ss;
+    for (auto i = 0u; i < hashSize; i++)
+        ss << std::format("{:02x}", hashValue[i]);
+
+    return ss.str();
+}
+
+int64_t DumpManifest::ToManifestTime(const fs::file_time_type lastWriteTime)
+{
+    return static_cast<int64_t>(lastWriteTime.time_since_epoch().count());
+}
+
+std::unique_ptr<DumpManifest> DumpManifest::Read(const fs::path& manifestPath)
+{
+    std::ifstream stream(manifestPath, std::fstream::in | std::fstream::binary);
+    if (!stream.is_open())
+        return nullptr;
+
+    std::string magic;
+    unsigned version;
+    if (!(stream >> magic >> version) || magic != MANIFEST_MAGIC || version != MANIFEST_VERSION)
+        return nullptr;
+
+    auto manifest = std::make_unique<DumpManifest>();
+
+    std::string keyLabel;
+    if (!(stream >> keyLabel >> manifest->m_key) || keyLabel != "key")
+        return nullptr;
+
+    std::string line;
+    std::getline(stream, line);
+    while (std::getline(stream, line))
+    {
+        if (line.empty())
+            continue;
+
+        // Each file is listed as "<hash> <size> <lastWriteTime> <path>", the path taking up the remainder of the line
+        std::istringstream lineStream(line);
+        Entry entry{};
+        if (!(lineStream >> entry.m_hash >> entry.m_size >> entry.m_last_write_time))
+            return nullptr;
+
+        lineStream.get();
+        std::string filePath;
+        std::getline(lineStream, filePath);
+        if (filePath.empty())
+            return nullptr;
+
+        manifest->m_files.emplace(std::move(filePath), std::move(entry));
+    }
+
+    return manifest;
+}
+
+bool DumpManifest::Write(const fs::path& manifestPath) const
+{
+    std::error_code ec;
+    if (manifestPath.has_parent_path())
+    {
+        fs::create_directories(manifestPath.parent_path(), ec);
+        if (ec)
+            return false;
+    }
+
+    auto tempPath = manifestPath;
+    tempPath += ".tmp";
+
+    {
+        std::ofstream stream(tempPath, std::fstream::out | std::fstream::binary);
+        if (!stream.is_open())
+            return false;
+
+        stream << std::format("{} {}\n", MANIFEST_MAGIC, MANIFEST_VERSION);
+        stream << std::format("key {}\n", m_key);
+        for (const auto& [filePath, entry] : m_files)
+            stream << std::format("{} {} {} {}\n", entry.m_hash, entry.m_size, entry.m_last_write_time, filePath);
+
+        stream.close();
+        if (!stream)
+        {
+            fs::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    fs::rename(tempPath, manifestPath, ec);
+    if (ec)
+    {
+        fs::remove(tempPath, ec);
+        return false;
+    }
+
+    return true;
+}
+
+bool DumpManifest::FilesAreUnchanged(const fs::path& outputFolder) const
+{
+    for (const auto& [filePath, entry] : m_files)
+    {
+        const auto fullPath = outputFolder / fs::path(filePath);
+
+        std::error_code ec;
+        const auto fileSize = fs::file_size(fullPath, ec);
+        if (ec || fileSize != entry.m_size)
+            return false;
+
+        const auto lastWriteTime = fs::last_write_time(fullPath, ec);
+        if (ec || ToManifestTime(lastWriteTime) != entry.m_last_write_time)
+            return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+
+/**
+ * \brief Records the files that were dumped for a zone together with a key of everything they were dumped from.
+ * Dumping the zone again can then leave unchanged files untouched or be skipped entirely when the key did not change.
+ */
+class DumpManifest
+{
+public:
+    static constexpr auto MANIFEST_FILE_EXTENSION = ".manifest";
+
+    class Entry
+    {
+    public:
+        uint64_t m_size;
+        int64_t m_last_write_time;
+        std::string m_hash;
+    };
+
+    std::string m_key;
+
+    // The dumped files by their path relative to the output folder
+    std::map<std::string, Entry> m_files;
+
+    /**
+     * \brief Computes the hash that the content of dumped files is compared with.
+     */
+    static std::string ComputeHash(const void* data, size_t dataSize);
+
+    /**
+     * \return The last write time of a file as it is stored in a manifest.
+     */
+    static int64_t ToManifestTime(std::filesystem::file_time_type lastWriteTime);
+
+    /**
+     * \brief Reads a manifest that was written before.
+     * \return The manifest or \c nullptr if there is no valid manifest at the specified path.
+     */
+    static std::unique_ptr<DumpManifest> Read(const std::filesystem::path& manifestPath);
+
+    /**
+     * \brief Writes the manifest. An existing manifest is only replaced once the new one was written completely.
+     * \return \c true if the manifest was written successfully, otherwise \c false.
+     */
+    bool Write(const std::filesystem::path& manifestPath) const;
+
+    /**
+     * \brief Checks whether all dumped files still exist with the size and last write time they were dumped with.
+     * \param outputFolder The folder that the paths of the dumped files are relative to.
+     */
+    [[nodiscard]] bool FilesAreUnchanged(const std::filesystem::path& outputFolder) const;
+};
@@ -13,5 +13,8 @@ namespace IW4
     protected:
         bool ShouldDump(XAssetInfo<menuDef_t>* asset) override;
         void DumpAsset(AssetDumpingContext& context, XAssetInfo<menuDef_t>* asset) override;
+
+    public:
+        void DumpPool(AssetDumpingContext& context, AssetPool<menuDef_t>* pool) override;
     };
 } // namespace IW4
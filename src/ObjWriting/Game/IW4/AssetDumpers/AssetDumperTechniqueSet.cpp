@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <type_traits>
@@ -17,11 +18,13 @@ namespace IW4
 {
     class TechniqueDumpingZoneState final : public IZoneAssetDumperState
     {
+        std::mutex m_mutex;
         std::set<const MaterialTechnique*> m_dumped_techniques;
 
     public:
         bool ShouldDumpTechnique(const MaterialTechnique* technique)
         {
+            std::lock_guard lock(m_mutex);
             if (m_dumped_techniques.find(technique) != m_dumped_techniques.end())
                 return false;
 
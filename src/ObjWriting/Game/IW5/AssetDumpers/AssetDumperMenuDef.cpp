@@ -55,7 +55,7 @@ void AssetDumperMenuDef::DumpAsset(AssetDumpingContext& context, XAssetInfo<menu
     const auto* menu = asset->Asset();
     const auto menuFilePath = GetPathForMenu(asset);
 
-    if (ObjWriting::ShouldHandleAssetType(ASSET_TYPE_MENULIST))
+    if (ObjWriting::ShouldHandleAssetType(context, ASSET_TYPE_MENULIST))
     {
         // Don't dump menu file separately if the name matches the menu list
         const auto* menuListParent = GetParentMenuList(asset);
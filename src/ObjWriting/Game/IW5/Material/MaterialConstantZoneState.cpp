@@ -199,7 +199,7 @@ namespace IW5
 
     void MaterialConstantZoneState::ExtractNamesFromZoneInternal()
     {
-        for (const auto* zone : IGame::GetGameById(GameId::IW5)->GetZones())
+        for (const auto* zone : m_zone->GetVisibleZones())
         {
             const auto* iw5AssetPools = dynamic_cast<const GameAssetPoolIW5*>(zone->m_pools.get());
             if (!iw5AssetPools)
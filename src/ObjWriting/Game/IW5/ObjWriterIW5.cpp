@@ -22,7 +22,7 @@ using namespace IW5;
 bool ObjWriter::DumpZone(AssetDumpingContext& context) const
 {
 #define DUMP_ASSET_POOL(dumperType, poolName, assetType)                                                                                                       \
-    if (assetPools->poolName && ObjWriting::ShouldHandleAssetType(assetType))                                                                                  \
+    if (assetPools->poolName && ObjWriting::ShouldHandleAssetType(context, assetType))                                                                         \
     {                                                                                                                                                          \
         dumperType dumper;                                                                                                                                     \
         dumper.DumpPool(context, assetPools->poolName.get());                                                                                                  \
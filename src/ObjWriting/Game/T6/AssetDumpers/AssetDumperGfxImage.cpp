@@ -34,21 +34,25 @@ namespace
         return textureLoader.LoadTexture(loadDef.data);
     }
 
-    std::unique_ptr<Texture> LoadImageFromIwi(const GfxImage* image, ISearchPath* searchPath)
+    std::unique_ptr<Texture> LoadImageFromIwi(Zone& zone, const GfxImage* image, ISearchPath* searchPath)
     {
         if (image->streamedPartCount > 0)
         {
-            for (auto* ipak : IPak::Repository)
+            // Only ipaks of visible zones are searched, since other zones may be unlinked and unloaded at the same time
+            for (auto* visibleZone : zone.GetVisibleZones())
             {
-                auto ipakStream = ipak->GetEntryStream(image->hash, image->streamedParts[0].hash);
-
-                if (ipakStream)
+                for (auto* ipak : IPak::Repository.GetContainersReferencedBy(visibleZone))
                 {
-                    auto loadedTexture = iwi::LoadIwi(*ipakStream);
-                    ipakStream->close();
+                    auto ipakStream = ipak->GetEntryStream(image->hash, image->streamedParts[0].hash);
+
+                    if (ipakStream)
+                    {
+                        auto loadedTexture = iwi::LoadIwi(*ipakStream);
+                        ipakStream->close();
 
-                    if (loadedTexture != nullptr)
-                        return loadedTexture;
+                        if (loadedTexture != nullptr)
+                            return loadedTexture;
+                    }
                 }
             }
         }
@@ -64,12 +68,12 @@ namespace
         return iwi::LoadIwi(*filePathImage.m_stream);
     }
 
-    std::unique_ptr<Texture> LoadImageData(ISearchPath* searchPath, const GfxImage* image)
+    std::unique_ptr<Texture> LoadImageData(Zone& zone, ISearchPath* searchPath, const GfxImage* image)
     {
         if (image->texture.loadDef && image->texture.loadDef->resourceSize > 0)
             return LoadImageFromLoadDef(image);
 
-        return LoadImageFromIwi(image, searchPath);
+        return LoadImageFromIwi(zone, image, searchPath);
     }
 } // namespace
 
@@ -106,7 +110,7 @@ std::string AssetDumperGfxImage::GetAssetFileName(const XAssetInfo<GfxImage>& as
 void AssetDumperGfxImage::DumpAsset(AssetDumpingContext& context, XAssetInfo<GfxImage>* asset)
 {
     const auto* image = asset->Asset();
-    const auto texture = LoadImageData(context.m_obj_search_path, image);
+    const auto texture = LoadImageData(*context.m_zone, context.m_obj_search_path, image);
     if (!texture)
         return;
 
@@ -11,14 +11,11 @@
 
 #include <algorithm>
 #include <cmath>
-#include <filesystem>
 #include <format>
-#include <fstream>
 #include <sstream>
 #include <unordered_set>
 
 using namespace T6;
-namespace fs = std::filesystem;
 
 namespace
 {
@@ -199,9 +196,9 @@ namespace
     class LoadedSoundBankHashes
     {
     public:
-        void Initialize()
+        void Initialize(Zone& dumpedZone)
         {
-            for (const auto& zone : IGame::GetGameById(GameId::T6)->GetZones())
+            for (const auto& zone : dumpedZone.GetVisibleZones())
             {
                 auto& sndBankPool = *dynamic_cast<GameAssetPoolT6*>(zone->m_pools.get())->m_sound_bank;
                 for (auto* entry : sndBankPool)
@@ -252,10 +249,8 @@ namespace
         std::unordered_map<unsigned, const char*> m_duck_names;
     };
 
-    [[nodiscard]] std::string GetAssetFilename(const AssetDumpingContext& context, std::string outputFileName, const std::string& extension)
+    [[nodiscard]] std::string GetAssetFilename(std::string outputFileName, const std::string& extension)
     {
-        fs::path assetPath(context.m_base_path);
-
         std::ranges::replace(outputFileName, '\\', '/');
         for (const auto& droppedPrefix : PREFIXES_TO_DROP)
         {
@@ -266,30 +261,15 @@ namespace
             }
         }
 
-        assetPath.append(outputFileName);
         if (!extension.empty())
-            assetPath.concat(extension);
+            outputFileName.append(extension);
 
-        return assetPath.string();
+        return outputFileName;
     }
 
     std::unique_ptr<std::ostream> OpenAssetOutputFile(const AssetDumpingContext& context, const std::string& outputFileName, const std::string& extension)
     {
-        fs::path assetPath(GetAssetFilename(context, outputFileName, extension));
-
-        auto assetDir(assetPath);
-        assetDir.remove_filename();
-
-        create_directories(assetDir);
-
-        auto outputStream = std::make_unique<std::ofstream>(assetPath, std::ios_base::out | std::ios_base::binary);
-
-        if (outputStream->is_open())
-        {
-            return std::move(outputStream);
-        }
-
-        return nullptr;
+        return context.OpenAssetFile(GetAssetFilename(outputFileName, extension));
     }
 
     void WriteAliasFileHeader(CsvOutputStream& stream)
@@ -649,13 +629,17 @@ namespace
         WriteColumnEnum(stream, alias.flags.neverPlayTwice, SOUND_NO_YES);
     }
 
-    SoundBankEntryInputStream FindSoundDataInSoundBanks(const unsigned assetId)
+    SoundBankEntryInputStream FindSoundDataInSoundBanks(Zone& dumpedZone, const unsigned assetId)
     {
-        for (const auto* soundBank : SoundBank::Repository)
+        // Only sound banks of visible zones are searched, since other zones may be unlinked and unloaded at the same time
+        for (auto* zone : dumpedZone.GetVisibleZones())
         {
-            auto soundFile = soundBank->GetEntryStream(assetId);
-            if (soundFile.IsOpen())
-                return soundFile;
+            for (const auto* soundBank : SoundBank::Repository.GetContainersReferencedBy(zone))
+            {
+                auto soundFile = soundBank->GetEntryStream(assetId);
+                if (soundFile.IsOpen())
+                    return soundFile;
+            }
         }
 
         return {};
@@ -714,7 +698,7 @@ namespace
 
     [[nodiscard]] std::optional<snd_asset_format> DumpSndAlias(const AssetDumpingContext& context, const SndAlias& alias)
     {
-        const auto soundFile = FindSoundDataInSoundBanks(alias.assetId);
+        const auto soundFile = FindSoundDataInSoundBanks(*context.m_zone, alias.assetId);
         if (soundFile.IsOpen())
         {
             const auto format = static_cast<snd_asset_format>(soundFile.m_entry.format);
@@ -913,7 +897,7 @@ namespace
 void AssetDumperSndBank::DumpPool(AssetDumpingContext& context, AssetPool<SndBank>* pool)
 {
     LoadedSoundBankHashes soundBankHashes;
-    soundBankHashes.Initialize();
+    soundBankHashes.Initialize(*context.m_zone);
     for (const auto* assetInfo : *pool)
     {
         if (!assetInfo->m_name.empty() && assetInfo->m_name[0] == ',')
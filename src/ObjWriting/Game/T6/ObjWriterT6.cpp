@@ -31,7 +31,7 @@ using namespace T6;
 bool ObjWriter::DumpZone(AssetDumpingContext& context) const
 {
 #define DUMP_ASSET_POOL(dumperType, poolName, assetType)                                                                                                       \
-    if (assetPools->poolName && ObjWriting::ShouldHandleAssetType(assetType))                                                                                  \
+    if (assetPools->poolName && ObjWriting::ShouldHandleAssetType(context, assetType))                                                                         \
     {                                                                                                                                                          \
         dumperType dumper;                                                                                                                                     \
         dumper.DumpPool(context, assetPools->poolName.get());                                                                                                  \
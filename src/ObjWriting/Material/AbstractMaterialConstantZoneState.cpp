@@ -13,6 +13,16 @@ namespace
     constexpr const char* PER_OBJECT_CONSTS_CBUFFER_NAME = "PerObjectConsts";
 } // namespace
 
+AbstractMaterialConstantZoneState::AbstractMaterialConstantZoneState()
+    : m_zone(nullptr)
+{
+}
+
+void AbstractMaterialConstantZoneState::SetZone(Zone* zone)
+{
+    m_zone = zone;
+}
+
 void AbstractMaterialConstantZoneState::ExtractNamesFromZone()
 {
     if (ObjWriting::Configuration.Verbose)
@@ -9,6 +9,9 @@
 class AbstractMaterialConstantZoneState : public IZoneAssetDumperState
 {
 public:
+    AbstractMaterialConstantZoneState();
+
+    void SetZone(Zone* zone) override;
     void ExtractNamesFromZone();
     bool GetConstantName(unsigned hash, std::string& constantName) const;
     bool GetTextureDefName(unsigned hash, std::string& textureDefName) const;
@@ -23,6 +26,7 @@ protected:
     void AddConstantName(const std::string& constantName);
     bool AddTextureDefName(const std::string& textureDefName);
 
+    Zone* m_zone;
     std::unordered_set<const void*> m_dumped_structs;
     std::unordered_map<unsigned, std::string> m_constant_names_from_shaders;
     std::unordered_map<unsigned, std::string> m_texture_def_names_from_shaders;
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+
+/**
+ * \brief Writes files into a single archive instead of the file system.
+ */
+class IArchiveWriter
+{
+public:
+    IArchiveWriter() = default;
+    virtual ~IArchiveWriter() = default;
+
+    IArchiveWriter(const IArchiveWriter& other) = default;
+    IArchiveWriter(IArchiveWriter&& other) noexcept = default;
+    IArchiveWriter& operator=(const IArchiveWriter& other) = default;
+    IArchiveWriter& operator=(IArchiveWriter&& other) noexcept = default;
+
+    /**
+     * \brief Adds a file to the archive. Can be called from multiple threads at the same time.
+     * Files are stored in the order they were added, so files added from multiple threads can end up in a different order each time.
+     * \param fileName The path of the file inside the archive, separated by forward slashes.
+     * \param data The content of the file.
+     */
+    virtual void AddFile(std::string fileName, std::string data) = 0;
+
+    /**
+     * \brief Writes all remaining files and finishes the archive. No files can be added afterwards.
+     * \return \c true if all files were written successfully, otherwise \c false.
+     */
+    virtual bool Write() = 0;
+};
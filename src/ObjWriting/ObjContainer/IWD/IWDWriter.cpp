@@ -0,0 +1,229 @@
+#include "IWDWriter.h"
+
+#include "Utils/FileToZlibWrapper.h"
+#include "Utils/ThreadPool.h"
+
+#include <condition_variable>
+#include <future>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <zip.h>
+#include <zlib.h>
+
+class IWDWriterImpl final : public IWDWriter
+{
+    // Files that were added but are not written yet must not exceed this size, so that dumping cannot run too far ahead of writing
+    static constexpr size_t MAX_PENDING_BYTES = 64u * 1024u * 1024u;
+
+    class Entry
+    {
+    public:
+        std::string m_file_name;
+        std::string m_data;
+        std::string m_compressed_data;
+        uLong m_crc;
+        bool m_stored;
+        std::promise<void> m_compression_done;
+        std::future<void> m_compressed;
+    };
+
+public:
+    explicit IWDWriterImpl(std::ostream& stream)
+        : m_zip_file(nullptr),
+          m_pending_bytes(0u),
+          m_finishing(false),
+          m_written(false),
+          m_failed(false)
+    {
+        auto ioFunctions = FileToZlibWrapper::CreateFunctions32ForFile(&stream);
+        m_zip_file = zipOpen2("", APPEND_STATUS_CREATE, nullptr, &ioFunctions);
+        if (m_zip_file == nullptr)
+            m_failed = true;
+
+        m_writer = std::thread(&IWDWriterImpl::WriterMain, this);
+    }
+
+    ~IWDWriterImpl() override
+    {
+        if (!m_written)
+            Write();
+    }
+
+    IWDWriterImpl(const IWDWriterImpl& other) = delete;
+    IWDWriterImpl(IWDWriterImpl&& other) noexcept = delete;
+    IWDWriterImpl& operator=(const IWDWriterImpl& other) = delete;
+    IWDWriterImpl& operator=(IWDWriterImpl&& other) noexcept = delete;
+
+    void AddFile(std::string fileName, std::string data) override
+    {
+        auto entry = std::make_shared<Entry>();
+        entry->m_file_name = std::move(fileName);
+        entry->m_data = std::move(data);
+        entry->m_crc = 0u;
+        entry->m_stored = false;
+        entry->m_compressed = entry->m_compression_done.get_future();
+
+        {
+            std::unique_lock lock(m_mutex);
+            m_entries_changed.wait(lock,
+                                   [this]
+                                   {
+                                       return m_pending_bytes <= MAX_PENDING_BYTES || m_entries.empty();
+                                   });
+
+            m_pending_bytes += entry->m_data.size();
+            m_entries.emplace(entry);
+        }
+        m_entries_changed.notify_all();
+
+        ThreadPool::Default().Submit(
+            [entry]
+            {
+                CompressEntry(*entry);
+                entry->m_compression_done.set_value();
+            });
+    }
+
+    bool Write() override
+    {
+        if (m_written)
+            return !m_failed;
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_finishing = true;
+        }
+        m_entries_changed.notify_all();
+        m_writer.join();
+
+        if (m_zip_file != nullptr && zipClose(m_zip_file, nullptr) != ZIP_OK)
+            m_failed = true;
+
+        m_zip_file = nullptr;
+        m_written = true;
+
+        return !m_failed;
+    }
+
+private:
+    static void CompressEntry(Entry& entry)
+    {
+        const auto dataSize = entry.m_data.size();
+        if (dataSize > std::numeric_limits<uInt>::max())
+        {
+            entry.m_stored = true;
+            return;
+        }
+
+        entry.m_crc = crc32(0u, reinterpret_cast<const Bytef*>(entry.m_data.data()), static_cast<uInt>(dataSize));
+
+        z_stream zs{};
+        // Zip entries contain raw deflate data without a zlib header
+        if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        {
+            entry.m_stored = true;
+            return;
+        }
+
+        entry.m_compressed_data.resize(deflateBound(&zs, static_cast<uLong>(dataSize)));
+        zs.next_in = reinterpret_cast<Bytef*>(entry.m_data.data());
+        zs.avail_in = static_cast<uInt>(dataSize);
+        zs.next_out = reinterpret_cast<Bytef*>(entry.m_compressed_data.data());
+        zs.avail_out = static_cast<uInt>(entry.m_compressed_data.size());
+
+        const auto result = deflate(&zs, Z_FINISH);
+        entry.m_compressed_data.resize(zs.total_out);
+        deflateEnd(&zs);
+
+        // Files that do not get smaller are stored as they are
+        if (result != Z_STREAM_END || entry.m_compressed_data.size() >= dataSize)
+        {
+            entry.m_stored = true;
+            entry.m_compressed_data.clear();
+            entry.m_compressed_data.shrink_to_fit();
+        }
+    }
+
+    void WriteEntry(const Entry& entry)
+    {
+        if (m_zip_file == nullptr)
+            return;
+
+        if (entry.m_data.size() > std::numeric_limits<unsigned>::max())
+        {
+            std::cerr << "Cannot write file \"" << entry.m_file_name << "\" to IWD: Files must be smaller than 4GB\n";
+            m_failed = true;
+            return;
+        }
+
+        zip_fileinfo fileInfo{};
+        const auto method = entry.m_stored ? 0 : Z_DEFLATED;
+        const auto& writtenData = entry.m_stored ? entry.m_data : entry.m_compressed_data;
+
+        // The data is already compressed, so it is added raw
+        if (zipOpenNewFileInZip2(m_zip_file, entry.m_file_name.c_str(), &fileInfo, nullptr, 0, nullptr, 0, nullptr, method, Z_DEFAULT_COMPRESSION, 1) != ZIP_OK)
+        {
+            std::cerr << "Failed to add file \"" << entry.m_file_name << "\" to IWD\n";
+            m_failed = true;
+            return;
+        }
+
+        if (!writtenData.empty() && zipWriteInFileInZip(m_zip_file, writtenData.data(), static_cast<unsigned>(writtenData.size())) != ZIP_OK)
+            m_failed = true;
+
+        if (zipCloseFileInZipRaw(m_zip_file, static_cast<uLong>(entry.m_data.size()), entry.m_crc) != ZIP_OK)
+            m_failed = true;
+    }
+
+    void WriterMain()
+    {
+        while (true)
+        {
+            std::shared_ptr<Entry> entry;
+            {
+                std::unique_lock lock(m_mutex);
+                m_entries_changed.wait(lock,
+                                       [this]
+                                       {
+                                           return !m_entries.empty() || m_finishing;
+                                       });
+
+                // All added files are still written when finishing
+                if (m_entries.empty())
+                    return;
+
+                entry = std::move(m_entries.front());
+                m_entries.pop();
+            }
+
+            entry->m_compressed.wait();
+            WriteEntry(*entry);
+
+            {
+                std::lock_guard lock(m_mutex);
+                m_pending_bytes -= entry->m_data.size();
+            }
+            m_entries_changed.notify_all();
+        }
+    }
+
+    zipFile m_zip_file;
+
+    std::queue<std::shared_ptr<Entry>> m_entries;
+    size_t m_pending_bytes;
+    bool m_finishing;
+    std::mutex m_mutex;
+    std::condition_variable m_entries_changed;
+    std::thread m_writer;
+
+    bool m_written;
+    bool m_failed;
+};
+
+std::unique_ptr<IWDWriter> IWDWriter::Create(std::ostream& stream)
+{
+    return std::make_unique<IWDWriterImpl>(stream);
+}
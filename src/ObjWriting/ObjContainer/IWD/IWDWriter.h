@@ -0,0 +1,16 @@
+#pragma once
+
+#include "ObjContainer/IArchiveWriter.h"
+
+#include <memory>
+#include <ostream>
+
+/**
+ * \brief Writes deflate compressed files into an IWD, which is a zip archive.
+ * Files are compressed on the default thread pool as soon as they are added and written into the stream in the order they were added.
+ */
+class IWDWriter : public IArchiveWriter
+{
+public:
+    static std::unique_ptr<IWDWriter> Create(std::ostream& stream);
+};
@@ -0,0 +1,178 @@
+#include "TarWriter.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+
+namespace
+{
+    constexpr size_t BLOCK_SIZE = 512u;
+    constexpr size_t NAME_SIZE = 100u;
+    constexpr size_t PREFIX_SIZE = 155u;
+    constexpr auto LONG_NAME_ENTRY_NAME = "././@LongLink";
+
+    struct TarHeader
+    {
+        char name[100];
+        char mode[8];
+        char uid[8];
+        char gid[8];
+        char size[12];
+        char mtime[12];
+        char checksum[8];
+        char type_flag;
+        char link_name[100];
+        char magic[6];
+        char version[2];
+        char user_name[32];
+        char group_name[32];
+        char dev_major[8];
+        char dev_minor[8];
+        char prefix[155];
+        char padding[12];
+    };
+
+    static_assert(sizeof(TarHeader) == BLOCK_SIZE);
+
+    void WriteOctal(char* field, const size_t fieldSize, uint64_t value)
+    {
+        // Octal digits followed by a terminating null
+        std::memset(field, '0', fieldSize - 1u);
+        field[fieldSize - 1u] = '\0';
+
+        for (auto i = fieldSize - 1u; i > 0u && value > 0u; i--)
+        {
+            field[i - 1u] = static_cast<char>('0' + (value & 7u));
+            value >>= 3u;
+        }
+    }
+
+    void WriteSize(char (&field)[12], uint64_t size)
+    {
+        // Sizes that do not fit into 11 octal digits use the base-256 extension of GNU tar
+        if (size < (1ull << 33u))
+        {
+            WriteOctal(field, sizeof(field), size);
+            return;
+        }
+
+        field[0] = static_cast<char>(0x80);
+        for (auto i = sizeof(field) - 1u; i > 0u; i--)
+        {
+            field[i] = static_cast<char>(size & 0xFFu);
+            size >>= 8u;
+        }
+    }
+
+    /**
+     * \brief Splits a file name into the name and prefix fields of a ustar header.
+     * \return \c true if the file name fits into the fields, otherwise \c false.
+     */
+    bool SplitFileName(const std::string& fileName, TarHeader& header)
+    {
+        if (fileName.size() <= NAME_SIZE)
+        {
+            std::memcpy(header.name, fileName.data(), fileName.size());
+            return true;
+        }
+
+        // The prefix and the name are joined with a slash when extracting
+        auto separator = fileName.find('/', fileName.size() - NAME_SIZE - 1u);
+        if (separator == std::string::npos || separator > PREFIX_SIZE || separator == 0u)
+            return false;
+
+        std::memcpy(header.prefix, fileName.data(), separator);
+        std::memcpy(header.name, fileName.data() + separator + 1u, fileName.size() - separator - 1u);
+        return true;
+    }
+} // namespace
+
+class TarWriterImpl final : public TarWriter
+{
+public:
+    explicit TarWriterImpl(std::ostream& stream)
+        : m_stream(stream),
+          m_written(false)
+    {
+    }
+
+    void AddFile(std::string fileName, std::string data) override
+    {
+        std::lock_guard lock(m_mutex);
+
+        TarHeader header{};
+        if (!SplitFileName(fileName, header))
+        {
+            // Names that are too long for ustar are stored in a preceding entry like GNU tar does
+            const std::string longName(fileName.c_str(), fileName.size() + 1u);
+            WriteEntry(LONG_NAME_ENTRY_NAME, 'L', longName);
+
+            std::memcpy(header.name, fileName.data(), NAME_SIZE);
+        }
+
+        WriteEntry(header, '0', data);
+    }
+
+    bool Write() override
+    {
+        std::lock_guard lock(m_mutex);
+
+        if (!m_written)
+        {
+            // An archive ends with two empty blocks
+            static constexpr char END_OF_ARCHIVE[BLOCK_SIZE * 2u]{};
+            m_stream.write(END_OF_ARCHIVE, sizeof(END_OF_ARCHIVE));
+            m_stream.flush();
+            m_written = true;
+        }
+
+        return m_stream.good();
+    }
+
+private:
+    void WriteEntry(const char* name, const char typeFlag, const std::string& data)
+    {
+        TarHeader header{};
+        std::memcpy(header.name, name, std::min(std::strlen(name), NAME_SIZE));
+        WriteEntry(header, typeFlag, data);
+    }
+
+    void WriteEntry(TarHeader& header, const char typeFlag, const std::string& data)
+    {
+        WriteOctal(header.mode, sizeof(header.mode), 0644u);
+        WriteOctal(header.uid, sizeof(header.uid), 0u);
+        WriteOctal(header.gid, sizeof(header.gid), 0u);
+        WriteSize(header.size, data.size());
+        // The modification time is left empty so that the archive only depends on the added files and their order
+        WriteOctal(header.mtime, sizeof(header.mtime), 0u);
+        header.type_flag = typeFlag;
+        std::memcpy(header.magic, "ustar", 6u);
+        std::memcpy(header.version, "00", 2u);
+
+        // The checksum is calculated with the checksum field filled with spaces
+        std::memset(header.checksum, ' ', sizeof(header.checksum));
+        const auto* headerBytes = reinterpret_cast<const unsigned char*>(&header);
+        unsigned checksum = 0u;
+        for (auto i = 0u; i < sizeof(header); i++)
+            checksum += headerBytes[i];
+
+        WriteOctal(header.checksum, sizeof(header.checksum) - 1u, checksum);
+
+        m_stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        m_stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+
+        static constexpr char PADDING[BLOCK_SIZE]{};
+        const auto paddingSize = (BLOCK_SIZE - data.size() % BLOCK_SIZE) % BLOCK_SIZE;
+        m_stream.write(PADDING, static_cast<std::streamsize>(paddingSize));
+    }
+
+    std::ostream& m_stream;
+    bool m_written;
+    std::mutex m_mutex;
+};
+
+std::unique_ptr<TarWriter> TarWriter::Create(std::ostream& stream)
+{
+    return std::make_unique<TarWriterImpl>(stream);
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "ObjContainer/IArchiveWriter.h"
+
+#include <memory>
+#include <ostream>
+
+/**
+ * \brief Writes files uncompressed into a ustar archive in the order they were added.
+ */
+class TarWriter : public IArchiveWriter
+{
+public:
+    static std::unique_ptr<TarWriter> Create(std::ostream& stream);
+};
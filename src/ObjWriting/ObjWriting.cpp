@@ -2,12 +2,14 @@
 
 ObjWriting::Configuration_t ObjWriting::Configuration;
 
-bool ObjWriting::ShouldHandleAssetType(const asset_type_t assetType)
+bool ObjWriting::ShouldHandleAssetType(const AssetDumpingContext& context, const asset_type_t assetType)
 {
     if (assetType < 0)
         return false;
-    if (static_cast<size_t>(assetType) >= Configuration.AssetTypesToHandleBitfield.size())
+
+    const auto& assetTypesToHandle = Configuration.AssetTypesToHandleBitfield[static_cast<unsigned>(context.m_zone->m_game->GetId())];
+    if (static_cast<size_t>(assetType) >= assetTypesToHandle.size())
         return true;
 
-    return Configuration.AssetTypesToHandleBitfield[assetType];
+    return assetTypesToHandle[assetType];
 }
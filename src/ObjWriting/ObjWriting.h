@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Dumping/AssetDumpingContext.h"
+#include "Game/IGame.h"
 #include "Zone/ZoneTypes.h"
 
 #include <vector>
@@ -26,7 +27,7 @@ public:
         };
 
         bool Verbose = false;
-        std::vector<bool> AssetTypesToHandleBitfield;
+        std::vector<bool> AssetTypesToHandleBitfield[static_cast<unsigned>(GameId::COUNT)];
 
         ImageOutputFormat_e ImageOutputFormat = ImageOutputFormat_e::DDS;
         ModelOutputFormat_e ModelOutputFormat = ModelOutputFormat_e::GLB;
@@ -34,5 +35,5 @@ public:
 
     } Configuration;
 
-    static bool ShouldHandleAssetType(asset_type_t assetType);
+    static bool ShouldHandleAssetType(const AssetDumpingContext& context, asset_type_t assetType);
 };
@@ -3,6 +3,7 @@
 #include "Dumping/IZoneAssetDumperState.h"
 #include "Parsing/GenericGraph2D.h"
 
+#include <mutex>
 #include <string>
 #include <unordered_set>
 
@@ -16,6 +17,7 @@ public:
     static void DumpAiVsPlayerGraph(const AssetDumpingContext& context, const GenericGraph2D& aiVsPlayerGraph);
 
 private:
+    std::mutex m_mutex;
     std::unordered_set<std::string> m_dumped_ai_vs_ai_graphs;
     std::unordered_set<std::string> m_dumped_ai_vs_player_graphs;
 };
@@ -2,23 +2,39 @@
 
 #include "ContentLister/ContentPrinter.h"
 #include "ContentLister/ZoneDefWriter.h"
+#include "Dumping/DumpManifest.h"
+#include "GitVersion.h"
 #include "IObjLoader.h"
 #include "IObjWriter.h"
+#include "Loading/ZoneCache.h"
 #include "ObjContainer/IWD/IWD.h"
+#include "ObjContainer/IWD/IWDWriter.h"
+#include "ObjContainer/Tar/TarWriter.h"
 #include "ObjLoading.h"
 #include "ObjWriting.h"
+#include "Pool/GlobalAssetPoolIsolation.h"
 #include "SearchPath/SearchPathFilesystem.h"
 #include "SearchPath/SearchPaths.h"
 #include "UnlinkerArgs.h"
 #include "Utils/ClassUtils.h"
 #include "Utils/ObjFileStream.h"
+#include "Utils/OutputCapture.h"
+#include "Utils/StringUtils.h"
+#include "Utils/ThreadPool.h"
 #include "ZoneLoading.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <filesystem>
 #include <format>
 #include <fstream>
+#include <future>
+#include <map>
+#include <mutex>
 #include <regex>
 #include <set>
+#include <sstream>
+#include <unordered_map>
 
 namespace fs = std::filesystem;
 
@@ -43,6 +59,13 @@ public:
         if (!LoadZones())
             return false;
 
+        // Output of concurrently dumped assets and zones is captured to print it in the order of the pool and the zones
+        std::unique_ptr<OutputCapture::Redirection> outputRedirection;
+        if (m_args.m_thread_count > 1 || m_args.m_jobs > 1)
+            outputRedirection = std::make_unique<OutputCapture::Redirection>();
+        if (m_args.m_thread_count > 1)
+            m_dump_thread_pool = std::make_unique<ThreadPool>(m_args.m_thread_count);
+
         const auto result = UnlinkZones();
 
         UnloadZones();
@@ -155,52 +178,82 @@ private:
         return true;
     }
 
-    bool WriteZoneDefinitionFile(const Zone& zone, const fs::path& zoneDefinitionFileFolder) const
+    bool WriteZoneDefinitionFile(const AssetDumpingContext& context) const
     {
-        auto zoneDefinitionFilePath(zoneDefinitionFileFolder);
-        zoneDefinitionFilePath.append(zone.m_name);
-        zoneDefinitionFilePath.replace_extension(".zone");
-
-        std::ofstream zoneDefinitionFile(zoneDefinitionFilePath, std::fstream::out | std::fstream::binary);
-        if (!zoneDefinitionFile.is_open())
+        const auto& zone = *context.m_zone;
+        const auto zoneDefinitionFile = context.OpenAssetFile(std::format("zone_source/{}.zone", zone.m_name));
+        if (!zoneDefinitionFile)
         {
             std::cerr << std::format("Failed to open file for zone definition file of zone \"{}\".\n", zone.m_name);
             return false;
         }
 
         const auto* zoneDefWriter = IZoneDefWriter::GetZoneDefWriterForGame(zone.m_game->GetId());
-        zoneDefWriter->WriteZoneDef(zoneDefinitionFile, m_args, zone);
-
-        zoneDefinitionFile.close();
+        zoneDefWriter->WriteZoneDef(*zoneDefinitionFile, m_args, zone);
 
         return true;
     }
 
-    static bool OpenGdtFile(const Zone& zone, const fs::path& outputFolder, std::ofstream& stream)
+    static std::unique_ptr<std::ostream> OpenGdtFile(const AssetDumpingContext& context)
     {
-        auto gdtFilePath(outputFolder);
-        gdtFilePath.append("source_data");
+        const auto& zone = *context.m_zone;
+        auto stream = context.OpenAssetFile(std::format("source_data/{}.gdt", zone.m_name));
+        if (!stream)
+            std::cerr << std::format("Failed to open GDT file of zone \"{}\".\n", zone.m_name);
 
-        fs::create_directories(gdtFilePath);
-
-        gdtFilePath.append(zone.m_name);
-        gdtFilePath.replace_extension(".gdt");
+        return stream;
+    }
 
-        stream = std::ofstream(gdtFilePath, std::fstream::out | std::fstream::binary);
-        if (!stream.is_open())
+    /**
+     * \brief Creates the output that the files of a dumped zone are written to.
+     * When dumping into an archive, the archive is placed next to the output folder and named like it.
+     */
+    std::shared_ptr<AssetFileOutput> CreateAssetFileOutput(const std::string& outputFolderPath) const
+    {
+        if (m_args.m_archive_format == UnlinkerArgs::ArchiveFormat::NONE)
+            return std::make_shared<AssetFileOutput>(m_args.m_write_buffer_size, m_args.m_async_write);
+
+        fs::path archivePath(outputFolderPath);
+        archivePath.replace_extension(m_args.m_archive_format == UnlinkerArgs::ArchiveFormat::TAR   ? ".tar"
+                                      : m_args.m_archive_format == UnlinkerArgs::ArchiveFormat::ZIP ? ".zip"
+                                                                                                    : ".iwd");
+        if (archivePath.has_parent_path())
+            fs::create_directories(archivePath.parent_path());
+
+        auto archiveStream = std::make_unique<std::ofstream>(archivePath, std::fstream::out | std::fstream::binary);
+        if (!archiveStream->is_open())
         {
-            std::cerr << std::format("Failed to open file for zone definition file of zone \"{}\".\n", zone.m_name);
-            return false;
+            std::cerr << std::format("Failed to open archive file \"{}\".\n", archivePath.string());
+            return nullptr;
         }
 
-        return true;
+        if (m_args.m_verbose)
+            std::cout << std::format("Dumping into archive \"{}\"\n", archivePath.string());
+
+        std::unique_ptr<IArchiveWriter> archive;
+        if (m_args.m_archive_format == UnlinkerArgs::ArchiveFormat::TAR)
+            archive = TarWriter::Create(*archiveStream);
+        else
+            archive = IWDWriter::Create(*archiveStream);
+
+        return std::make_shared<AssetFileOutput>(std::move(archiveStream), std::move(archive), fs::path(outputFolderPath));
     }
 
+    /**
+     * \brief Decides which asset types of the game of the zone are dumped.
+     * This only happens for the first zone of each game, since it only depends on the game.
+     */
     void UpdateAssetIncludesAndExcludes(const AssetDumpingContext& context) const
     {
+        std::lock_guard lock(m_asset_types_to_handle_mutex);
+
+        auto& assetTypesToHandle = ObjWriting::Configuration.AssetTypesToHandleBitfield[static_cast<unsigned>(context.m_zone->m_game->GetId())];
+        if (!assetTypesToHandle.empty())
+            return;
+
         const auto assetTypeCount = context.m_zone->m_pools->GetAssetTypeCount();
 
-        ObjWriting::Configuration.AssetTypesToHandleBitfield = std::vector<bool>(assetTypeCount);
+        assetTypesToHandle = std::vector<bool>(assetTypeCount);
 
         std::vector<bool> handledSpecifiedAssets(m_args.m_specified_asset_types.size());
         for (auto i = 0; i < assetTypeCount; i++)
@@ -210,12 +263,12 @@ private:
             const auto foundSpecifiedEntry = m_args.m_specified_asset_type_map.find(assetTypeName);
             if (foundSpecifiedEntry != m_args.m_specified_asset_type_map.end())
             {
-                ObjWriting::Configuration.AssetTypesToHandleBitfield[i] = m_args.m_asset_type_handling == UnlinkerArgs::AssetTypeHandling::INCLUDE;
+                assetTypesToHandle[i] = m_args.m_asset_type_handling == UnlinkerArgs::AssetTypeHandling::INCLUDE;
                 assert(foundSpecifiedEntry->second < handledSpecifiedAssets.size());
                 handledSpecifiedAssets[foundSpecifiedEntry->second] = true;
             }
             else
-                ObjWriting::Configuration.AssetTypesToHandleBitfield[i] = m_args.m_asset_type_handling == UnlinkerArgs::AssetTypeHandling::EXCLUDE;
+                assetTypesToHandle[i] = m_args.m_asset_type_handling == UnlinkerArgs::AssetTypeHandling::EXCLUDE;
         }
 
         auto anySpecifiedValueInvalid = false;
@@ -251,9 +304,10 @@ private:
      * \brief Performs the tasks specified by the command line arguments on the specified zone.
      * \param searchPath The search path for obj data.
      * \param zone The zone to handle.
+     * \param dumpKey The key of everything the zone is dumped from when dumping incrementally, otherwise empty.
      * \return \c true if handling the zone was successful, otherwise \c false.
      */
-    bool HandleZone(ISearchPath& searchPath, Zone& zone) const
+    bool HandleZone(ISearchPath& searchPath, Zone& zone, const std::string& dumpKey) const
     {
         if (m_args.m_task == UnlinkerArgs::ProcessingTask::LIST)
         {
@@ -263,26 +317,31 @@ private:
         else if (m_args.m_task == UnlinkerArgs::ProcessingTask::DUMP)
         {
             const auto outputFolderPath = m_args.GetOutputFolderPathForZone(zone);
-            fs::create_directories(outputFolderPath);
 
-            fs::path zoneDefinitionFileFolder(outputFolderPath);
-            zoneDefinitionFileFolder.append("zone_source");
-            fs::create_directories(zoneDefinitionFileFolder);
-
-            if (!WriteZoneDefinitionFile(zone, zoneDefinitionFileFolder))
-                return false;
-
-            std::ofstream gdtStream;
             AssetDumpingContext context;
             context.m_zone = &zone;
             context.m_base_path = outputFolderPath;
+            context.m_output = CreateAssetFileOutput(outputFolderPath);
             context.m_obj_search_path = &searchPath;
+            context.m_thread_pool = m_dump_thread_pool.get();
+
+            if (!context.m_output)
+                return false;
+
+            const auto manifestPath = GetManifestPath(outputFolderPath, zone.m_name);
+            if (m_args.m_incremental)
+                context.m_output->EnableIncremental(outputFolderPath, DumpManifest::Read(manifestPath));
 
+            if (!WriteZoneDefinitionFile(context))
+                return false;
+
+            std::unique_ptr<std::ostream> gdtStream;
             if (m_args.m_use_gdt)
             {
-                if (!OpenGdtFile(zone, outputFolderPath, gdtStream))
+                gdtStream = OpenGdtFile(context);
+                if (!gdtStream)
                     return false;
-                auto gdt = std::make_unique<GdtOutputStream>(gdtStream);
+                auto gdt = std::make_unique<GdtOutputStream>(*gdtStream);
                 gdt->BeginStream();
                 gdt->WriteVersion(GdtVersion(zone.m_game->GetShortName(), 1));
                 context.m_gdt = std::move(gdt);
@@ -297,7 +356,32 @@ private:
             if (m_args.m_use_gdt)
             {
                 context.m_gdt->EndStream();
-                gdtStream.close();
+                gdtStream.reset();
+            }
+
+            if (!context.m_output->Close())
+            {
+                std::cerr << std::format("Failed to write dumped files of zone \"{}\".\n", zone.m_name);
+                result = false;
+            }
+
+            // The manifest is only kept for complete dumps, so that a failed dump is not skipped when running again
+            if (m_args.m_incremental)
+            {
+                std::error_code ec;
+                if (!result || dumpKey.empty())
+                    fs::remove(manifestPath, ec);
+                else if (!context.m_output->CreateManifest(dumpKey).Write(manifestPath))
+                    std::cerr << std::format("Failed to write dump manifest of zone \"{}\".\n", zone.m_name);
+            }
+
+            if (m_args.m_verbose)
+            {
+                std::cout << std::format("Wrote {} files ({} bytes) for zone \"{}\", {} files were unchanged\n",
+                                         context.m_output->GetWrittenFileCount(),
+                                         context.m_output->GetWrittenByteCount(),
+                                         zone.m_name,
+                                         context.m_output->GetUnchangedFileCount());
             }
 
             if (!result)
@@ -335,6 +419,11 @@ private:
             if (m_args.m_verbose)
                 std::cout << std::format("Loaded zone \"{}\"\n", zone->m_name);
 
+            // Assets of loaded zones can be referenced when dumping, so they are part of the key of incremental dumps
+            std::string loadedZoneKey;
+            if (m_args.m_incremental && ZoneCache::ComputeContentHash(zonePath, loadedZoneKey))
+                m_loaded_zones_key += std::format("{} {}\n", zone->m_name, loadedZoneKey);
+
             if (ShouldLoadObj())
             {
                 const auto* objLoader = IObjLoader::GetObjLoaderForGame(zone->m_game->GetId());
@@ -370,49 +459,385 @@ private:
         m_loaded_zones.clear();
     }
 
-    bool UnlinkZones()
+    static std::string GetAbsoluteZoneDirectory(const std::string& zonePath)
     {
-        for (const auto& zonePath : m_args.m_zones_to_unlink)
+        auto zoneDirectory = fs::path(zonePath).remove_filename();
+        if (zoneDirectory.empty())
+            zoneDirectory = fs::current_path();
+
+        return absolute(zoneDirectory).string();
+    }
+
+    static fs::path GetManifestPath(const std::string& outputFolderPath, const std::string& zoneName)
+    {
+        return fs::path(outputFolderPath) / "zone_source" / std::format("{}{}", zoneName, DumpManifest::MANIFEST_FILE_EXTENSION);
+    }
+
+    /**
+     * \brief Adds the name, size and last write time of all files in a folder that obj data may be loaded from to a dump key.
+     * Other zones are left out, since changing them does not affect the dumped files of a zone.
+     */
+    static void AddObjFolderToDumpKey(std::ostream& keyStream, const std::string& folderPath)
+    {
+        std::map<std::string, std::string> files;
+
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(folderPath, ec))
         {
-            if (!fs::is_regular_file(zonePath))
-            {
-                std::cerr << std::format("Could not find file \"{}\".\n", zonePath);
+            std::error_code entryEc;
+            if (!entry.is_regular_file(entryEc))
+                continue;
+
+            auto extension = entry.path().extension().string();
+            utils::MakeStringLowerCase(extension);
+            if (extension == ".ff")
+                continue;
+
+            const auto fileSize = entry.file_size(entryEc);
+            const auto lastWriteTime = entry.last_write_time(entryEc);
+            if (entryEc)
                 continue;
+
+            files.emplace(entry.path().filename().string(), std::format("{} {}", fileSize, DumpManifest::ToManifestTime(lastWriteTime)));
+        }
+
+        keyStream << std::format("folder {}\n", folderPath);
+        for (const auto& [fileName, fileInfo] : files)
+            keyStream << std::format("{} {}\n", fileName, fileInfo);
+    }
+
+    /**
+     * \brief Computes the key of everything the dumped files of a zone are created from: The zone itself, the zones loaded in addition to it,
+     * the obj data next to it and in the search paths as well as the version of the Unlinker and the options that affect dumping.
+     * The key covers the zone as a whole: Loaded assets cannot be hashed individually, so any change to a zone dumps all of its assets again.
+     * \param zonePath The path to the zone file.
+     * \param key Receives the key.
+     * \return \c true if the key could be computed, otherwise \c false.
+     */
+    bool ComputeDumpKey(const std::string& zonePath, std::string& key) const
+    {
+        // Size and modification time can stay the same when the content of a zone changes, so the whole zone is hashed
+        std::string zoneKey;
+        if (!ZoneCache::ComputeContentHash(zonePath, zoneKey))
+            return false;
+
+        std::ostringstream keyStream;
+        keyStream << std::format("version {}\n", GIT_VERSION);
+        keyStream << std::format("zone {}\n", zoneKey);
+        keyStream << m_loaded_zones_key;
+
+        keyStream << std::format("options {} {} {} {} {} {} {}\n",
+                                 static_cast<unsigned>(ObjWriting::Configuration.ImageOutputFormat),
+                                 static_cast<unsigned>(ObjWriting::Configuration.ModelOutputFormat),
+                                 ObjWriting::Configuration.MenuLegacyMode,
+                                 m_args.m_use_gdt,
+                                 m_args.m_minimal_zone_def,
+                                 m_args.m_skip_obj,
+                                 static_cast<unsigned>(m_args.m_asset_type_handling));
+
+        const std::set<std::string> specifiedAssetTypes(m_args.m_specified_asset_types.begin(), m_args.m_specified_asset_types.end());
+        for (const auto& assetType : specifiedAssetTypes)
+            keyStream << std::format("asset type {}\n", assetType);
+
+        if (ShouldLoadObj())
+        {
+            AddObjFolderToDumpKey(keyStream, GetAbsoluteZoneDirectory(zonePath));
+            for (const auto& searchPath : m_args.m_user_search_paths)
+                AddObjFolderToDumpKey(keyStream, searchPath);
+        }
+
+        const auto keyData = keyStream.str();
+        key = DumpManifest::ComputeHash(keyData.data(), keyData.size());
+        return true;
+    }
+
+    /**
+     * \brief Checks whether the zone was dumped before with the same key and all of its dumped files are still as they were dumped.
+     */
+    bool IsDumpUpToDate(const std::string& zonePath, const std::string& dumpKey) const
+    {
+        const auto zoneName = fs::path(zonePath).filename().replace_extension().string();
+        const auto outputFolderPath = m_args.GetOutputFolderPathForZone(zoneName);
+
+        const auto manifest = DumpManifest::Read(GetManifestPath(outputFolderPath, zoneName));
+
+        return manifest && manifest->m_key == dumpKey && manifest->FilesAreUnchanged(outputFolderPath);
+    }
+
+    /**
+     * \brief Loads, handles and unloads a single zone.
+     * \param zonePath The path to the zone file.
+     * \param searchPathsForZone The search paths for obj data of the zone.
+     * \param blockAllocationCallback Is called with the memory the zone needs before it is allocated. May be empty.
+     * \return \c true if unlinking the zone was successful, otherwise \c false.
+     */
+    bool UnlinkZone(const std::string& zonePath, SearchPaths& searchPathsForZone, const std::function<void(uint64_t)>& blockAllocationCallback) const
+    {
+        std::string dumpKey;
+        if (m_args.m_incremental && m_args.m_task == UnlinkerArgs::ProcessingTask::DUMP && ComputeDumpKey(zonePath, dumpKey)
+            && IsDumpUpToDate(zonePath, dumpKey))
+        {
+            if (m_args.m_verbose)
+                std::cout << std::format("Skipping unchanged zone \"{}\"\n", zonePath);
+
+            return true;
+        }
+
+        std::string zoneName;
+        auto zone = ZoneLoading::LoadZone(zonePath, blockAllocationCallback);
+        if (zone == nullptr)
+        {
+            std::cerr << std::format("Failed to load zone \"{}\".\n", zonePath);
+            return false;
+        }
+
+        zoneName = zone->m_name;
+        if (m_args.m_verbose)
+            std::cout << std::format("Loaded zone \"{}\"\n", zoneName);
+
+        const auto* objLoader = IObjLoader::GetObjLoaderForGame(zone->m_game->GetId());
+        if (ShouldLoadObj())
+            objLoader->LoadReferencedContainersForZone(searchPathsForZone, *zone);
+
+        if (!HandleZone(searchPathsForZone, *zone, dumpKey))
+            return false;
+
+        if (ShouldLoadObj())
+            objLoader->UnloadContainersOfZone(*zone);
+
+        zone.reset();
+        if (m_args.m_verbose)
+            std::cout << std::format("Unloaded zone \"{}\"\n", zoneName);
+
+        return true;
+    }
+
+    /**
+     * \brief Limits the combined size of the XBlocks of zones that are unlinked at the same time.
+     * Zones are let in in the order they asked for their memory, so a large zone cannot be overtaken by smaller ones forever.
+     */
+    class MemoryBudget
+    {
+    public:
+        explicit MemoryBudget(const uint64_t budget)
+            : m_budget(budget),
+              m_in_use(0u),
+              m_next_ticket(0u),
+              m_serving_ticket(0u)
+        {
+        }
+
+        /**
+         * \brief Waits until the specified amount fits into the budget and all earlier requests were served, then reserves it.
+         * When nothing else is reserved, any amount fits so zones larger than the budget can still be unlinked on their own.
+         */
+        void Acquire(const uint64_t amount)
+        {
+            std::unique_lock lock(m_mutex);
+            const auto ticket = m_next_ticket++;
+            m_changed.wait(lock,
+                           [this, amount, ticket]
+                           {
+                               return ticket == m_serving_ticket && (m_budget == 0u || m_in_use == 0u || m_in_use + amount <= m_budget);
+                           });
+            m_in_use += amount;
+            m_serving_ticket++;
+            lock.unlock();
+
+            m_changed.notify_all();
+        }
+
+        void Release(const uint64_t amount)
+        {
+            {
+                std::lock_guard lock(m_mutex);
+                m_in_use -= amount;
             }
+            m_changed.notify_all();
+        }
 
-            auto zoneDirectory = fs::path(zonePath).remove_filename();
-            if (zoneDirectory.empty())
-                zoneDirectory = fs::current_path();
-            auto absoluteZoneDirectory = absolute(zoneDirectory).string();
+    private:
+        uint64_t m_budget;
+        uint64_t m_in_use;
+        uint64_t m_next_ticket;
+        uint64_t m_serving_ticket;
+        std::mutex m_mutex;
+        std::condition_variable m_changed;
+    };
 
-            auto searchPathsForZone = GetSearchPathsForZone(absoluteZoneDirectory);
-            searchPathsForZone.IncludeSearchPath(&m_search_paths);
+    /**
+     * \brief Loads the search paths of the directories of all zones to unlink up front.
+     * They stay loaded until all zones are unlinked, so that zones that are unlinked at the same time can share them without modifying them.
+     */
+    void LoadZoneDirectorySearchPaths(const std::vector<std::string>& zonePaths)
+    {
+        for (const auto& zonePath : zonePaths)
+        {
+            auto absoluteZoneDirectory = GetAbsoluteZoneDirectory(zonePath);
+            if (m_absolute_search_paths.contains(absoluteZoneDirectory) || m_zone_directory_search_paths.contains(absoluteZoneDirectory))
+                continue;
 
-            std::string zoneName;
-            auto zone = ZoneLoading::LoadZone(zonePath);
-            if (zone == nullptr)
+            auto searchPath = std::make_unique<SearchPathFilesystem>(absoluteZoneDirectory);
+            LoadSearchPath(*searchPath);
+            m_zone_directory_search_paths.emplace(std::move(absoluteZoneDirectory), std::move(searchPath));
+        }
+    }
+
+    void UnloadZoneDirectorySearchPaths()
+    {
+        for (auto& [_, searchPath] : m_zone_directory_search_paths)
+            UnloadSearchPath(*searchPath);
+
+        m_zone_directory_search_paths.clear();
+    }
+
+    /**
+     * \brief Unlinks zones at the same time with as many threads as jobs were specified.
+     * The output of each zone is collected and printed in the order of the zones once it is finished.
+     */
+    bool UnlinkZonesConcurrently(const std::vector<std::string>& zonePaths)
+    {
+        class ZoneJob
+        {
+        public:
+            OutputCapture m_output;
+            std::promise<bool> m_result;
+        };
+
+        LoadZoneDirectorySearchPaths(zonePaths);
+
+        std::vector<ZoneJob> jobs(zonePaths.size());
+        std::atomic_bool failed = false;
+        MemoryBudget memoryBudget(m_args.m_memory_budget);
+
+        // Like when unlinking sequentially, each zone only sees the IWDs of the user search paths and of its own directory.
+        // IWDs are neither loaded nor unloaded while the jobs run, so they are collected up front.
+        SearchPaths userSearchPathIwds;
+        for (auto* searchPath : m_search_paths)
+        {
+            for (auto* iwd : IWD::Repository.GetContainersReferencedBy(searchPath))
+                userSearchPathIwds.IncludeSearchPath(iwd);
+        }
+
+        std::unordered_map<std::string, SearchPaths> zoneDirectoryIwds;
+        for (const auto& [absoluteZoneDirectory, searchPath] : m_zone_directory_search_paths)
+            zoneDirectoryIwds.emplace(absoluteZoneDirectory, ObjLoading::GetIWDSearchPaths(*searchPath));
+
+        std::vector<std::future<bool>> results;
+        results.reserve(jobs.size());
+
+        {
+            // Destroying the pool waits for all started jobs, so it must be destroyed before anything they use
+            ThreadPool pool(m_args.m_jobs);
+            for (auto i = 0u; i < zonePaths.size(); i++)
             {
-                std::cerr << std::format("Failed to load zone \"{}\".\n", zonePath);
-                return false;
+                results.emplace_back(jobs[i].m_result.get_future());
+                pool.Submit(
+                    [this, &zonePath = zonePaths[i], &job = jobs[i], &failed, &memoryBudget, &userSearchPathIwds, &zoneDirectoryIwds]
+                    {
+                        // Like unlinking sequentially, no new zones are started after one failed
+                        if (failed)
+                        {
+                            job.m_result.set_value(false);
+                            return;
+                        }
+
+                        try
+                        {
+                            bool result;
+                            {
+                                const OutputCapture::Activation activation(job.m_output);
+
+                                // Zones that are unlinked at the same time must not be able to see each other
+                                const GlobalAssetPoolIsolation isolation;
+
+                                const auto absoluteZoneDirectory = GetAbsoluteZoneDirectory(zonePath);
+
+                                SearchPaths searchPathsForZone;
+                                const auto zoneDirectorySearchPath = m_zone_directory_search_paths.find(absoluteZoneDirectory);
+                                if (zoneDirectorySearchPath != m_zone_directory_search_paths.end())
+                                    searchPathsForZone.IncludeSearchPath(zoneDirectorySearchPath->second.get());
+                                searchPathsForZone.IncludeSearchPath(&userSearchPathIwds);
+                                const auto zoneDirectoryIwdSearchPaths = zoneDirectoryIwds.find(absoluteZoneDirectory);
+                                if (zoneDirectoryIwdSearchPaths != zoneDirectoryIwds.end())
+                                    searchPathsForZone.IncludeSearchPath(&zoneDirectoryIwdSearchPaths->second);
+                                searchPathsForZone.IncludeSearchPath(&m_search_paths);
+
+                                // The memory of a zone is charged once its XBlock sizes are known, right before it is allocated
+                                uint64_t reservedMemory = 0u;
+                                const auto reserveMemory = [&memoryBudget, &reservedMemory](const uint64_t totalBlockSize)
+                                {
+                                    memoryBudget.Acquire(totalBlockSize);
+                                    reservedMemory = totalBlockSize;
+                                };
+
+                                try
+                                {
+                                    result = UnlinkZone(zonePath, searchPathsForZone, reserveMemory);
+                                }
+                                catch (...)
+                                {
+                                    memoryBudget.Release(reservedMemory);
+                                    throw;
+                                }
+                                memoryBudget.Release(reservedMemory);
+                            }
+
+                            if (!result)
+                                failed = true;
+                            job.m_result.set_value(result);
+                        }
+                        catch (...)
+                        {
+                            failed = true;
+                            job.m_result.set_exception(std::current_exception());
+                        }
+                    });
             }
 
-            zoneName = zone->m_name;
-            if (m_args.m_verbose)
-                std::cout << std::format("Loaded zone \"{}\"\n", zoneName);
+            for (auto i = 0u; i < jobs.size(); i++)
+            {
+                results[i].wait();
+                jobs[i].m_output.Print();
+            }
+        }
 
-            const auto* objLoader = IObjLoader::GetObjLoaderForGame(zone->m_game->GetId());
-            if (ShouldLoadObj())
-                objLoader->LoadReferencedContainersForZone(searchPathsForZone, *zone);
+        UnloadZoneDirectorySearchPaths();
 
-            if (!HandleZone(searchPathsForZone, *zone))
-                return false;
+        auto result = true;
+        for (auto& jobResult : results)
+        {
+            if (!jobResult.get())
+                result = false;
+        }
 
-            if (ShouldLoadObj())
-                objLoader->UnloadContainersOfZone(*zone);
+        return result;
+    }
 
-            zone.reset();
-            if (m_args.m_verbose)
-                std::cout << std::format("Unloaded zone \"{}\"\n", zoneName);
+    bool UnlinkZones()
+    {
+        std::vector<std::string> zonePaths;
+        for (const auto& zonePath : m_args.m_zones_to_unlink)
+        {
+            if (!fs::is_regular_file(zonePath))
+            {
+                std::cerr << std::format("Could not find file \"{}\".\n", zonePath);
+                continue;
+            }
+
+            zonePaths.emplace_back(zonePath);
+        }
+
+        if (m_args.m_jobs > 1 && zonePaths.size() > 1)
+            return UnlinkZonesConcurrently(zonePaths);
+
+        for (const auto& zonePath : zonePaths)
+        {
+            auto searchPathsForZone = GetSearchPathsForZone(GetAbsoluteZoneDirectory(zonePath));
+            searchPathsForZone.IncludeSearchPath(&m_search_paths);
+
+            if (!UnlinkZone(zonePath, searchPathsForZone, nullptr))
+                return false;
         }
 
         return true;
@@ -423,7 +848,12 @@ private:
     std::unique_ptr<SearchPathFilesystem> m_last_zone_search_path;
     std::set<std::string> m_absolute_search_paths;
 
+    std::unordered_map<std::string, std::unique_ptr<SearchPathFilesystem>> m_zone_directory_search_paths;
+
     std::vector<std::unique_ptr<Zone>> m_loaded_zones;
+    std::string m_loaded_zones_key;
+    std::unique_ptr<ThreadPool> m_dump_thread_pool;
+    mutable std::mutex m_asset_types_to_handle_mutex;
 };
 
 Unlinker::Unlinker()
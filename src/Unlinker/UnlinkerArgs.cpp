@@ -6,7 +6,9 @@
 #include "Utils/Arguments/UsageInformation.h"
 #include "Utils/FileUtils.h"
 #include "Utils/StringUtils.h"
+#include "ZoneLoading.h"
 
+#include <charconv>
 #include <format>
 #include <iostream>
 #include <regex>
@@ -119,6 +121,78 @@ const CommandLineOption* const OPTION_LEGACY_MENUS =
     .WithDescription("Dumps menus with a compatibility mode to work with applications not compatible with the newer dumping mode.")
     .Build();
 
+const CommandLineOption* const OPTION_THREADS =
+    CommandLineOption::Builder::Create()
+    .WithLongName("threads")
+    .WithDescription("Dumps the assets of each asset type on the specified amount of threads. Defaults to 1.")
+    .WithParameter("threadCount")
+    .Build();
+
+const CommandLineOption* const OPTION_JOBS =
+    CommandLineOption::Builder::Create()
+    .WithShortName("j")
+    .WithLongName("jobs")
+    .WithDescription("Unlinks up to the specified amount of zones at the same time. Each zone stays in memory until it is dumped. Defaults to 1.")
+    .WithParameter("jobCount")
+    .Build();
+
+const CommandLineOption* const OPTION_MEMORY_BUDGET =
+    CommandLineOption::Builder::Create()
+    .WithLongName("memory-budget")
+    .WithDescription("Only loads another zone while the memory of the zones being unlinked takes up less than the specified amount of megabytes. "
+                     "A zone that is larger than the budget is unlinked on its own. Only has an effect with more than one job.")
+    .WithParameter("megabytes")
+    .Build();
+
+const CommandLineOption* const OPTION_WRITE_BUFFER_SIZE =
+    CommandLineOption::Builder::Create()
+    .WithLongName("write-buffer-size")
+    .WithDescription("Specifies the size of the write buffer of each dumped file in kilobytes. Defaults to 64.")
+    .WithParameter("kilobytes")
+    .Build();
+
+const CommandLineOption* const OPTION_ASYNC_WRITE =
+    CommandLineOption::Builder::Create()
+    .WithLongName("async-write")
+    .WithDescription("Writes dumped files on a separate thread while further assets are dumped.")
+    .Build();
+
+const CommandLineOption* const OPTION_ARCHIVE =
+    CommandLineOption::Builder::Create()
+    .WithLongName("archive")
+    .WithDescription("Dumps the files of each zone into a single archive next to its output folder instead of writing loose files. "
+                     "The output folder must contain ?zone? when dumping multiple zones. "
+                     "Valid values are: IWD, ZIP, TAR")
+    .WithParameter("archiveFormat")
+    .Build();
+
+const CommandLineOption* const OPTION_INCREMENTAL =
+    CommandLineOption::Builder::Create()
+    .WithLongName("incremental")
+    .WithDescription("Leaves dumped files untouched when their content did not change and skips zones that did not change since they were last dumped "
+                     "with the same options. Cannot be combined with --archive.")
+    .Build();
+
+const CommandLineOption* const OPTION_ZONE_CACHE =
+    CommandLineOption::Builder::Create()
+    .WithLongName("zone-cache")
+    .WithDescription("Caches decrypted and decompressed zone data in the specified folder to speed up loading the same zones again.")
+    .WithParameter("cacheFolderPath")
+    .Build();
+
+const CommandLineOption* const OPTION_PROFILE =
+    CommandLineOption::Builder::Create()
+    .WithLongName("profile")
+    .WithDescription("Prints where the time of loading each zone was spent.")
+    .Build();
+
+const CommandLineOption* const OPTION_PROFILE_JSON =
+    CommandLineOption::Builder::Create()
+    .WithLongName("profile-json")
+    .WithDescription("Appends a JSON report of where the time of loading each zone was spent to the specified file, one zone per line.")
+    .WithParameter("profileFilePath")
+    .Build();
+
 // clang-format on
 
 const CommandLineOption* const COMMAND_LINE_OPTIONS[]{
@@ -137,8 +211,41 @@ const CommandLineOption* const COMMAND_LINE_OPTIONS[]{
     OPTION_EXCLUDE_ASSETS,
     OPTION_INCLUDE_ASSETS,
     OPTION_LEGACY_MENUS,
+    OPTION_THREADS,
+    OPTION_JOBS,
+    OPTION_MEMORY_BUDGET,
+    OPTION_WRITE_BUFFER_SIZE,
+    OPTION_ASYNC_WRITE,
+    OPTION_ARCHIVE,
+    OPTION_INCREMENTAL,
+    OPTION_ZONE_CACHE,
+    OPTION_PROFILE,
+    OPTION_PROFILE_JSON,
 };
 
+namespace
+{
+    /**
+     * \brief Parses the value of a command line option that must be a number greater than 0 and prints an error if it is not.
+     * \param value The value of the option.
+     * \param valueName A description of the value to print in the error, i.e. "thread count".
+     * \param out Receives the parsed number.
+     * \return \c true if the value is a number greater than 0, otherwise \c false.
+     */
+    template<typename T> bool ParsePositiveNumber(const std::string& value, const std::string& valueName, T& out)
+    {
+        const auto* valueEnd = value.data() + value.size();
+        const auto [parseEnd, error] = std::from_chars(value.data(), valueEnd, out);
+        if (error != std::errc() || parseEnd != valueEnd || out == 0)
+        {
+            std::cerr << std::format("Invalid {} \"{}\". Must be a number greater than 0.\n", valueName, value);
+            return false;
+        }
+
+        return true;
+    }
+} // namespace
+
 UnlinkerArgs::UnlinkerArgs()
     : m_argument_parser(COMMAND_LINE_OPTIONS, std::extent_v<decltype(COMMAND_LINE_OPTIONS)>),
       m_zone_pattern(R"(\?zone\?)"),
@@ -147,7 +254,14 @@ UnlinkerArgs::UnlinkerArgs()
       m_asset_type_handling(AssetTypeHandling::EXCLUDE),
       m_skip_obj(false),
       m_use_gdt(false),
-      m_verbose(false)
+      m_verbose(false),
+      m_thread_count(1u),
+      m_jobs(1u),
+      m_memory_budget(0u),
+      m_write_buffer_size(AssetFileOutput::DEFAULT_WRITE_BUFFER_SIZE),
+      m_async_write(false),
+      m_archive_format(ArchiveFormat::NONE),
+      m_incremental(false)
 {
 }
 
@@ -176,6 +290,7 @@ void UnlinkerArgs::SetVerbose(const bool isVerbose)
     m_verbose = isVerbose;
     ObjLoading::Configuration.Verbose = isVerbose;
     ObjWriting::Configuration.Verbose = isVerbose;
+    ZoneLoading::Configuration.Verbose = isVerbose;
 }
 
 bool UnlinkerArgs::SetImageDumpingMode()
@@ -234,6 +349,34 @@ bool UnlinkerArgs::SetModelDumpingMode()
     return false;
 }
 
+bool UnlinkerArgs::SetArchiveFormat()
+{
+    auto specifiedValue = m_argument_parser.GetValueForOption(OPTION_ARCHIVE);
+    utils::MakeStringLowerCase(specifiedValue);
+
+    if (specifiedValue == "iwd")
+    {
+        m_archive_format = ArchiveFormat::IWD;
+        return true;
+    }
+
+    if (specifiedValue == "zip")
+    {
+        m_archive_format = ArchiveFormat::ZIP;
+        return true;
+    }
+
+    if (specifiedValue == "tar")
+    {
+        m_archive_format = ArchiveFormat::TAR;
+        return true;
+    }
+
+    const std::string originalValue = m_argument_parser.GetValueForOption(OPTION_ARCHIVE);
+    printf("Illegal value: \"%s\" is not a valid archive format. Use -? to see usage information.\n", originalValue.c_str());
+    return false;
+}
+
 void UnlinkerArgs::AddSpecifiedAssetType(std::string value)
 {
     const auto alreadySpecifiedAssetType = m_specified_asset_type_map.find(value);
@@ -374,10 +517,85 @@ bool UnlinkerArgs::ParseArgs(const int argc, const char** argv, bool& shouldCont
     if (m_argument_parser.IsOptionSpecified(OPTION_LEGACY_MENUS))
         ObjWriting::Configuration.MenuLegacyMode = true;
 
+    // --threads
+    if (m_argument_parser.IsOptionSpecified(OPTION_THREADS))
+    {
+        if (!ParsePositiveNumber(m_argument_parser.GetValueForOption(OPTION_THREADS), "thread count", m_thread_count))
+            return false;
+    }
+
+    // -j; --jobs
+    if (m_argument_parser.IsOptionSpecified(OPTION_JOBS))
+    {
+        if (!ParsePositiveNumber(m_argument_parser.GetValueForOption(OPTION_JOBS), "job count", m_jobs))
+            return false;
+    }
+
+    // --memory-budget
+    if (m_argument_parser.IsOptionSpecified(OPTION_MEMORY_BUDGET))
+    {
+        uint64_t budgetMegabytes;
+        if (!ParsePositiveNumber(m_argument_parser.GetValueForOption(OPTION_MEMORY_BUDGET), "memory budget in megabytes", budgetMegabytes))
+            return false;
+
+        m_memory_budget = budgetMegabytes * 1024u * 1024u;
+    }
+
+    // --write-buffer-size
+    if (m_argument_parser.IsOptionSpecified(OPTION_WRITE_BUFFER_SIZE))
+    {
+        size_t bufferSizeKilobytes;
+        if (!ParsePositiveNumber(m_argument_parser.GetValueForOption(OPTION_WRITE_BUFFER_SIZE), "write buffer size in kilobytes", bufferSizeKilobytes))
+            return false;
+
+        m_write_buffer_size = bufferSizeKilobytes * 1024u;
+    }
+
+    // --async-write
+    m_async_write = m_argument_parser.IsOptionSpecified(OPTION_ASYNC_WRITE);
+
+    // --archive
+    if (m_argument_parser.IsOptionSpecified(OPTION_ARCHIVE))
+    {
+        if (!SetArchiveFormat())
+            return false;
+
+        // The archive is named after the output folder, so every zone needs its own folder to not overwrite the archive of another zone
+        if (zoneCount > 1 && !std::regex_search(m_output_folder, m_zone_pattern))
+        {
+            std::cerr << "Dumping multiple zones into archives requires the output folder to contain \"?zone?\".\n";
+            return false;
+        }
+    }
+
+    // --incremental
+    m_incremental = m_argument_parser.IsOptionSpecified(OPTION_INCREMENTAL);
+    if (m_incremental && m_archive_format != ArchiveFormat::NONE)
+    {
+        std::cerr << "Incremental dumping cannot be combined with dumping into an archive.\n";
+        return false;
+    }
+
+    // --zone-cache
+    if (m_argument_parser.IsOptionSpecified(OPTION_ZONE_CACHE))
+        ZoneLoading::Configuration.CacheDirectory = m_argument_parser.GetValueForOption(OPTION_ZONE_CACHE);
+
+    // --profile
+    ZoneLoading::Configuration.Profile = m_argument_parser.IsOptionSpecified(OPTION_PROFILE);
+
+    // --profile-json
+    if (m_argument_parser.IsOptionSpecified(OPTION_PROFILE_JSON))
+        ZoneLoading::Configuration.ProfileJsonPath = m_argument_parser.GetValueForOption(OPTION_PROFILE_JSON);
+
     return true;
 }
 
 std::string UnlinkerArgs::GetOutputFolderPathForZone(const Zone& zone) const
 {
-    return std::regex_replace(m_output_folder, m_zone_pattern, zone.m_name);
+    return GetOutputFolderPathForZone(zone.m_name);
+}
+
+std::string UnlinkerArgs::GetOutputFolderPathForZone(const std::string& zoneName) const
+{
+    return std::regex_replace(m_output_folder, m_zone_pattern, zoneName);
 }
@@ -2,6 +2,7 @@
 #include "Utils/Arguments/ArgumentParser.h"
 #include "Zone/Zone.h"
 
+#include <cstdint>
 #include <regex>
 #include <set>
 #include <string>
@@ -26,6 +27,7 @@ private:
     void SetVerbose(bool isVerbose);
     bool SetImageDumpingMode();
     bool SetModelDumpingMode();
+    bool SetArchiveFormat();
 
     void AddSpecifiedAssetType(std::string value);
     void ParseCommaSeparatedAssetTypeString(const std::string& input);
@@ -43,6 +45,14 @@ public:
         INCLUDE
     };
 
+    enum class ArchiveFormat
+    {
+        NONE,
+        IWD,
+        ZIP,
+        TAR
+    };
+
     std::vector<std::string> m_zones_to_load;
     std::vector<std::string> m_zones_to_unlink;
     std::set<std::string> m_user_search_paths;
@@ -59,6 +69,18 @@ public:
     bool m_use_gdt;
 
     bool m_verbose;
+    unsigned m_thread_count;
+    unsigned m_jobs;
+
+    /**
+     * \brief The maximum combined size in bytes of the loaded data of zones that are unlinked at the same time. \c 0 means there is no limit.
+     */
+    uint64_t m_memory_budget;
+
+    size_t m_write_buffer_size;
+    bool m_async_write;
+    ArchiveFormat m_archive_format;
+    bool m_incremental;
 
     UnlinkerArgs();
     bool ParseArgs(int argc, const char** argv, bool& shouldContinue);
@@ -69,4 +91,11 @@ public:
      * \return An output path for the zone based on the user input.
      */
     std::string GetOutputFolderPathForZone(const Zone& zone) const;
+
+    /**
+     * \brief Converts the output path specified by command line arguments to a path applies for the zone with the specified name.
+     * \param zoneName The name of the zone to resolve the path input for.
+     * \return An output path for the zone based on the user input.
+     */
+    std::string GetOutputFolderPathForZone(const std::string& zoneName) const;
 };
@@ -0,0 +1,113 @@
+#include "OutputCapture.h"
+
+#include <iostream>
+#include <mutex>
+
+namespace
+{
+    thread_local OutputCapture* activeCapture = nullptr;
+
+    // Serializes writes of threads that print directly while others are capturing
+    std::mutex outputMutex;
+} // namespace
+
+class OutputCapture::StreamBuffer final : public std::streambuf
+{
+public:
+    StreamBuffer(std::streambuf* target, const bool error)
+        : m_target(target),
+          m_error(error)
+    {
+    }
+
+protected:
+    int_type overflow(const int_type c) override
+    {
+        if (traits_type::eq_int_type(c, traits_type::eof()))
+            return traits_type::not_eof(c);
+
+        const auto ch = traits_type::to_char_type(c);
+        return xsputn(&ch, 1) == 1 ? c : traits_type::eof();
+    }
+
+    std::streamsize xsputn(const char* s, const std::streamsize count) override
+    {
+        if (activeCapture)
+        {
+            activeCapture->Append(m_error, s, static_cast<size_t>(count));
+            return count;
+        }
+
+        std::lock_guard lock(outputMutex);
+        return m_target->sputn(s, count);
+    }
+
+    int sync() override
+    {
+        if (activeCapture)
+            return 0;
+
+        std::lock_guard lock(outputMutex);
+        return m_target->pubsync();
+    }
+
+private:
+    std::streambuf* m_target;
+    bool m_error;
+};
+
+OutputCapture::Redirection::Redirection()
+    : m_previous_out_buffer(std::cout.rdbuf()),
+      m_previous_err_buffer(std::cerr.rdbuf())
+{
+    // Redirecting again would make the new buffers write into the existing ones, which lock the same mutex
+    if (dynamic_cast<StreamBuffer*>(m_previous_out_buffer) != nullptr)
+        return;
+
+    m_out_buffer = std::make_unique<StreamBuffer>(m_previous_out_buffer, false);
+    m_err_buffer = std::make_unique<StreamBuffer>(m_previous_err_buffer, true);
+
+    std::cout.flush();
+    std::cout.rdbuf(m_out_buffer.get());
+    std::cerr.rdbuf(m_err_buffer.get());
+}
+
+OutputCapture::Redirection::~Redirection()
+{
+    if (!m_out_buffer)
+        return;
+
+    std::cout.rdbuf(m_previous_out_buffer);
+    std::cerr.rdbuf(m_previous_err_buffer);
+}
+
+OutputCapture::Activation::Activation(OutputCapture& capture)
+    : m_previous(activeCapture)
+{
+    activeCapture = &capture;
+}
+
+OutputCapture::Activation::~Activation()
+{
+    activeCapture = m_previous;
+}
+
+void OutputCapture::Print() const
+{
+    for (const auto& chunk : m_chunks)
+    {
+        auto& stream = chunk.m_error ? std::cerr : std::cout;
+        stream.write(chunk.m_text.data(), static_cast<std::streamsize>(chunk.m_text.size()));
+    }
+
+    std::cout.flush();
+}
+
+void OutputCapture::Append(const bool error, const char* data, const size_t size)
+{
+    // Consecutive writes to the same stream are merged to keep the amount of chunks low
+    if (!m_chunks.empty() && m_chunks.back().m_error == error)
+        m_chunks.back().m_text.append(data, size);
+    else
+        m_chunks.emplace_back(Chunk{error, std::string(data, size)});
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Collects what a thread writes to std::cout and std::cerr instead of printing it right away.
+ * Allows running tasks that print concurrently and showing their output in a deterministic order afterwards.
+ */
+class OutputCapture
+{
+    class StreamBuffer;
+
+public:
+    /**
+     * \brief Routes std::cout and std::cerr through the active capture of the writing thread while it is alive.
+     * Threads without an active capture keep printing directly. Output is only captured while a redirection exists.
+     * Creating a redirection while another one exists does nothing.
+     */
+    class Redirection
+    {
+        std::unique_ptr<StreamBuffer> m_out_buffer;
+        std::unique_ptr<StreamBuffer> m_err_buffer;
+        std::streambuf* m_previous_out_buffer;
+        std::streambuf* m_previous_err_buffer;
+
+    public:
+        Redirection();
+        ~Redirection();
+        Redirection(const Redirection& other) = delete;
+        Redirection(Redirection&& other) noexcept = delete;
+        Redirection& operator=(const Redirection& other) = delete;
+        Redirection& operator=(Redirection&& other) noexcept = delete;
+    };
+
+    /**
+     * \brief Makes a capture the active capture of the current thread while it is alive.
+     */
+    class Activation
+    {
+        OutputCapture* m_previous;
+
+    public:
+        explicit Activation(OutputCapture& capture);
+        ~Activation();
+        Activation(const Activation& other) = delete;
+        Activation(Activation&& other) noexcept = delete;
+        Activation& operator=(const Activation& other) = delete;
+        Activation& operator=(Activation&& other) noexcept = delete;
+    };
+
+    /**
+     * \brief Prints the captured output to the streams it was written to, in the order it was written.
+     */
+    void Print() const;
+
+private:
+    class Chunk
+    {
+    public:
+        bool m_error;
+        std::string m_text;
+    };
+
+    void Append(bool error, const char* data, size_t size);
+
+    std::vector<Chunk> m_chunks;
+};
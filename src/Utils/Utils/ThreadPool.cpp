@@ -0,0 +1,73 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cassert>
+
+ThreadPool::ThreadPool(const unsigned threadCount)
+    : m_stopping(false)
+{
+    const auto actualThreadCount = std::max(threadCount, 1u);
+
+    m_workers.reserve(actualThreadCount);
+    for (auto i = 0u; i < actualThreadCount; i++)
+        m_workers.emplace_back(&ThreadPool::WorkerMain, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_task_available.notify_all();
+
+    for (auto& worker : m_workers)
+        worker.join();
+}
+
+void ThreadPool::Submit(task_t task)
+{
+    assert(task);
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_tasks.emplace(std::move(task));
+    }
+    m_task_available.notify_one();
+}
+
+unsigned ThreadPool::ThreadCount() const
+{
+    return static_cast<unsigned>(m_workers.size());
+}
+
+ThreadPool& ThreadPool::Default()
+{
+    static ThreadPool defaultPool(std::thread::hardware_concurrency());
+    return defaultPool;
+}
+
+void ThreadPool::WorkerMain()
+{
+    while (true)
+    {
+        task_t task;
+
+        {
+            std::unique_lock lock(m_mutex);
+            m_task_available.wait(lock,
+                                  [this]
+                                  {
+                                      return m_stopping || !m_tasks.empty();
+                                  });
+
+            if (m_tasks.empty())
+                return;
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop();
+        }
+
+        task();
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+    using task_t = std::function<void()>;
+
+    explicit ThreadPool(unsigned threadCount);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool& other) = delete;
+    ThreadPool(ThreadPool&& other) noexcept = delete;
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+    ThreadPool& operator=(ThreadPool&& other) noexcept = delete;
+
+    /**
+     * \brief Queues a task to be executed on one of the worker threads of the pool.
+     * \param task The task to execute. Tasks must not throw.
+     */
+    void Submit(task_t task);
+
+    [[nodiscard]] unsigned ThreadCount() const;
+
+    /**
+     * \brief Returns a process-wide pool with one worker per hardware thread.
+     * The pool is created on first use and lives until the process exits.
+     */
+    static ThreadPool& Default();
+
+private:
+    void WorkerMain();
+
+    std::vector<std::thread> m_workers;
+    std::queue<task_t> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_task_available;
+    bool m_stopping;
+};
@@ -0,0 +1,47 @@
+#include "TypeName.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+namespace
+{
+    std::string DemangleTypeName(const char* name)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        auto status = 0;
+        auto* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+        if (status == 0 && demangled)
+        {
+            std::string result(demangled);
+            std::free(demangled);
+            return result;
+        }
+
+        return name;
+#else
+        std::string result(name);
+        for (const auto* prefix : {"class ", "struct "})
+        {
+            if (result.starts_with(prefix))
+                return result.substr(std::char_traits<char>::length(prefix));
+        }
+
+        return result;
+#endif
+    }
+} // namespace
+
+namespace utils
+{
+    std::string GetTypeName(const std::type_info& type)
+    {
+        return DemangleTypeName(type.name());
+    }
+
+    std::string GetTypeName(const std::type_index type)
+    {
+        return DemangleTypeName(type.name());
+    }
+} // namespace utils
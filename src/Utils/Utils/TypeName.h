@@ -0,0 +1,14 @@
+#pragma once
+
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+
+namespace utils
+{
+    /**
+     * \brief Returns the readable name of a type without the decoration of the compiler.
+     */
+    std::string GetTypeName(const std::type_info& type);
+    std::string GetTypeName(std::type_index type);
+} // namespace utils
@@ -19,6 +19,7 @@ public:
     bool m_is_script_string;
     bool m_is_reusable;
     bool m_is_leaf;
+    bool m_is_flat;
     std::unique_ptr<IEvaluation> m_condition;
     std::unique_ptr<IEvaluation> m_alloc_alignment;
     std::unique_ptr<CustomAction> m_post_load_action;
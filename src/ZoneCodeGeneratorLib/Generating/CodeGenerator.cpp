@@ -6,6 +6,7 @@
 #include "Templates/ZoneMarkTemplate.h"
 #include "Templates/ZoneWriteTemplate.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -79,6 +80,39 @@ bool CodeGenerator::GetAssetWithName(IDataRepository* repository, const std::str
     return true;
 }
 
+void CodeGenerator::PrintFlatTypesReport(IDataRepository* repository)
+{
+    std::vector<const StructureInformation*> flatTypes;
+    auto nonFlatTypeCount = 0u;
+
+    for (const auto* info : repository->GetAllStructureInformation())
+    {
+        if (info->m_definition->m_anonymous || StructureComputations(info).IsAsset())
+            continue;
+
+        if (info->m_is_flat)
+            flatTypes.push_back(info);
+        else
+            nonFlatTypeCount++;
+    }
+
+    std::ranges::sort(flatTypes,
+                      [](const StructureInformation* i1, const StructureInformation* i2)
+                      {
+                          return i1->m_definition->GetFullName() < i2->m_definition->GetFullName();
+                      });
+
+    std::cout << flatTypes.size() << " types are loaded in bulk without processing each element, " << nonFlatTypeCount
+              << " types need to be processed per element:\n";
+    for (const auto* info : flatTypes)
+    {
+        std::cout << "  " << info->m_definition->GetFullName();
+        if (!info->m_is_leaf)
+            std::cout << " (contains script strings that are resolved when marking)";
+        std::cout << "\n";
+    }
+}
+
 bool CodeGenerator::GenerateCode(IDataRepository* repository)
 {
     std::vector<StructureInformation*> assets;
@@ -90,6 +124,9 @@ bool CodeGenerator::GenerateCode(IDataRepository* repository)
             assets.push_back(info);
     }
 
+    if (m_args->m_verbose)
+        PrintFlatTypesReport(repository);
+
     const auto start = std::chrono::steady_clock::now();
     for (const auto& generationTask : m_args->m_generation_tasks)
     {
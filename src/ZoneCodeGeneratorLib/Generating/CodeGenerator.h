@@ -15,6 +15,7 @@ class CodeGenerator
 
     bool GenerateCodeForTemplate(RenderingContext* context, ICodeTemplate* codeTemplate) const;
     static bool GetAssetWithName(IDataRepository* repository, const std::string& name, StructureInformation*& asset);
+    static void PrintFlatTypesReport(IDataRepository* repository);
 
 public:
     explicit CodeGenerator(const ZoneCodeGeneratorArguments* args);
@@ -121,7 +121,7 @@ class ZoneLoadTemplate::Internal final : BaseTemplate
 
         for (auto* type : m_env.m_used_types)
         {
-            if (type->m_info && !type->m_info->m_definition->m_anonymous && !type->m_info->m_is_leaf && !StructureComputations(type->m_info).IsAsset())
+            if (type->m_info && !type->m_info->m_definition->m_anonymous && !type->m_info->m_is_flat && !StructureComputations(type->m_info).IsAsset())
             {
                 PrintVariableInitialization(type->m_type);
             }
@@ -142,7 +142,7 @@ class ZoneLoadTemplate::Internal final : BaseTemplate
     {
         LINE("*" << MakeTypePtrVarName(def) << " = m_stream->Alloc<" << def->GetFullName() << ">(" << def->GetAlignment() << ");")
 
-        if (info && !info->m_is_leaf)
+        if (info && !info->m_is_flat)
         {
             LINE(MakeTypeVarName(info->m_definition) << " = *" << MakeTypePtrVarName(def) << ";")
             LINE("Load_" << MakeSafeTypeName(def) << "(true);")
@@ -316,7 +316,7 @@ class ZoneLoadTemplate::Internal final : BaseTemplate
     void LoadMember_ArrayPointer(StructureInformation* info, MemberInformation* member, const DeclarationModifierComputations& modifier) const
     {
         const MemberComputations computations(member);
-        if (member->m_type && !member->m_type->m_is_leaf && !computations.IsInRuntimeBlock())
+        if (member->m_type && !member->m_type->m_is_flat && !computations.IsInRuntimeBlock())
         {
             LINE(MakeTypeVarName(member->m_member->m_type_declaration->m_type) << " = " << MakeMemberAccess(info, member, modifier) << ";")
             LINE("LoadArray_" << MakeSafeTypeName(member->m_member->m_type_declaration->m_type) << "(true, "
@@ -366,7 +366,7 @@ class ZoneLoadTemplate::Internal final : BaseTemplate
         else
             arraySizeStr = std::to_string(modifier.GetArraySize());
 
-        if (!member->m_is_leaf)
+        if (!member->m_is_flat)
         {
             LINE(MakeTypeVarName(member->m_member->m_type_declaration->m_type) << " = " << MakeMemberAccess(info, member, modifier) << ";")
 
@@ -401,7 +401,7 @@ class ZoneLoadTemplate::Internal final : BaseTemplate
 
     void LoadMember_DynamicArray(StructureInformation* info, MemberInformation* member, const DeclarationModifierComputations& modifier) const
     {
-        if (member->m_type && !member->m_type->m_is_leaf)
+        if (member->m_type && !member->m_type->m_is_flat)
         {
             LINE(MakeTypeVarName(member->m_member->m_type_declaration->m_type) << " = " << MakeMemberAccess(info, member, modifier) << ";")
             LINE("LoadArray_" << MakeSafeTypeName(member->m_member->m_type_declaration->m_type) << "(true, "
@@ -418,7 +418,7 @@ class ZoneLoadTemplate::Internal final : BaseTemplate
     void LoadMember_Embedded(StructureInformation* info, MemberInformation* member, const DeclarationModifierComputations& modifier) const
     {
         const MemberComputations computations(member);
-        if (!member->m_is_leaf)
+        if (!member->m_is_flat)
         {
             LINE(MakeTypeVarName(member->m_member->m_type_declaration->m_type) << " = &" << MakeMemberAccess(info, member, modifier) << ";")
 
@@ -454,7 +454,7 @@ class ZoneLoadTemplate::Internal final : BaseTemplate
     void LoadMember_SinglePointer(StructureInformation* info, MemberInformation* member, const DeclarationModifierComputations& modifier) const
     {
         const MemberComputations computations(member);
-        if (member->m_type && !member->m_type->m_is_leaf && !computations.IsInRuntimeBlock())
+        if (member->m_type && !member->m_type->m_is_flat && !computations.IsInRuntimeBlock())
         {
             LINE(MakeTypeVarName(member->m_member->m_type_declaration->m_type) << " = " << MakeMemberAccess(info, member, modifier) << ";")
             LINE("Load_" << MakeSafeTypeName(member->m_type->m_definition) << "(true);")
@@ -889,7 +889,7 @@ class ZoneLoadTemplate::Internal final : BaseTemplate
         if (computations.ShouldIgnore())
             return;
 
-        if (member->m_is_string || computations.ContainsNonEmbeddedReference() || member->m_type && !member->m_type->m_is_leaf
+        if (member->m_is_string || computations.ContainsNonEmbeddedReference() || member->m_type && !member->m_type->m_is_flat
             || computations.IsAfterPartialLoad())
         {
             if (info->m_definition->GetType() == DataDefinitionType::UNION)
@@ -1015,7 +1015,7 @@ class ZoneLoadTemplate::Internal final : BaseTemplate
 
         auto startLoadSection = true;
 
-        if (!info->m_is_leaf)
+        if (!info->m_is_flat)
         {
             if (startLoadSection)
             {
@@ -1210,7 +1210,7 @@ public:
         // Variable Declarations: type varType;
         for (auto* type : m_env.m_used_types)
         {
-            if (type->m_info && !type->m_info->m_definition->m_anonymous && !type->m_info->m_is_leaf && !StructureComputations(type->m_info).IsAsset())
+            if (type->m_info && !type->m_info->m_definition->m_anonymous && !type->m_info->m_is_flat && !StructureComputations(type->m_info).IsAsset())
             {
                 LINE(VariableDecl(type->m_type))
             }
@@ -1235,14 +1235,14 @@ public:
         }
         for (auto* type : m_env.m_used_types)
         {
-            if (type->m_array_reference_exists && type->m_info && !type->m_info->m_is_leaf && type->m_non_runtime_reference_exists)
+            if (type->m_array_reference_exists && type->m_info && !type->m_info->m_is_flat && type->m_non_runtime_reference_exists)
             {
                 PrintHeaderArrayLoadMethodDeclaration(type->m_type);
             }
         }
         for (auto* type : m_env.m_used_structures)
         {
-            if (type->m_non_runtime_reference_exists && !type->m_info->m_is_leaf && !StructureComputations(type->m_info).IsAsset())
+            if (type->m_non_runtime_reference_exists && !type->m_info->m_is_flat && !StructureComputations(type->m_info).IsAsset())
             {
                 PrintHeaderLoadMethodDeclaration(type->m_info);
             }
@@ -1300,7 +1300,7 @@ public:
         }
         for (auto* type : m_env.m_used_types)
         {
-            if (type->m_array_reference_exists && type->m_info && !type->m_info->m_is_leaf && type->m_non_runtime_reference_exists)
+            if (type->m_array_reference_exists && type->m_info && !type->m_info->m_is_flat && type->m_non_runtime_reference_exists)
             {
                 LINE("")
                 PrintLoadArrayMethod(type->m_type, type->m_info);
@@ -1308,7 +1308,7 @@ public:
         }
         for (auto* type : m_env.m_used_structures)
         {
-            if (type->m_non_runtime_reference_exists && !type->m_info->m_is_leaf && !StructureComputations(type->m_info).IsAsset())
+            if (type->m_non_runtime_reference_exists && !type->m_info->m_is_flat && !StructureComputations(type->m_info).IsAsset())
             {
                 LINE("")
                 PrintLoadMethod(type->m_info);
@@ -248,7 +248,7 @@ class ZoneWriteTemplate::Internal final : BaseTemplate
         }
         else
         {
-            LINE("m_stream->Write<" << MakeTypeDecl(member->m_member->m_type_declaration.get())
+            LINE("m_stream->WriteFinal<" << MakeTypeDecl(member->m_member->m_type_declaration.get())
                                     << MakeFollowingReferences(modifier.GetFollowingDeclarationModifiers()) << ">(" << MakeMemberAccess(info, member, modifier)
                                     << ", " << MakeEvaluation(modifier.GetArrayPointerCountEvaluation()) << ");")
         }
@@ -296,7 +296,7 @@ class ZoneWriteTemplate::Internal final : BaseTemplate
         }
         else if (computations.IsAfterPartialLoad())
         {
-            LINE("m_stream->Write<" << MakeTypeDecl(member->m_member->m_type_declaration.get())
+            LINE("m_stream->WriteFinal<" << MakeTypeDecl(member->m_member->m_type_declaration.get())
                                     << MakeFollowingReferences(modifier.GetFollowingDeclarationModifiers()) << ">(" << MakeMemberAccess(info, member, modifier)
                                     << ", " << arraySizeStr << ");")
         }
@@ -312,7 +312,7 @@ class ZoneWriteTemplate::Internal final : BaseTemplate
         }
         else
         {
-            LINE("m_stream->Write<" << MakeTypeDecl(member->m_member->m_type_declaration.get())
+            LINE("m_stream->WriteFinal<" << MakeTypeDecl(member->m_member->m_type_declaration.get())
                                     << MakeFollowingReferences(modifier.GetFollowingDeclarationModifiers()) << ">(" << MakeMemberAccess(info, member, modifier)
                                     << ", " << MakeEvaluation(modifier.GetDynamicArraySizeEvaluation()) << ");")
         }
@@ -338,7 +338,7 @@ class ZoneWriteTemplate::Internal final : BaseTemplate
         }
         else if (computations.IsAfterPartialLoad())
         {
-            LINE("m_stream->Write<" << MakeTypeDecl(member->m_member->m_type_declaration.get())
+            LINE("m_stream->WriteFinal<" << MakeTypeDecl(member->m_member->m_type_declaration.get())
                                     << MakeFollowingReferences(modifier.GetFollowingDeclarationModifiers()) << ">(&" << MakeMemberAccess(info, member, modifier)
                                     << ");")
         }
@@ -355,7 +355,7 @@ class ZoneWriteTemplate::Internal final : BaseTemplate
         }
         else
         {
-            LINE("m_stream->Write<" << MakeTypeDecl(member->m_member->m_type_declaration.get())
+            LINE("m_stream->WriteFinal<" << MakeTypeDecl(member->m_member->m_type_declaration.get())
                                     << MakeFollowingReferences(modifier.GetFollowingDeclarationModifiers()) << ">(" << MakeMemberAccess(info, member, modifier)
                                     << ");")
         }
@@ -557,6 +557,17 @@ class ZoneWriteTemplate::Internal final : BaseTemplate
         return member->m_is_reusable;
     }
 
+    static bool WriteMember_IsWrittenAsIs(MemberInformation* member, const DeclarationModifierComputations& modifier, const MemberWriteType writeType)
+    {
+        if (writeType != MemberWriteType::ARRAY_POINTER && writeType != MemberWriteType::SINGLE_POINTER)
+            return false;
+
+        if (member->m_is_string || member->m_is_script_string || !modifier.GetFollowingDeclarationModifiers().empty())
+            return false;
+
+        return member->m_type == nullptr || (member->m_type->m_is_leaf && !StructureComputations(member->m_type).IsAsset());
+    }
+
     void WriteMember_Reuse(StructureInformation* info,
                            MemberInformation* member,
                            const DeclarationModifierComputations& modifier,
@@ -568,7 +579,16 @@ class ZoneWriteTemplate::Internal final : BaseTemplate
             return;
         }
 
-        LINE("if(m_stream->ReusableShouldWrite(&" << MakeWrittenMemberAccess(info, member, modifier) << "))")
+        if (WriteMember_IsWrittenAsIs(member, modifier, writeType))
+        {
+            // The written data equals the original data, which allows the stream to reuse written data with the same content
+            const auto count = writeType == MemberWriteType::ARRAY_POINTER ? MakeEvaluation(modifier.GetArrayPointerCountEvaluation()) : "1";
+            LINE("if(m_stream->ReusableShouldWrite(&" << MakeWrittenMemberAccess(info, member, modifier) << ", " << count << "))")
+        }
+        else
+        {
+            LINE("if(m_stream->ReusableShouldWrite(&" << MakeWrittenMemberAccess(info, member, modifier) << "))")
+        }
         LINE("{")
         m_intendation++;
 
@@ -935,7 +955,9 @@ class ZoneWriteTemplate::Internal final : BaseTemplate
         LINE("auto* zoneAsset = static_cast<" << m_env.m_asset->m_definition->GetFullName() << "*>(m_asset->m_ptr);")
         LINE(MakeTypePtrVarName(m_env.m_asset->m_definition) << " = &zoneAsset;")
         LINE(MakeTypeWrittenPtrVarName(m_env.m_asset->m_definition) << " = &zoneAsset;")
+        LINE("m_stream->SetCurrentAsset(m_asset);")
         LINE("WritePtr_" << MakeSafeTypeName(m_env.m_asset->m_definition) << "(false);")
+        LINE("m_stream->SetCurrentAsset(nullptr);")
         LINE("*pAsset = zoneAsset;")
 
         m_intendation--;
@@ -992,7 +1014,7 @@ class ZoneWriteTemplate::Internal final : BaseTemplate
         }
         else
         {
-            LINE("m_stream->Write<" << def->GetFullName() << ">(*" << MakeTypePtrVarName(def) << ");")
+            LINE("m_stream->WriteFinal<" << def->GetFullName() << ">(*" << MakeTypePtrVarName(def) << ");")
         }
         LINE("m_stream->MarkFollowing(*" << MakeTypeWrittenPtrVarName(def) << ");")
     }
@@ -7,6 +7,7 @@
 #include "Parsing/Impl/IncludingStreamProxy.h"
 #include "Parsing/Impl/ParserFilesystemStream.h"
 #include "Parsing/PostProcessing/CalculateSizeAndAlignPostProcessor.h"
+#include "Parsing/PostProcessing/FlatTypesPostProcessor.h"
 #include "Parsing/PostProcessing/LeafsPostProcessor.h"
 #include "Parsing/PostProcessing/MarkingRequiredPostProcessor.h"
 #include "Parsing/PostProcessing/MemberLeafsPostProcessor.h"
@@ -61,6 +62,7 @@ void CommandsFileReader::SetupPostProcessors()
     m_post_processors.emplace_back(std::make_unique<LeafsPostProcessor>());
     m_post_processors.emplace_back(std::make_unique<MarkingRequiredPostProcessor>());
     m_post_processors.emplace_back(std::make_unique<MemberLeafsPostProcessor>());
+    m_post_processors.emplace_back(std::make_unique<FlatTypesPostProcessor>());
     m_post_processors.emplace_back(std::make_unique<UnionsPostProcessor>());
 }
 
@@ -0,0 +1,83 @@
+#include "FlatTypesPostProcessor.h"
+
+#include "Domain/Computations/MemberComputations.h"
+#include "Domain/Definition/PointerDeclarationModifier.h"
+
+bool FlatTypesPostProcessor::HasOnlyStaticNullPointers(const MemberInformation* member)
+{
+    for (const auto& modifier : member->m_member->m_type_declaration->m_declaration_modifiers)
+    {
+        if (modifier->GetType() == DeclarationModifierType::POINTER)
+        {
+            auto* pointer = dynamic_cast<PointerDeclarationModifier*>(modifier.get());
+            const auto* countEvaluation = pointer->GetCountEvaluation();
+
+            if (!countEvaluation->IsStatic() || countEvaluation->EvaluateNumeric() != 0)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool FlatTypesPostProcessor::IsFlat(StructureInformation* info)
+{
+    if (info->m_is_leaf)
+        return true;
+
+    // Post load actions are called by the code loading the type, so it cannot be skipped
+    if (info->m_post_load_action)
+        return false;
+
+    for (const auto& member : info->m_ordered_members)
+    {
+        const MemberComputations computations(member.get());
+        if (computations.ShouldIgnore())
+            continue;
+
+        if (member->m_is_string || !HasOnlyStaticNullPointers(member.get()) || computations.HasDynamicArraySize())
+            return false;
+
+        if (member->m_type != nullptr && member->m_type != info)
+        {
+            if (!IsFlat(member->m_type))
+                return false;
+
+            // Same as for types: The action is only called when the member is loaded with its own method
+            if (!member->m_type->m_is_leaf && member->m_post_load_action)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool FlatTypesPostProcessor::MemberIsFlat(MemberInformation* member)
+{
+    if (member->m_is_leaf)
+        return true;
+
+    if (member->m_is_string || !HasOnlyStaticNullPointers(member) || MemberComputations(member).HasDynamicArraySize())
+        return false;
+
+    if (member->m_type != nullptr && (!member->m_type->m_is_flat || member->m_post_load_action))
+        return false;
+
+    return true;
+}
+
+bool FlatTypesPostProcessor::PostProcess(IDataRepository* repository)
+{
+    const auto& allInfos = repository->GetAllStructureInformation();
+
+    for (const auto& info : allInfos)
+        info->m_is_flat = IsFlat(info);
+
+    for (const auto& info : allInfos)
+    {
+        for (const auto& member : info->m_ordered_members)
+            member->m_is_flat = MemberIsFlat(member.get());
+    }
+
+    return true;
+}
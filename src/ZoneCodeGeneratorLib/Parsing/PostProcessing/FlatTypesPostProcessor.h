@@ -0,0 +1,17 @@
+#pragma once
+
+#include "IPostProcessor.h"
+
+/**
+ * \brief Finds types that do not need any processing per element when being loaded.
+ * These are all leafs as well as types that are only not leafs because of script strings, since script strings are only resolved when marking.
+ */
+class FlatTypesPostProcessor final : public IPostProcessor
+{
+    static bool HasOnlyStaticNullPointers(const MemberInformation* member);
+    static bool IsFlat(StructureInformation* info);
+    static bool MemberIsFlat(MemberInformation* member);
+
+public:
+    bool PostProcess(IDataRepository* repository) override;
+};
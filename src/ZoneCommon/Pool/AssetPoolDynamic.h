@@ -2,6 +2,7 @@
 
 #include "AssetPool.h"
 #include "GlobalAssetPool.h"
+#include "GlobalAssetPoolIsolation.h"
 #include "XAssetInfo.h"
 
 #include <cstring>
@@ -12,11 +13,14 @@ template<typename T> class AssetPoolDynamic final : public AssetPool<T>
 
     std::vector<std::unique_ptr<XAssetInfo<T>>> m_assets;
     asset_type_t m_type;
+    bool m_linked;
 
 public:
     AssetPoolDynamic(const int priority, const asset_type_t type)
     {
-        GlobalAssetPool<T>::LinkAssetPool(this, priority);
+        m_linked = !GlobalAssetPoolIsolation::IsActive();
+        if (m_linked)
+            GlobalAssetPool<T>::LinkAssetPool(this, priority);
         m_type = type;
     }
 
@@ -27,7 +31,8 @@ public:
 
     ~AssetPoolDynamic() override
     {
-        GlobalAssetPool<T>::UnlinkAssetPool(this);
+        if (m_linked)
+            GlobalAssetPool<T>::UnlinkAssetPool(this);
 
         for (auto& entry : m_assets)
         {
@@ -50,7 +55,8 @@ public:
         m_asset_lookup[normalizedName] = pAssetInfo;
         m_assets.emplace_back(std::move(xAssetInfo));
 
-        GlobalAssetPool<T>::LinkAsset(this, normalizedName, pAssetInfo);
+        if (m_linked)
+            GlobalAssetPool<T>::LinkAsset(this, normalizedName, pAssetInfo);
 
         return pAssetInfo;
     }
@@ -2,6 +2,7 @@
 
 #include "AssetPool.h"
 #include "GlobalAssetPool.h"
+#include "GlobalAssetPoolIsolation.h"
 #include "XAssetInfo.h"
 
 #include <cstring>
@@ -27,12 +28,14 @@ template<typename T> class AssetPoolStatic final : public AssetPool<T>
     XAssetInfo<T>* m_info_pool;
     size_t m_capacity;
     asset_type_t m_type;
+    bool m_linked;
 
 public:
     AssetPoolStatic(const size_t capacity, const int priority, const asset_type_t type)
     {
         m_capacity = capacity;
         m_type = type;
+        m_linked = false;
 
         if (m_capacity > 0)
         {
@@ -49,7 +52,9 @@ public:
 
             m_free = m_pool;
 
-            GlobalAssetPool<T>::LinkAssetPool(this, priority);
+            m_linked = !GlobalAssetPoolIsolation::IsActive();
+            if (m_linked)
+                GlobalAssetPool<T>::LinkAssetPool(this, priority);
         }
         else
         {
@@ -66,7 +71,7 @@ public:
 
     ~AssetPoolStatic() override
     {
-        if (m_capacity > 0)
+        if (m_linked)
             GlobalAssetPool<T>::UnlinkAssetPool(this);
 
         delete[] m_pool;
@@ -97,7 +102,8 @@ public:
 
         m_asset_lookup[normalizedName] = poolSlot->m_info;
 
-        GlobalAssetPool<T>::LinkAsset(this, normalizedName, poolSlot->m_info);
+        if (m_linked)
+            GlobalAssetPool<T>::LinkAsset(this, normalizedName, poolSlot->m_info);
 
         return poolSlot->m_info;
     }
@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <cassert>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -26,6 +28,7 @@ template<typename T> class GlobalAssetPool
 
     static std::vector<std::unique_ptr<LinkedAssetPool>> m_linked_asset_pools;
     static std::unordered_map<std::string, GameAssetPoolEntry> m_assets;
+    static std::shared_mutex m_mutex;
 
     static void SortLinkedAssetPools()
     {
@@ -94,6 +97,8 @@ template<typename T> class GlobalAssetPool
 public:
     static void LinkAssetPool(AssetPool<T>* assetPool, const int priority)
     {
+        std::unique_lock lock(m_mutex);
+
         auto newLink = std::make_unique<LinkedAssetPool>();
         newLink->m_asset_pool = assetPool;
         newLink->m_priority = priority;
@@ -111,6 +116,8 @@ public:
 
     static void LinkAsset(AssetPool<T>* assetPool, const std::string& normalizedAssetName, XAssetInfo<T>* asset)
     {
+        std::unique_lock lock(m_mutex);
+
         LinkedAssetPool* link = nullptr;
 
         for (const auto& existingLink : m_linked_asset_pools)
@@ -131,6 +138,8 @@ public:
 
     static void UnlinkAssetPool(AssetPool<T>* assetPool)
     {
+        std::unique_lock lock(m_mutex);
+
         auto iLinkEntry = m_linked_asset_pools.begin();
 
         for (; iLinkEntry != m_linked_asset_pools.end(); ++iLinkEntry)
@@ -172,6 +181,8 @@ public:
     static XAssetInfo<T>* GetAssetByName(const std::string& name)
     {
         const auto normalizedName = XAssetInfo<T>::NormalizeAssetName(name);
+
+        std::shared_lock lock(m_mutex);
         const auto foundEntry = m_assets.find(normalizedName);
         if (foundEntry == m_assets.end())
             return nullptr;
@@ -187,3 +198,5 @@ std::vector<std::unique_ptr<typename GlobalAssetPool<T>::LinkedAssetPool>> Globa
 template<typename T>
 std::unordered_map<std::string, typename GlobalAssetPool<T>::GameAssetPoolEntry> GlobalAssetPool<T>::m_assets =
     std::unordered_map<std::string, GameAssetPoolEntry>();
+
+template<typename T> std::shared_mutex GlobalAssetPool<T>::m_mutex;
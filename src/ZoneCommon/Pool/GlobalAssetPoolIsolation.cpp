@@ -0,0 +1,22 @@
+#include "GlobalAssetPoolIsolation.h"
+
+namespace
+{
+    thread_local bool isolationActive = false;
+}
+
+GlobalAssetPoolIsolation::GlobalAssetPoolIsolation()
+    : m_previous(isolationActive)
+{
+    isolationActive = true;
+}
+
+GlobalAssetPoolIsolation::~GlobalAssetPoolIsolation()
+{
+    isolationActive = m_previous;
+}
+
+bool GlobalAssetPoolIsolation::IsActive()
+{
+    return isolationActive;
+}
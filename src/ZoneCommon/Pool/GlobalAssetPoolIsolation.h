@@ -0,0 +1,21 @@
+#pragma once
+
+/**
+ * \brief Keeps asset pools that are created on the current thread out of the global asset pools while it is alive.
+ * Zones that are loaded on the current thread are also not registered with their game.
+ * Zones that are created concurrently can then not resolve assets of each other.
+ */
+class GlobalAssetPoolIsolation
+{
+    bool m_previous;
+
+public:
+    GlobalAssetPoolIsolation();
+    ~GlobalAssetPoolIsolation();
+    GlobalAssetPoolIsolation(const GlobalAssetPoolIsolation& other) = delete;
+    GlobalAssetPoolIsolation(GlobalAssetPoolIsolation&& other) noexcept = delete;
+    GlobalAssetPoolIsolation& operator=(const GlobalAssetPoolIsolation& other) = delete;
+    GlobalAssetPoolIsolation& operator=(GlobalAssetPoolIsolation&& other) noexcept = delete;
+
+    [[nodiscard]] static bool IsActive();
+};
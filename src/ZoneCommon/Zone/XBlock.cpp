@@ -1,6 +1,13 @@
 #include "XBlock.h"
 
-#include <cassert>
+#include <new>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#endif
 
 XBlock::XBlock(const std::string& name, const int index, const Type type)
 {
@@ -13,22 +20,42 @@ XBlock::XBlock(const std::string& name, const int index, const Type type)
 
 XBlock::~XBlock()
 {
-    delete[] m_buffer;
-    m_buffer = nullptr;
+    Free();
 }
 
 void XBlock::Alloc(const size_t blockSize)
 {
-    delete[] m_buffer;
+    Free();
 
-    if (blockSize > 0)
-    {
-        m_buffer = new uint8_t[blockSize];
-        m_buffer_size = blockSize;
-    }
-    else
+    if (blockSize == 0)
+        return;
+
+    // Anonymous mappings are zero filled on demand, so untouched parts of a block (especially runtime blocks) never use physical memory
+#ifdef _WIN32
+    void* buffer = VirtualAlloc(nullptr, blockSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (buffer == nullptr)
+        throw std::bad_alloc();
+#else
+    void* buffer = mmap(nullptr, blockSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (buffer == MAP_FAILED)
+        throw std::bad_alloc();
+#endif
+
+    m_buffer = static_cast<uint8_t*>(buffer);
+    m_buffer_size = blockSize;
+}
+
+void XBlock::Free()
+{
+    if (m_buffer != nullptr)
     {
-        m_buffer = nullptr;
-        m_buffer_size = 0;
+#ifdef _WIN32
+        VirtualFree(m_buffer, 0, MEM_RELEASE);
+#else
+        munmap(m_buffer, m_buffer_size);
+#endif
     }
+
+    m_buffer = nullptr;
+    m_buffer_size = 0;
 }
@@ -22,6 +22,18 @@ public:
 
     XBlock(const std::string& name, int index, Type type);
     ~XBlock();
+    XBlock(const XBlock& other) = delete;
+    XBlock(XBlock&& other) noexcept = delete;
+    XBlock& operator=(const XBlock& other) = delete;
+    XBlock& operator=(XBlock&& other) noexcept = delete;
 
+    /**
+     * \brief Allocates the buffer of the block. The buffer is always zero initialized.
+     * The memory is reserved from the operating system and pages are only backed by physical memory once they are first written to.
+     * \param blockSize The size of the block in bytes.
+     */
     void Alloc(size_t blockSize);
+
+private:
+    void Free();
 };
@@ -8,4 +8,13 @@ class IXChunkProcessor
 public:
     virtual ~IXChunkProcessor() = default;
     virtual size_t Process(int streamNumber, const uint8_t* input, size_t inputLength, uint8_t* output, size_t outputBufferSize) = 0;
+
+    /**
+     * \brief Whether the processor carries state from one chunk of a stream to the next.
+     * Chunks of a stream must then be processed one after another in file order. Other processors may process any chunks concurrently.
+     */
+    [[nodiscard]] virtual bool IsStreamOrdered() const
+    {
+        return true;
+    }
 };
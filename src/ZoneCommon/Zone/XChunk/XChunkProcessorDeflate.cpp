@@ -6,29 +6,88 @@
 #include <zlib.h>
 #include <zutil.h>
 
-size_t XChunkProcessorDeflate::Process(int streamNumber, const uint8_t* input, const size_t inputLength, uint8_t* output, const size_t outputBufferSize)
+class XChunkProcessorDeflate::Context
+{
+public:
+    z_stream m_stream{};
+
+    explicit Context(const int compressionLevel)
+    {
+        m_stream.zalloc = Z_NULL;
+        m_stream.zfree = Z_NULL;
+        m_stream.opaque = Z_NULL;
+
+        const auto ret = deflateInit2(&m_stream, compressionLevel, Z_DEFLATED, -DEF_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY);
+        if (ret != Z_OK)
+            throw XChunkException("Initializing deflate failed.");
+    }
+
+    ~Context()
+    {
+        deflateEnd(&m_stream);
+    }
+
+    Context(const Context& other) = delete;
+    Context(Context&& other) noexcept = delete;
+    Context& operator=(const Context& other) = delete;
+    Context& operator=(Context&& other) noexcept = delete;
+};
+
+XChunkProcessorDeflate::XChunkProcessorDeflate(const int compressionLevel)
+    : m_compression_level(compressionLevel)
+{
+}
+
+XChunkProcessorDeflate::~XChunkProcessorDeflate() = default;
+
+std::unique_ptr<XChunkProcessorDeflate::Context> XChunkProcessorDeflate::AcquireContext()
 {
-    z_stream stream{};
-    stream.zalloc = Z_NULL;
-    stream.zfree = Z_NULL;
-    stream.opaque = Z_NULL;
+    {
+        std::lock_guard lock(m_context_mutex);
+        if (!m_free_contexts.empty())
+        {
+            auto context = std::move(m_free_contexts.back());
+            m_free_contexts.pop_back();
+            return context;
+        }
+    }
 
-    auto ret = deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, -DEF_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY);
-    if (ret != Z_OK)
-        throw XChunkException("Initializing deflate failed.");
+    return std::make_unique<Context>(m_compression_level);
+}
+
+void XChunkProcessorDeflate::ReleaseContext(std::unique_ptr<Context> context)
+{
+    if (deflateReset(&context->m_stream) != Z_OK)
+        return;
+
+    std::lock_guard lock(m_context_mutex);
+    m_free_contexts.emplace_back(std::move(context));
+}
+
+size_t XChunkProcessorDeflate::Process(int streamNumber, const uint8_t* input, const size_t inputLength, uint8_t* output, const size_t outputBufferSize)
+{
+    // When deflating fails the context is not handed back and is discarded instead
+    auto context = AcquireContext();
+    auto& stream = context->m_stream;
 
     stream.avail_in = inputLength;
     stream.next_in = input;
     stream.avail_out = outputBufferSize;
     stream.next_out = output;
 
-    ret = deflate(&stream, Z_FINISH);
+    const auto ret = deflate(&stream, Z_FINISH);
     if (ret != Z_STREAM_END)
         throw XChunkException("Failed to deflate memory of zone.");
 
     const size_t outputSize = stream.total_out;
 
-    deflateEnd(&stream);
+    ReleaseContext(std::move(context));
 
     return outputSize;
 }
+
+bool XChunkProcessorDeflate::IsStreamOrdered() const
+{
+    // Every chunk is a complete raw deflate stream of its own
+    return false;
+}
@@ -1,8 +1,31 @@
 #pragma once
 #include "IXChunkProcessor.h"
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 class XChunkProcessorDeflate final : public IXChunkProcessor
 {
+    class Context;
+
+    // zlib contexts are kept alive and reset between chunks instead of allocating and initializing new zlib state for every chunk.
+    // Chunks may be processed concurrently, so there is one context for every chunk currently being processed.
+    int m_compression_level;
+    std::vector<std::unique_ptr<Context>> m_free_contexts;
+    std::mutex m_context_mutex;
+
+    std::unique_ptr<Context> AcquireContext();
+    void ReleaseContext(std::unique_ptr<Context> context);
+
 public:
+    explicit XChunkProcessorDeflate(int compressionLevel);
+    ~XChunkProcessorDeflate() override;
+    XChunkProcessorDeflate(const XChunkProcessorDeflate& other) = delete;
+    XChunkProcessorDeflate(XChunkProcessorDeflate&& other) noexcept = delete;
+    XChunkProcessorDeflate& operator=(const XChunkProcessorDeflate& other) = delete;
+    XChunkProcessorDeflate& operator=(XChunkProcessorDeflate&& other) noexcept = delete;
+
     size_t Process(int streamNumber, const uint8_t* input, size_t inputLength, uint8_t* output, size_t outputBufferSize) override;
+    [[nodiscard]] bool IsStreamOrdered() const override;
 };
@@ -5,29 +5,85 @@
 #include <zlib.h>
 #include <zutil.h>
 
-size_t XChunkProcessorInflate::Process(int streamNumber, const uint8_t* input, const size_t inputLength, uint8_t* output, const size_t outputBufferSize)
+class XChunkProcessorInflate::Context
+{
+public:
+    z_stream m_stream{};
+
+    Context()
+    {
+        m_stream.zalloc = Z_NULL;
+        m_stream.zfree = Z_NULL;
+        m_stream.opaque = Z_NULL;
+
+        const auto ret = inflateInit2(&m_stream, -DEF_WBITS);
+        if (ret != Z_OK)
+            throw XChunkException("Initializing inflate failed.");
+    }
+
+    ~Context()
+    {
+        inflateEnd(&m_stream);
+    }
+
+    Context(const Context& other) = delete;
+    Context(Context&& other) noexcept = delete;
+    Context& operator=(const Context& other) = delete;
+    Context& operator=(Context&& other) noexcept = delete;
+};
+
+XChunkProcessorInflate::XChunkProcessorInflate() = default;
+
+XChunkProcessorInflate::~XChunkProcessorInflate() = default;
+
+std::unique_ptr<XChunkProcessorInflate::Context> XChunkProcessorInflate::AcquireContext()
+{
+    {
+        std::lock_guard lock(m_context_mutex);
+        if (!m_free_contexts.empty())
+        {
+            auto context = std::move(m_free_contexts.back());
+            m_free_contexts.pop_back();
+            return context;
+        }
+    }
+
+    return std::make_unique<Context>();
+}
+
+void XChunkProcessorInflate::ReleaseContext(std::unique_ptr<Context> context)
 {
-    z_stream stream{};
-    stream.zalloc = Z_NULL;
-    stream.zfree = Z_NULL;
-    stream.opaque = Z_NULL;
+    if (inflateReset(&context->m_stream) != Z_OK)
+        return;
+
+    std::lock_guard lock(m_context_mutex);
+    m_free_contexts.emplace_back(std::move(context));
+}
 
-    auto ret = inflateInit2(&stream, -DEF_WBITS);
-    if (ret != Z_OK)
-        throw XChunkException("Initializing inflate failed.");
+size_t XChunkProcessorInflate::Process(int streamNumber, const uint8_t* input, const size_t inputLength, uint8_t* output, const size_t outputBufferSize)
+{
+    // When inflating fails the context is not handed back and is discarded instead
+    auto context = AcquireContext();
+    auto& stream = context->m_stream;
 
     stream.avail_in = inputLength;
     stream.next_in = input;
     stream.avail_out = outputBufferSize;
     stream.next_out = output;
 
-    ret = inflate(&stream, Z_FULL_FLUSH);
+    const auto ret = inflate(&stream, Z_FULL_FLUSH);
     if (ret != Z_STREAM_END)
         throw XChunkException("Zone has invalid or unsupported compression. Inflate failed");
 
     const size_t outputSize = stream.total_out;
 
-    inflateEnd(&stream);
+    ReleaseContext(std::move(context));
 
     return outputSize;
 }
+
+bool XChunkProcessorInflate::IsStreamOrdered() const
+{
+    // Every chunk is a complete raw deflate stream of its own
+    return false;
+}
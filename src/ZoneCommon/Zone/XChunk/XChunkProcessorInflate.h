@@ -1,8 +1,30 @@
 #pragma once
 #include "IXChunkProcessor.h"
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 class XChunkProcessorInflate final : public IXChunkProcessor
 {
+    class Context;
+
+    // zlib contexts are kept alive and reset between chunks instead of allocating and initializing new zlib state for every chunk.
+    // Chunks may be processed concurrently, so there is one context for every chunk currently being processed.
+    std::vector<std::unique_ptr<Context>> m_free_contexts;
+    std::mutex m_context_mutex;
+
+    std::unique_ptr<Context> AcquireContext();
+    void ReleaseContext(std::unique_ptr<Context> context);
+
 public:
+    XChunkProcessorInflate();
+    ~XChunkProcessorInflate() override;
+    XChunkProcessorInflate(const XChunkProcessorInflate& other) = delete;
+    XChunkProcessorInflate(XChunkProcessorInflate&& other) noexcept = delete;
+    XChunkProcessorInflate& operator=(const XChunkProcessorInflate& other) = delete;
+    XChunkProcessorInflate& operator=(XChunkProcessorInflate&& other) noexcept = delete;
+
     size_t Process(int streamNumber, const uint8_t* input, size_t inputLength, uint8_t* output, size_t outputBufferSize) override;
+    [[nodiscard]] bool IsStreamOrdered() const override;
 };
@@ -1,5 +1,9 @@
 #include "Zone.h"
 
+#include "Pool/GlobalAssetPoolIsolation.h"
+
+#include <algorithm>
+
 Zone::Zone(std::string name, const zone_priority_t priority, IGame* game)
     : m_memory(std::make_unique<ZoneMemory>()),
       m_registered(false),
@@ -20,13 +24,22 @@ Zone::~Zone()
 
 void Zone::Register()
 {
-    if (!m_registered)
+    if (!m_registered && !GlobalAssetPoolIsolation::IsActive())
     {
         m_game->AddZone(this);
         m_registered = true;
     }
 }
 
+std::vector<Zone*> Zone::GetVisibleZones()
+{
+    auto zones = m_game->GetZones();
+    if (std::ranges::find(zones, this) == zones.end())
+        zones.emplace_back(this);
+
+    return zones;
+}
+
 ZoneMemory* Zone::GetMemory() const
 {
     return m_memory.get();
@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 class IGame;
 class ZoneAssetPools;
@@ -35,7 +36,15 @@ public:
     Zone& operator=(const Zone& other) = delete;
     Zone& operator=(Zone&& other) noexcept = default;
 
+    /**
+     * \brief Adds the zone to the zones of its game. Zones that are created while a \c GlobalAssetPoolIsolation is active are not added.
+     */
     void Register();
 
+    /**
+     * \brief Returns the zones of the game that this zone can use data of: All registered zones and the zone itself, even if it is not registered.
+     */
+    _NODISCARD std::vector<Zone*> GetVisibleZones();
+
     _NODISCARD ZoneMemory* GetMemory() const;
 };
@@ -56,6 +56,7 @@ function ZoneLoading:project()
         Crypto:include(includes)
 		Utils:include(includes)
 		zlib:include(includes)
+		json:include(includes)
 		ZoneCode:include(includes)
 
 		ZoneCode:use()
@@ -27,6 +27,7 @@
 #include "Game/IW3/XAssets/xanimparts/xanimparts_load_db.h"
 #include "Game/IW3/XAssets/xmodel/xmodel_load_db.h"
 #include "Loading/Exception/UnsupportedAssetTypeException.h"
+#include "Loading/ZoneLoadingProfile.h"
 
 #include <cassert>
 
@@ -133,6 +134,7 @@ void ContentLoader::LoadXAssetArray(const bool atStreamStart, const size_t count
 
     for (size_t index = 0; index < count; index++)
     {
+        ZoneLoadingProfile::AssetScope profileScope(m_zone, varXAsset->type);
         LoadXAsset(false);
         varXAsset++;
     }
@@ -80,6 +80,7 @@ std::unique_ptr<ZoneLoader> ZoneLoaderFactory::CreateLoaderForHeader(ZoneHeader&
     zoneLoader->AddLoadingStep(std::make_unique<StepAddProcessor>(std::make_unique<ProcessorInflate>(ZoneConstants::AUTHED_CHUNK_SIZE)));
 
     // Start of the XFile struct
+    zoneLoader->MarkXFileStart();
     zoneLoader->AddLoadingStep(std::make_unique<StepSkipBytes>(8));
     // Skip size and externalSize fields since they are not interesting for us
     zoneLoader->AddLoadingStep(std::make_unique<StepAllocXBlocks>());
@@ -87,6 +88,7 @@ std::unique_ptr<ZoneLoader> ZoneLoaderFactory::CreateLoaderForHeader(ZoneHeader&
     // Start of the zone content
     zoneLoader->AddLoadingStep(
         std::make_unique<StepLoadZoneContent>(std::make_unique<ContentLoader>(), zonePtr, ZoneConstants::OFFSET_BLOCK_BIT_COUNT, ZoneConstants::INSERT_BLOCK));
+    zoneLoader->MarkXFileEnd();
 
     return zoneLoader;
 }
@@ -42,6 +42,7 @@
 #include "Game/IW5/XAssets/xmodel/xmodel_load_db.h"
 #include "Game/IW5/XAssets/xmodelsurfs/xmodelsurfs_load_db.h"
 #include "Loading/Exception/UnsupportedAssetTypeException.h"
+#include "Loading/ZoneLoadingProfile.h"
 
 #include <cassert>
 
@@ -162,6 +163,7 @@ void ContentLoader::LoadXAssetArray(const bool atStreamStart, const size_t count
 
     for (size_t index = 0; index < count; index++)
     {
+        ZoneLoadingProfile::AssetScope profileScope(m_zone, varXAsset->type);
         LoadXAsset(false);
         varXAsset++;
     }
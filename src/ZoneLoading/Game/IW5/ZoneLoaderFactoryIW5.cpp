@@ -142,7 +142,7 @@ namespace
             std::make_unique<StepAddProcessor>(std::make_unique<ProcessorAuthedBlocks>(ZoneConstants::AUTHED_CHUNK_COUNT_PER_GROUP,
                                                                                        ZoneConstants::AUTHED_CHUNK_SIZE,
                                                                                        std::extent_v<decltype(DB_AuthSubHeader::masterBlockHashes)>,
-                                                                                       Crypto::CreateSHA256(),
+                                                                                       Crypto::CreateSHA256,
                                                                                        masterBlockHashesPtr)));
     }
 } // namespace
@@ -179,6 +179,7 @@ std::unique_ptr<ZoneLoader> ZoneLoaderFactory::CreateLoaderForHeader(ZoneHeader&
     zoneLoader->AddLoadingStep(std::make_unique<StepAddProcessor>(std::make_unique<ProcessorInflate>(ZoneConstants::AUTHED_CHUNK_SIZE)));
 
     // Start of the XFile struct
+    zoneLoader->MarkXFileStart();
     zoneLoader->AddLoadingStep(std::make_unique<StepSkipBytes>(8));
     // Skip size and externalSize fields since they are not interesting for us
     zoneLoader->AddLoadingStep(std::make_unique<StepAllocXBlocks>());
@@ -186,6 +187,7 @@ std::unique_ptr<ZoneLoader> ZoneLoaderFactory::CreateLoaderForHeader(ZoneHeader&
     // Start of the zone content
     zoneLoader->AddLoadingStep(
         std::make_unique<StepLoadZoneContent>(std::make_unique<ContentLoader>(), zonePtr, ZoneConstants::OFFSET_BLOCK_BIT_COUNT, ZoneConstants::INSERT_BLOCK));
+    zoneLoader->MarkXFileEnd();
 
     return zoneLoader;
 }
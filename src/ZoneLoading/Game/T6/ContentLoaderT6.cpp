@@ -50,6 +50,7 @@
 #include "Game/T6/XAssets/xmodel/xmodel_load_db.h"
 #include "Game/T6/XAssets/zbarrierdef/zbarrierdef_load_db.h"
 #include "Loading/Exception/UnsupportedAssetTypeException.h"
+#include "Loading/ZoneLoadingProfile.h"
 
 #include <cassert>
 
@@ -175,6 +176,7 @@ void ContentLoader::LoadXAssetArray(const bool atStreamStart, const size_t count
 
     for (size_t index = 0; index < count; index++)
     {
+        ZoneLoadingProfile::AssetScope profileScope(m_zone, varXAsset->type);
         LoadXAsset(false);
         varXAsset++;
     }
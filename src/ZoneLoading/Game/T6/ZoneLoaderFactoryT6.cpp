@@ -199,12 +199,14 @@ std::unique_ptr<ZoneLoader> ZoneLoaderFactory::CreateLoaderForHeader(ZoneHeader&
     ICapturedDataProvider* signatureDataProvider = AddXChunkProcessor(isEncrypted, *zoneLoader, fileName);
 
     // Start of the XFile struct
+    zoneLoader->MarkXFileStart();
     zoneLoader->AddLoadingStep(std::make_unique<StepLoadZoneSizes>());
     zoneLoader->AddLoadingStep(std::make_unique<StepAllocXBlocks>());
 
     // Start of the zone content
     zoneLoader->AddLoadingStep(
         std::make_unique<StepLoadZoneContent>(std::make_unique<ContentLoader>(), zonePtr, ZoneConstants::OFFSET_BLOCK_BIT_COUNT, ZoneConstants::INSERT_BLOCK));
+    zoneLoader->MarkXFileEnd();
 
     if (isSecure)
     {
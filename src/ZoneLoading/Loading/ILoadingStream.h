@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <span>
 
 class ILoadingStream
 {
@@ -10,4 +12,48 @@ public:
 
     virtual size_t Load(void* buffer, size_t length) = 0;
     virtual int64_t Pos() = 0;
+
+    /**
+     * \brief Loads data until and including the first occurrence of the terminator byte.
+     * Streams that buffer their data should override this to scan their buffers instead of loading byte by byte.
+     * \param buffer The buffer to load into.
+     * \param length The maximum amount of bytes to load.
+     * \param terminator The byte to stop loading after.
+     * \return The amount of bytes loaded. Only ends with the terminator if it was found within \c length bytes before the end of the stream.
+     */
+    virtual size_t LoadUntil(void* buffer, const size_t length, const uint8_t terminator)
+    {
+        auto* bytes = static_cast<uint8_t*>(buffer);
+
+        size_t loadedSize = 0;
+        while (loadedSize < length && Load(&bytes[loadedSize], 1) == 1)
+        {
+            if (bytes[loadedSize++] == terminator)
+                break;
+        }
+
+        return loadedSize;
+    }
+
+    /**
+     * \brief Checks whether this stream can provide its data in place via \c LoadInPlace.
+     * \return \c true if \c LoadInPlace is supported, otherwise \c false.
+     */
+    virtual bool SupportsInPlaceLoading()
+    {
+        return false;
+    }
+
+    /**
+     * \brief Loads data without copying it by handing out a view of memory that is owned by the stream.
+     * The memory stays valid for the lifetime of the stream.
+     * Only available when \c SupportsInPlaceLoading returns \c true.
+     * \param length The maximum amount of bytes to load.
+     * \return A view of the loaded data. It is shorter than \c length when the end of the stream was reached.
+     */
+    virtual std::span<const uint8_t> LoadInPlace([[maybe_unused]] size_t length)
+    {
+        assert(false);
+        return {};
+    }
 };
@@ -0,0 +1,33 @@
+#include "LoadingCaptureStream.h"
+
+LoadingCaptureStream::LoadingCaptureStream(ILoadingStream* baseStream, std::ostream& capture)
+    : m_base_stream(baseStream),
+      m_capture(capture)
+{
+}
+
+void LoadingCaptureStream::SetBaseStream(ILoadingStream* baseStream)
+{
+    m_base_stream = baseStream;
+}
+
+size_t LoadingCaptureStream::Load(void* buffer, const size_t length)
+{
+    const auto loadedSize = m_base_stream->Load(buffer, length);
+    m_capture.write(static_cast<const char*>(buffer), static_cast<std::streamsize>(loadedSize));
+
+    return loadedSize;
+}
+
+size_t LoadingCaptureStream::LoadUntil(void* buffer, const size_t length, const uint8_t terminator)
+{
+    const auto loadedSize = m_base_stream->LoadUntil(buffer, length, terminator);
+    m_capture.write(static_cast<const char*>(buffer), static_cast<std::streamsize>(loadedSize));
+
+    return loadedSize;
+}
+
+int64_t LoadingCaptureStream::Pos()
+{
+    return m_base_stream->Pos();
+}
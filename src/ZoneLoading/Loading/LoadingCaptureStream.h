@@ -0,0 +1,22 @@
+#pragma once
+#include "ILoadingStream.h"
+
+#include <ostream>
+
+/**
+ * \brief A stream that forwards all loads to a base stream and writes everything that was loaded to an output stream.
+ */
+class LoadingCaptureStream final : public ILoadingStream
+{
+    ILoadingStream* m_base_stream;
+    std::ostream& m_capture;
+
+public:
+    LoadingCaptureStream(ILoadingStream* baseStream, std::ostream& capture);
+
+    void SetBaseStream(ILoadingStream* baseStream);
+
+    size_t Load(void* buffer, size_t length) override;
+    size_t LoadUntil(void* buffer, size_t length, uint8_t terminator) override;
+    int64_t Pos() override;
+};
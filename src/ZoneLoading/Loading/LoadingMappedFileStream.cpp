@@ -0,0 +1,144 @@
+#include "LoadingMappedFileStream.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+class LoadingMappedFileStream::Impl
+{
+public:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+
+#if defined(_WIN32)
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+
+    ~Impl()
+    {
+        if (m_data)
+            UnmapViewOfFile(m_data);
+        if (m_mapping)
+            CloseHandle(m_mapping);
+        if (m_file != INVALID_HANDLE_VALUE)
+            CloseHandle(m_file);
+    }
+
+    bool Open(const std::string& path)
+    {
+        m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(m_file, &fileSize))
+            return false;
+
+        m_size = static_cast<size_t>(fileSize.QuadPart);
+        if (m_size == 0)
+            return true;
+
+        m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m_mapping)
+            return false;
+
+        m_data = static_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        return m_data != nullptr;
+    }
+#else
+    int m_fd = -1;
+
+    ~Impl()
+    {
+        if (m_data)
+            munmap(const_cast<uint8_t*>(m_data), m_size);
+        if (m_fd >= 0)
+            close(m_fd);
+    }
+
+    bool Open(const std::string& path)
+    {
+        m_fd = open(path.c_str(), O_RDONLY);
+        if (m_fd < 0)
+            return false;
+
+        struct stat fileStat{};
+        if (fstat(m_fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+            return false;
+
+        m_size = static_cast<size_t>(fileStat.st_size);
+        if (m_size == 0)
+            return true;
+
+        auto* mapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+        if (mapping == MAP_FAILED)
+            return false;
+
+        m_data = static_cast<const uint8_t*>(mapping);
+
+        // Zones are read front to back, let the kernel read ahead aggressively
+        madvise(mapping, m_size, MADV_SEQUENTIAL);
+
+        return true;
+    }
+#endif
+};
+
+LoadingMappedFileStream::LoadingMappedFileStream(std::unique_ptr<Impl> impl)
+    : m_impl(std::move(impl)),
+      m_data(m_impl->m_data),
+      m_size(m_impl->m_size),
+      m_offset(0)
+{
+}
+
+LoadingMappedFileStream::~LoadingMappedFileStream() = default;
+
+std::unique_ptr<LoadingMappedFileStream> LoadingMappedFileStream::Open(const std::string& path)
+{
+    auto impl = std::make_unique<Impl>();
+    if (!impl->Open(path))
+        return nullptr;
+
+    return std::unique_ptr<LoadingMappedFileStream>(new LoadingMappedFileStream(std::move(impl)));
+}
+
+size_t LoadingMappedFileStream::Load(void* buffer, const size_t length)
+{
+    const auto data = LoadInPlace(length);
+    if (!data.empty())
+        std::memcpy(buffer, data.data(), data.size());
+
+    return data.size();
+}
+
+int64_t LoadingMappedFileStream::Pos()
+{
+    return static_cast<int64_t>(m_offset);
+}
+
+bool LoadingMappedFileStream::SupportsInPlaceLoading()
+{
+    return true;
+}
+
+std::span<const uint8_t> LoadingMappedFileStream::LoadInPlace(const size_t length)
+{
+    const auto loadedSize = std::min(length, m_size - m_offset);
+    if (loadedSize == 0)
+        return {};
+
+    const std::span data(&m_data[m_offset], loadedSize);
+    m_offset += loadedSize;
+
+    return data;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "ILoadingStream.h"
+
+#include <memory>
+#include <string>
+
+/**
+ * \brief A loading stream that maps a whole file into memory, allowing its data to be loaded in place.
+ * The file must not be truncated while it is mapped: Reading a page past the new end of the file raises \c SIGBUS on POSIX systems
+ * and an \c EXCEPTION_IN_PAGE_ERROR on Windows, neither of which can be handled as a loading error.
+ * On Windows the file is opened without write sharing which prevents this. On POSIX systems nothing prevents it, so mapped files must not be rewritten in place.
+ */
+class LoadingMappedFileStream final : public ILoadingStream
+{
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_offset;
+
+    explicit LoadingMappedFileStream(std::unique_ptr<Impl> impl);
+
+public:
+    ~LoadingMappedFileStream() override;
+    LoadingMappedFileStream(const LoadingMappedFileStream& other) = delete;
+    LoadingMappedFileStream(LoadingMappedFileStream&& other) noexcept = delete;
+    LoadingMappedFileStream& operator=(const LoadingMappedFileStream& other) = delete;
+    LoadingMappedFileStream& operator=(LoadingMappedFileStream&& other) noexcept = delete;
+
+    /**
+     * \brief Maps the specified file into memory for reading.
+     * \param path The path of the file to map.
+     * \return The stream of the mapped file or \c nullptr if the file could not be mapped.
+     */
+    static std::unique_ptr<LoadingMappedFileStream> Open(const std::string& path);
+
+    size_t Load(void* buffer, size_t length) override;
+    int64_t Pos() override;
+
+    bool SupportsInPlaceLoading() override;
+    std::span<const uint8_t> LoadInPlace(size_t length) override;
+};
@@ -4,93 +4,257 @@
 #include "Loading/Exception/InvalidHashException.h"
 #include "Loading/Exception/TooManyAuthedGroupsException.h"
 #include "Loading/Exception/UnexpectedEndOfFileException.h"
+#include "Utils/ThreadPool.h"
 
 #include <cassert>
+#include <condition_variable>
 #include <cstring>
 #include <memory>
+#include <mutex>
 
 class ProcessorAuthedBlocks::Impl
 {
+    // Chunks are hashed in batches to keep the overhead of scheduling work on the thread pool low
+    static constexpr size_t CHUNKS_PER_BATCH = 16;
+    static constexpr size_t LOOKAHEAD_BATCH_COUNT = 4;
+
+    class ChunkBatch
+    {
+    public:
+        std::unique_ptr<IHashFunction> m_hash_function;
+
+        // Only used when the base stream does not support in place loading
+        std::unique_ptr<uint8_t[]> m_buffer;
+
+        const uint8_t* m_chunks[CHUNKS_PER_BATCH]{};
+        size_t m_chunk_sizes[CHUNKS_PER_BATCH]{};
+        size_t m_chunk_count = 0;
+
+        std::unique_ptr<uint8_t[]> m_hashes;
+        bool m_is_hashing = false;
+    };
+
     ProcessorAuthedBlocks* const m_base;
 
     const unsigned m_authed_chunk_count;
     const size_t m_chunk_size;
     const unsigned m_max_master_block_count;
+    const size_t m_hash_size;
 
-    const std::unique_ptr<IHashFunction> m_hash_function;
     IHashProvider* const m_master_block_hash_provider;
     const std::unique_ptr<uint8_t[]> m_chunk_hashes_buffer;
-    const std::unique_ptr<uint8_t[]> m_current_chunk_hash_buffer;
 
-    const std::unique_ptr<uint8_t[]> m_chunk_buffer;
+    // Ring of batches in file order. The batch at m_current_batch is the one that is currently consumed.
+    ChunkBatch m_batches[LOOKAHEAD_BATCH_COUNT];
+    size_t m_current_batch;
+    size_t m_current_chunk_in_batch;
+    bool m_batches_initialized;
+    bool m_end_of_base_stream;
+
+    // Amount of bytes that were loaded from the base stream but were not reached by the consumer yet
+    size_t m_read_ahead_size;
+
+    ThreadPool& m_pool;
+    std::mutex m_hash_mutex;
+    std::condition_variable m_batch_hashed;
+
+    const uint8_t* m_current_chunk;
+    const uint8_t* m_current_chunk_hash;
     unsigned m_current_group;
     unsigned m_current_chunk_in_group;
 
     size_t m_current_chunk_offset;
     size_t m_current_chunk_size;
 
+    void HashBatch(ChunkBatch& batch)
+    {
+        for (auto i = 0u; i < batch.m_chunk_count; i++)
+        {
+            batch.m_hash_function->Init();
+            batch.m_hash_function->Process(batch.m_chunks[i], batch.m_chunk_sizes[i]);
+            batch.m_hash_function->Finish(&batch.m_hashes[i * m_hash_size]);
+        }
+
+        std::lock_guard lock(m_hash_mutex);
+        batch.m_is_hashing = false;
+        m_batch_hashed.notify_all();
+    }
+
+    // Loading from the base stream always happens on the consuming thread. Only hashing is done by the thread pool.
+    void FillBatch(ChunkBatch& batch)
+    {
+        batch.m_chunk_count = 0;
+
+        while (!m_end_of_base_stream && batch.m_chunk_count < CHUNKS_PER_BATCH)
+        {
+            const uint8_t* chunk;
+            size_t chunkSize;
+            if (m_base->m_base_stream->SupportsInPlaceLoading())
+            {
+                const auto loadedChunk = m_base->m_base_stream->LoadInPlace(m_chunk_size);
+                chunk = loadedChunk.data();
+                chunkSize = loadedChunk.size();
+            }
+            else
+            {
+                if (!batch.m_buffer)
+                    batch.m_buffer = std::make_unique<uint8_t[]>(m_chunk_size * CHUNKS_PER_BATCH);
+
+                auto* chunkBuffer = &batch.m_buffer[m_chunk_size * batch.m_chunk_count];
+                chunk = chunkBuffer;
+                chunkSize = m_base->m_base_stream->Load(chunkBuffer, m_chunk_size);
+            }
+
+            if (chunkSize == 0)
+            {
+                m_end_of_base_stream = true;
+                break;
+            }
+
+            batch.m_chunks[batch.m_chunk_count] = chunk;
+            batch.m_chunk_sizes[batch.m_chunk_count] = chunkSize;
+            batch.m_chunk_count++;
+            m_read_ahead_size += chunkSize;
+        }
+
+        if (batch.m_chunk_count == 0)
+            return;
+
+        {
+            std::lock_guard lock(m_hash_mutex);
+            batch.m_is_hashing = true;
+        }
+
+        m_pool.Submit(
+            [this, &batch]
+            {
+                HashBatch(batch);
+            });
+    }
+
+    void WaitForBatch(const ChunkBatch& batch)
+    {
+        std::unique_lock lock(m_hash_mutex);
+        m_batch_hashed.wait(lock,
+                            [&batch]
+                            {
+                                return !batch.m_is_hashing;
+                            });
+    }
+
+    bool NextLoadedChunk()
+    {
+        if (!m_batches_initialized)
+        {
+            for (auto& batch : m_batches)
+                FillBatch(batch);
+
+            m_batches_initialized = true;
+            m_current_batch = 0;
+            m_current_chunk_in_batch = 0;
+        }
+        else if (++m_current_chunk_in_batch >= m_batches[m_current_batch].m_chunk_count)
+        {
+            // The consumed batch can be refilled with the chunks after the last batch of the ring
+            FillBatch(m_batches[m_current_batch]);
+
+            m_current_batch = (m_current_batch + 1) % LOOKAHEAD_BATCH_COUNT;
+            m_current_chunk_in_batch = 0;
+        }
+
+        const auto& batch = m_batches[m_current_batch];
+        if (m_current_chunk_in_batch >= batch.m_chunk_count)
+        {
+            m_current_chunk_size = 0;
+            return false;
+        }
+
+        WaitForBatch(batch);
+
+        m_current_chunk = batch.m_chunks[m_current_chunk_in_batch];
+        m_current_chunk_size = batch.m_chunk_sizes[m_current_chunk_in_batch];
+        m_current_chunk_hash = &batch.m_hashes[m_current_chunk_in_batch * m_hash_size];
+        m_read_ahead_size -= m_current_chunk_size;
+
+        return true;
+    }
+
 public:
     Impl(ProcessorAuthedBlocks* base,
          const unsigned authedChunkCount,
          const size_t chunkSize,
          const unsigned maxMasterBlockCount,
-         std::unique_ptr<IHashFunction> hashFunction,
+         const hash_function_factory_t& hashFunctionFactory,
          IHashProvider* masterBlockHashProvider)
         : m_base(base),
           m_authed_chunk_count(authedChunkCount),
           m_chunk_size(chunkSize),
           m_max_master_block_count(maxMasterBlockCount),
-          m_hash_function(std::move(hashFunction)),
+          m_hash_size(hashFunctionFactory()->GetHashSize()),
           m_master_block_hash_provider(masterBlockHashProvider),
-          m_chunk_hashes_buffer(std::make_unique<uint8_t[]>(m_authed_chunk_count * m_hash_function->GetHashSize())),
-          m_current_chunk_hash_buffer(std::make_unique<uint8_t[]>(m_hash_function->GetHashSize())),
-          m_chunk_buffer(std::make_unique<uint8_t[]>(m_chunk_size)),
+          m_chunk_hashes_buffer(std::make_unique<uint8_t[]>(m_authed_chunk_count * m_hash_size)),
+          m_current_batch(0),
+          m_current_chunk_in_batch(0),
+          m_batches_initialized(false),
+          m_end_of_base_stream(false),
+          m_read_ahead_size(0),
+          m_pool(ThreadPool::Default()),
+          m_current_chunk(nullptr),
+          m_current_chunk_hash(nullptr),
           m_current_group(1),
           m_current_chunk_in_group(0),
           m_current_chunk_offset(0),
           m_current_chunk_size(0)
     {
-        assert(m_authed_chunk_count * m_hash_function->GetHashSize() <= m_chunk_size);
+        assert(m_authed_chunk_count * m_hash_size <= m_chunk_size);
+
+        for (auto& batch : m_batches)
+        {
+            batch.m_hash_function = hashFunctionFactory();
+            batch.m_hashes = std::make_unique<uint8_t[]>(m_hash_size * CHUNKS_PER_BATCH);
+        }
+    }
+
+    ~Impl()
+    {
+        // Hashing tasks reference the batches so they must have completed before destroying them
+        for (const auto& batch : m_batches)
+            WaitForBatch(batch);
     }
 
+    Impl(const Impl& other) = delete;
+    Impl(Impl&& other) noexcept = delete;
+    Impl& operator=(const Impl& other) = delete;
+    Impl& operator=(Impl&& other) noexcept = delete;
+
     bool NextChunk()
     {
         m_current_chunk_offset = 0;
 
         while (true)
         {
-            m_current_chunk_size = m_base->m_base_stream->Load(m_chunk_buffer.get(), m_chunk_size);
-
-            if (m_current_chunk_size == 0)
+            if (!NextLoadedChunk())
                 return false;
 
-            m_hash_function->Init();
-            m_hash_function->Process(m_chunk_buffer.get(), m_current_chunk_size);
-            m_hash_function->Finish(m_current_chunk_hash_buffer.get());
-
             if (m_current_chunk_in_group == 0)
             {
-                if (m_current_chunk_size < m_authed_chunk_count * m_hash_function->GetHashSize())
+                if (m_current_chunk_size < m_authed_chunk_count * m_hash_size)
                     throw UnexpectedEndOfFileException();
 
                 const uint8_t* masterBlockHash = nullptr;
                 size_t masterBlockHashSize = 0;
                 m_master_block_hash_provider->GetHash(m_current_group - 1, &masterBlockHash, &masterBlockHashSize);
 
-                if (masterBlockHashSize != m_hash_function->GetHashSize()
-                    || std::memcmp(m_current_chunk_hash_buffer.get(), masterBlockHash, m_hash_function->GetHashSize()) != 0)
+                if (masterBlockHashSize != m_hash_size || std::memcmp(m_current_chunk_hash, masterBlockHash, m_hash_size) != 0)
                     throw InvalidHashException();
 
-                memcpy(m_chunk_hashes_buffer.get(), m_chunk_buffer.get(), m_authed_chunk_count * m_hash_function->GetHashSize());
+                memcpy(m_chunk_hashes_buffer.get(), m_current_chunk, m_authed_chunk_count * m_hash_size);
 
                 m_current_chunk_in_group++;
             }
             else
             {
-                if (std::memcmp(m_current_chunk_hash_buffer.get(),
-                                &m_chunk_hashes_buffer[(m_current_chunk_in_group - 1) * m_hash_function->GetHashSize()],
-                                m_hash_function->GetHashSize())
-                    != 0)
+                if (std::memcmp(m_current_chunk_hash, &m_chunk_hashes_buffer[(m_current_chunk_in_group - 1) * m_hash_size], m_hash_size) != 0)
                     throw InvalidHashException();
 
                 if (++m_current_chunk_in_group > m_authed_chunk_count)
@@ -124,7 +288,7 @@ public:
                 sizeToWrite = m_current_chunk_size - m_current_chunk_offset;
 
             assert(length - loadedSize >= sizeToWrite);
-            memcpy(&static_cast<uint8_t*>(buffer)[loadedSize], &m_chunk_buffer[m_current_chunk_offset], sizeToWrite);
+            memcpy(&static_cast<uint8_t*>(buffer)[loadedSize], &m_current_chunk[m_current_chunk_offset], sizeToWrite);
             loadedSize += sizeToWrite;
             m_current_chunk_offset += sizeToWrite;
         }
@@ -134,16 +298,16 @@ public:
 
     int64_t Pos()
     {
-        return m_base->m_base_stream->Pos() - (m_current_chunk_size - m_current_chunk_offset);
+        return m_base->m_base_stream->Pos() - static_cast<int64_t>(m_read_ahead_size + (m_current_chunk_size - m_current_chunk_offset));
     }
 };
 
 ProcessorAuthedBlocks::ProcessorAuthedBlocks(const unsigned authedChunkCount,
                                              const size_t chunkSize,
                                              const unsigned maxMasterBlockCount,
-                                             std::unique_ptr<IHashFunction> hashFunction,
+                                             hash_function_factory_t hashFunctionFactory,
                                              IHashProvider* masterBlockHashProvider)
-    : m_impl(new Impl(this, authedChunkCount, chunkSize, maxMasterBlockCount, std::move(hashFunction), masterBlockHashProvider))
+    : m_impl(new Impl(this, authedChunkCount, chunkSize, maxMasterBlockCount, hashFunctionFactory, masterBlockHashProvider))
 {
 }
 
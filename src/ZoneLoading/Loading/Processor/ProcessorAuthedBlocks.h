@@ -3,6 +3,7 @@
 #include "Loading/IHashProvider.h"
 #include "Loading/StreamProcessor.h"
 
+#include <functional>
 #include <memory>
 
 class ProcessorAuthedBlocks final : public StreamProcessor
@@ -11,10 +12,16 @@ class ProcessorAuthedBlocks final : public StreamProcessor
     Impl* m_impl;
 
 public:
+    using hash_function_factory_t = std::function<std::unique_ptr<IHashFunction>()>;
+
+    /**
+     * \brief Loads authed chunks while verifying their hashes. Hashes of upcoming chunks are calculated on worker threads.
+     * \param hashFunctionFactory Creates the hash function instances used for calculating the chunk hashes. One instance is created per batch of chunks.
+     */
     ProcessorAuthedBlocks(unsigned authedChunkCount,
                           size_t chunkSize,
                           unsigned maxMasterBlockCount,
-                          std::unique_ptr<IHashFunction> hashFunction,
+                          hash_function_factory_t hashFunctionFactory,
                           IHashProvider* masterBlockHashProvider);
     ~ProcessorAuthedBlocks() override;
     ProcessorAuthedBlocks(const ProcessorAuthedBlocks& other) = delete;
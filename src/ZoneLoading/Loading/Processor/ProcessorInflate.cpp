@@ -2,7 +2,9 @@
 
 #include "Loading/Exception/InvalidCompressionException.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <stdexcept>
 #include <zlib.h>
@@ -16,10 +18,30 @@ class ProcessorInflate::Impl
     std::unique_ptr<uint8_t[]> m_buffer;
     size_t m_buffer_size;
 
+    // Data that was inflated past a terminator when scanning and still needs to be handed out
+    std::unique_ptr<uint8_t[]> m_pending;
+    size_t m_pending_offset;
+    size_t m_pending_size;
+
+    size_t LoadPending(uint8_t* buffer, const size_t length)
+    {
+        const auto pendingSize = std::min(length, m_pending_size - m_pending_offset);
+        if (pendingSize > 0)
+        {
+            memcpy(buffer, &m_pending[m_pending_offset], pendingSize);
+            m_pending_offset += pendingSize;
+        }
+
+        return pendingSize;
+    }
+
 public:
     Impl(ProcessorInflate* baseClass, const size_t bufferSize)
         : m_buffer(std::make_unique<uint8_t[]>(bufferSize)),
-          m_buffer_size(bufferSize)
+          m_buffer_size(bufferSize),
+          m_pending(std::make_unique<uint8_t[]>(SCAN_STEP_SIZE)),
+          m_pending_offset(0),
+          m_pending_size(0)
     {
         m_base = baseClass;
 
@@ -48,6 +70,60 @@ public:
     Impl& operator=(Impl&& other) noexcept = default;
 
     size_t Load(void* buffer, const size_t length)
+    {
+        const auto pendingSize = LoadPending(static_cast<uint8_t*>(buffer), length);
+        if (pendingSize == length)
+            return length;
+
+        return pendingSize + Inflate(&static_cast<uint8_t*>(buffer)[pendingSize], length - pendingSize);
+    }
+
+    size_t LoadUntil(void* buffer, const size_t length, const uint8_t terminator)
+    {
+        auto* bytes = static_cast<uint8_t*>(buffer);
+
+        size_t loadedSize = 0;
+        while (loadedSize < length)
+        {
+            // Take whatever is left over from the last scan first, otherwise inflate a small step straight into the target buffer
+            auto* stepStart = &bytes[loadedSize];
+            auto stepSize = LoadPending(stepStart, std::min(length - loadedSize, SCAN_STEP_SIZE));
+            const auto fromPending = stepSize > 0;
+            if (!fromPending)
+                stepSize = Inflate(stepStart, std::min(length - loadedSize, SCAN_STEP_SIZE));
+
+            if (stepSize == 0)
+                break;
+
+            const auto* terminatorPos = static_cast<const uint8_t*>(memchr(stepStart, terminator, stepSize));
+            if (terminatorPos)
+            {
+                const auto usedSize = static_cast<size_t>(terminatorPos - stepStart) + 1;
+                const auto overshootSize = stepSize - usedSize;
+
+                // Give back everything after the terminator
+                if (fromPending)
+                    m_pending_offset -= overshootSize;
+                else if (overshootSize > 0)
+                {
+                    memcpy(m_pending.get(), &stepStart[usedSize], overshootSize);
+                    m_pending_offset = 0;
+                    m_pending_size = overshootSize;
+                }
+
+                if (overshootSize > 0)
+                    memset(&stepStart[usedSize], 0, overshootSize);
+
+                return loadedSize + usedSize;
+            }
+
+            loadedSize += stepSize;
+        }
+
+        return loadedSize;
+    }
+
+    size_t Inflate(void* buffer, const size_t length)
     {
         m_stream.next_out = static_cast<Bytef*>(buffer);
         m_stream.avail_out = length;
@@ -56,8 +132,18 @@ public:
         {
             if (m_stream.avail_in == 0)
             {
-                m_stream.avail_in = m_base->m_base_stream->Load(m_buffer.get(), m_buffer_size);
-                m_stream.next_in = m_buffer.get();
+                if (m_base->m_base_stream->SupportsInPlaceLoading())
+                {
+                    // Inflate straight from the memory of the base stream, no need to stage it in our own buffer
+                    const auto input = m_base->m_base_stream->LoadInPlace(m_buffer_size);
+                    m_stream.avail_in = static_cast<uInt>(input.size());
+                    m_stream.next_in = const_cast<Bytef*>(input.data());
+                }
+                else
+                {
+                    m_stream.avail_in = m_base->m_base_stream->Load(m_buffer.get(), m_buffer_size);
+                    m_stream.next_in = m_buffer.get();
+                }
 
                 if (m_stream.avail_in == 0) // EOF
                     return length - m_stream.avail_out;
@@ -94,6 +180,11 @@ size_t ProcessorInflate::Load(void* buffer, const size_t length)
     return m_impl->Load(buffer, length);
 }
 
+size_t ProcessorInflate::LoadUntil(void* buffer, const size_t length, const uint8_t terminator)
+{
+    return m_impl->LoadUntil(buffer, length, terminator);
+}
+
 int64_t ProcessorInflate::Pos()
 {
     return m_base_stream->Pos();
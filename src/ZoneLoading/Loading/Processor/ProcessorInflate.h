@@ -7,6 +7,7 @@ class ProcessorInflate final : public StreamProcessor
     Impl* m_impl;
 
     static constexpr size_t DEFAULT_BUFFER_SIZE = 0x2000;
+    static constexpr size_t SCAN_STEP_SIZE = 0x100;
 
 public:
     ProcessorInflate();
@@ -18,5 +19,6 @@ public:
     ProcessorInflate& operator=(ProcessorInflate&& other) noexcept = default;
 
     size_t Load(void* buffer, size_t length) override;
+    size_t LoadUntil(void* buffer, size_t length, uint8_t terminator) override;
     int64_t Pos() override;
 };
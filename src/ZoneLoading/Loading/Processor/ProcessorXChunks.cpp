@@ -1,107 +1,211 @@
 #include "ProcessorXChunks.h"
 
 #include "Loading/Exception/InvalidChunkSizeException.h"
+#include "Utils/ThreadPool.h"
 #include "Zone/ZoneTypes.h"
 
+#include <algorithm>
 #include <cassert>
 #include <condition_variable>
 #include <cstring>
+#include <exception>
 #include <memory>
 #include <mutex>
-#include <thread>
 #include <vector>
 
 class DBLoadStream
 {
-    int m_index;
+    class ChunkSlot
+    {
+    public:
+        std::unique_ptr<uint8_t[]> m_buffers[2];
 
-    std::unique_ptr<uint8_t[]> m_buffers[2];
+        // The input of the first stage may also point into the memory of the base stream when it supports in place loading
+        const uint8_t* m_input = nullptr;
+        size_t m_input_size = 0;
 
-    uint8_t* m_input_buffer;
-    size_t m_input_size;
+        const uint8_t* m_output = nullptr;
+        size_t m_output_size = 0;
 
-    uint8_t* m_output_buffer;
-    size_t m_output_size;
+        size_t m_completed_stages = 0;
+        bool m_is_processing = false;
+        std::exception_ptr m_error;
+    };
 
+    int m_index;
     size_t m_chunk_size;
 
-    bool m_is_loading;
+    // Ring of chunks of this stream in file order, starting at m_head.
+    // The chunk at m_head is the one currently consumed or next to be consumed.
+    std::vector<ChunkSlot> m_slots;
+    size_t m_head;
+    size_t m_queued_count;
+
+    size_t m_running_tasks;
+    bool m_shutting_down;
     std::mutex m_load_mutex;
-    std::condition_variable m_loading_finished;
-    std::thread m_load_thread;
+    std::condition_variable m_slot_changed;
 
+    ThreadPool& m_pool;
     std::vector<std::unique_ptr<IXChunkProcessor>>& m_processors;
 
-    void Load()
+    ChunkSlot& SlotAt(const size_t queuePosition)
+    {
+        return m_slots[(m_head + queuePosition) % m_slots.size()];
+    }
+
+    void RunStage(ChunkSlot& slot, const size_t stage) const
     {
-        std::lock_guard<std::mutex> lock(m_load_mutex);
+        if (stage > 0)
+        {
+            slot.m_input = slot.m_output;
+            slot.m_input_size = slot.m_output_size;
+        }
 
-        bool firstProcessor = true;
+        auto* outputBuffer = slot.m_input == slot.m_buffers[0].get() ? slot.m_buffers[1].get() : slot.m_buffers[0].get();
+        slot.m_output_size = m_processors[stage]->Process(m_index, slot.m_input, slot.m_input_size, outputBuffer, m_chunk_size);
+        slot.m_output = outputBuffer;
+    }
 
-        for (const auto& processor : m_processors)
+    // Each processor stage of a stream must see the chunks of the stream in file order since processors
+    // like Salsa20 carry state from one chunk to the next. Different stages of different chunks however may overlap.
+    // Must be called with m_load_mutex held.
+    void ScheduleStages()
+    {
+        const auto stageCount = m_processors.size();
+
+        for (auto stage = 0u; stage < stageCount; stage++)
         {
-            if (!firstProcessor)
+            for (auto queuePosition = 0u; queuePosition < m_queued_count; queuePosition++)
             {
-                uint8_t* previousInputBuffer = m_input_buffer;
-                m_input_buffer = m_output_buffer;
-                m_output_buffer = previousInputBuffer;
+                auto& slot = SlotAt(queuePosition);
+                if (slot.m_completed_stages > stage)
+                    continue;
 
-                m_input_size = m_output_size;
-                m_output_size = 0;
+                // This is the earliest chunk that did not complete this stage yet
+                if (slot.m_completed_stages == stage && !slot.m_is_processing)
+                {
+                    slot.m_is_processing = true;
+                    m_running_tasks++;
+                    m_pool.Submit(
+                        [this, &slot, stage]
+                        {
+                            ProcessStage(slot, stage);
+                        });
+                }
+                break;
             }
+        }
+    }
 
-            m_output_size = processor->Process(m_index, m_input_buffer, m_input_size, m_output_buffer, m_chunk_size);
+    void ProcessStage(ChunkSlot& slot, const size_t stage)
+    {
+        std::exception_ptr error;
+        try
+        {
+            RunStage(slot, stage);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
 
-            firstProcessor = false;
+        std::lock_guard lock(m_load_mutex);
+
+        slot.m_is_processing = false;
+        if (error)
+        {
+            slot.m_error = error;
+            slot.m_completed_stages = m_processors.size();
         }
+        else
+            slot.m_completed_stages = stage + 1;
 
-        m_is_loading = false;
-        m_loading_finished.notify_all();
+        m_running_tasks--;
+        if (!m_shutting_down)
+            ScheduleStages();
+
+        m_slot_changed.notify_all();
     }
 
 public:
-    DBLoadStream(const int streamIndex, const size_t chunkSize, std::vector<std::unique_ptr<IXChunkProcessor>>& chunkProcessors)
-        : m_processors(chunkProcessors)
+    DBLoadStream(
+        const int streamIndex, const size_t chunkSize, const size_t lookaheadDepth, ThreadPool& pool, std::vector<std::unique_ptr<IXChunkProcessor>>& chunkProcessors)
+        : m_index(streamIndex),
+          m_chunk_size(chunkSize),
+          m_slots(lookaheadDepth),
+          m_head(0),
+          m_queued_count(0),
+          m_running_tasks(0),
+          m_shutting_down(false),
+          m_pool(pool),
+          m_processors(chunkProcessors)
     {
-        m_index = streamIndex;
-        m_chunk_size = chunkSize;
+        assert(lookaheadDepth > 0);
+
+        for (auto& slot : m_slots)
+        {
+            for (auto& buffer : slot.m_buffers)
+                buffer = std::make_unique<uint8_t[]>(chunkSize);
+        }
+    }
 
-        for (auto& buffer : m_buffers)
-            buffer = std::make_unique<uint8_t[]>(chunkSize);
+    ~DBLoadStream()
+    {
+        std::unique_lock lock(m_load_mutex);
+        m_shutting_down = true;
+        m_slot_changed.wait(lock,
+                            [this]
+                            {
+                                return m_running_tasks == 0;
+                            });
+    }
 
-        m_input_buffer = m_buffers[0].get();
-        m_output_buffer = m_buffers[1].get();
+    DBLoadStream(const DBLoadStream& other) = delete;
+    DBLoadStream(DBLoadStream&& other) noexcept = delete;
+    DBLoadStream& operator=(const DBLoadStream& other) = delete;
+    DBLoadStream& operator=(DBLoadStream&& other) noexcept = delete;
 
-        m_input_size = 0;
-        m_output_size = 0;
+    [[nodiscard]] bool IsEmpty() const
+    {
+        return m_queued_count == 0;
+    }
 
-        m_is_loading = false;
+    [[nodiscard]] bool HasFreeSlot() const
+    {
+        return m_queued_count < m_slots.size();
     }
 
-    uint8_t* GetInputBuffer() const
+    uint8_t* GetInputBuffer()
     {
-        return m_input_buffer;
+        assert(HasFreeSlot());
+
+        return SlotAt(m_queued_count).m_buffers[0].get();
     }
 
-    void StartLoading(const size_t inputSize)
+    void StartLoading(const uint8_t* input, const size_t inputSize)
     {
-        if (inputSize > 0)
-        {
-            std::unique_lock<std::mutex> lock(m_load_mutex);
+        std::lock_guard lock(m_load_mutex);
+        assert(HasFreeSlot());
 
-            if (m_is_loading)
-            {
-                m_loading_finished.wait(lock);
-            }
+        auto& slot = SlotAt(m_queued_count);
+        slot.m_input = input;
+        slot.m_input_size = inputSize;
+        slot.m_error = nullptr;
+        slot.m_is_processing = false;
+        m_queued_count++;
 
-            m_input_size = inputSize;
-            m_is_loading = true;
-            m_load_thread = std::thread(&DBLoadStream::Load, this);
-            m_load_thread.detach();
+        if (inputSize > 0 && !m_processors.empty())
+        {
+            slot.m_output_size = 0;
+            slot.m_completed_stages = 0;
+            ScheduleStages();
         }
         else
         {
-            m_output_size = 0;
+            slot.m_output = input;
+            slot.m_output_size = inputSize;
+            slot.m_completed_stages = m_processors.size();
         }
     }
 
@@ -109,15 +213,30 @@ public:
     {
         assert(pBuffer != nullptr);
         assert(pSize != nullptr);
+        assert(!IsEmpty());
 
-        std::unique_lock<std::mutex> lock(m_load_mutex);
-        if (m_is_loading)
-        {
-            m_loading_finished.wait(lock);
-        }
+        std::unique_lock lock(m_load_mutex);
+        auto& slot = SlotAt(0);
+        m_slot_changed.wait(lock,
+                            [this, &slot]
+                            {
+                                return slot.m_completed_stages >= m_processors.size();
+                            });
 
-        *pBuffer = m_output_buffer;
-        *pSize = m_output_size;
+        if (slot.m_error)
+            std::rethrow_exception(slot.m_error);
+
+        *pBuffer = slot.m_output;
+        *pSize = slot.m_output_size;
+    }
+
+    void ReleaseOutput()
+    {
+        std::lock_guard lock(m_load_mutex);
+        assert(!IsEmpty());
+
+        m_head = (m_head + 1) % m_slots.size();
+        m_queued_count--;
     }
 };
 
@@ -126,8 +245,10 @@ class ProcessorXChunks::ProcessorXChunksImpl
     ProcessorXChunks* m_base;
 
     std::vector<std::unique_ptr<DBLoadStream>> m_streams;
+    int m_stream_count;
     size_t m_chunk_size;
     size_t m_vanilla_buffer_size;
+    size_t m_lookahead_depth;
     std::vector<std::unique_ptr<IXChunkProcessor>> m_chunk_processors;
 
     bool m_initialized_streams;
@@ -138,11 +259,11 @@ class ProcessorXChunks::ProcessorXChunksImpl
     size_t m_vanilla_buffer_offset;
 
     bool m_eof_reached;
-    unsigned int m_eof_stream;
 
     void AdvanceStream(const unsigned int streamNum)
     {
         assert(streamNum >= 0 && streamNum < m_streams.size());
+        assert(m_streams[streamNum]->HasFreeSlot());
 
         if (m_eof_reached)
             return;
@@ -164,7 +285,6 @@ class ProcessorXChunks::ProcessorXChunksImpl
         if (readSize == 0)
         {
             m_eof_reached = true;
-            m_eof_stream = streamNum;
             return;
         }
 
@@ -174,7 +294,19 @@ class ProcessorXChunks::ProcessorXChunksImpl
         }
 
         const auto& stream = m_streams[streamNum];
-        const size_t loadedChunkSize = m_base->m_base_stream->Load(stream->GetInputBuffer(), chunkSize);
+        const uint8_t* chunkData;
+        size_t loadedChunkSize;
+        if (m_base->m_base_stream->SupportsInPlaceLoading())
+        {
+            const auto input = m_base->m_base_stream->LoadInPlace(chunkSize);
+            chunkData = input.data();
+            loadedChunkSize = input.size();
+        }
+        else
+        {
+            chunkData = stream->GetInputBuffer();
+            loadedChunkSize = m_base->m_base_stream->Load(stream->GetInputBuffer(), chunkSize);
+        }
 
         if (loadedChunkSize != chunkSize)
         {
@@ -186,16 +318,33 @@ class ProcessorXChunks::ProcessorXChunksImpl
             m_vanilla_buffer_offset = (m_vanilla_buffer_offset + loadedChunkSize) % m_vanilla_buffer_size;
         }
 
-        stream->StartLoading(loadedChunkSize);
+        stream->StartLoading(chunkData, loadedChunkSize);
+    }
+
+    void FetchCurrentChunk()
+    {
+        m_current_chunk_offset = 0;
+
+        const auto& stream = m_streams[m_current_stream];
+        if (stream->IsEmpty())
+        {
+            m_current_chunk = nullptr;
+            m_current_chunk_size = 0;
+            return;
+        }
+
+        stream->GetOutput(&m_current_chunk, &m_current_chunk_size);
     }
 
     void NextStream()
     {
+        // Hand the slot of the consumed chunk back to its stream and refill it with the next chunk of the file
+        // that belongs to this stream, keeping every stream m_lookahead_depth chunks ahead of the consumer
+        m_streams[m_current_stream]->ReleaseOutput();
         AdvanceStream(m_current_stream);
 
         m_current_stream = (m_current_stream + 1) % m_streams.size();
-        m_current_chunk_offset = 0;
-        m_streams[m_current_stream]->GetOutput(&m_current_chunk, &m_current_chunk_size);
+        FetchCurrentChunk();
     }
 
     void InitStreams()
@@ -203,20 +352,29 @@ class ProcessorXChunks::ProcessorXChunksImpl
         m_initialized_streams = true;
         m_vanilla_buffer_offset = static_cast<size_t>(m_base->m_base_stream->Pos());
 
-        const unsigned int streamCount = m_streams.size();
-        for (unsigned int streamNum = 0; streamNum < streamCount; streamNum++)
+        auto& pool = ThreadPool::Default();
+        for (int streamIndex = 0; streamIndex < m_stream_count; streamIndex++)
         {
-            AdvanceStream(streamNum);
+            m_streams.emplace_back(std::make_unique<DBLoadStream>(streamIndex, m_chunk_size, m_lookahead_depth, pool, m_chunk_processors));
+        }
+
+        // Chunks are distributed over the streams round-robin, so read them in rounds to keep the file order
+        for (size_t lookahead = 0; lookahead < m_lookahead_depth; lookahead++)
+        {
+            for (unsigned int streamNum = 0; streamNum < m_streams.size(); streamNum++)
+            {
+                AdvanceStream(streamNum);
+            }
         }
 
         m_current_stream = 0;
-        m_current_chunk_offset = 0;
-        m_streams[0]->GetOutput(&m_current_chunk, &m_current_chunk_size);
+        FetchCurrentChunk();
     }
 
     bool EndOfStream() const
     {
-        return m_eof_reached && m_eof_stream == m_current_stream;
+        // Chunks are read in file order, so the first stream that runs dry after eof was reached is where the file ends
+        return m_eof_reached && m_streams[m_current_stream]->IsEmpty();
     }
 
 public:
@@ -228,13 +386,10 @@ public:
 
         m_base = base;
 
-        for (int streamIndex = 0; streamIndex < numStreams; streamIndex++)
-        {
-            m_streams.emplace_back(std::make_unique<DBLoadStream>(streamIndex, xChunkSize, m_chunk_processors));
-        }
-
+        m_stream_count = numStreams;
         m_chunk_size = xChunkSize;
         m_vanilla_buffer_size = 0;
+        m_lookahead_depth = DEFAULT_LOOKAHEAD_DEPTH;
 
         m_initialized_streams = false;
         m_current_stream = 0;
@@ -244,9 +399,19 @@ public:
         m_vanilla_buffer_offset = 0;
 
         m_eof_reached = false;
-        m_eof_stream = 0;
     }
 
+    ~ProcessorXChunksImpl()
+    {
+        // Streams must finish their pending work before the chunk processors they use are destroyed
+        m_streams.clear();
+    }
+
+    ProcessorXChunksImpl(const ProcessorXChunksImpl& other) = delete;
+    ProcessorXChunksImpl(ProcessorXChunksImpl&& other) noexcept = delete;
+    ProcessorXChunksImpl& operator=(const ProcessorXChunksImpl& other) = delete;
+    ProcessorXChunksImpl& operator=(ProcessorXChunksImpl&& other) noexcept = delete;
+
     ProcessorXChunksImpl(ProcessorXChunks* base, const int numStreams, const size_t xChunkSize, const size_t vanillaBufferSize)
         : ProcessorXChunksImpl(base, numStreams, xChunkSize)
     {
@@ -260,6 +425,14 @@ public:
         m_chunk_processors.emplace_back(std::move(streamProcessor));
     }
 
+    void SetLookaheadDepth(const size_t lookaheadDepth)
+    {
+        assert(!m_initialized_streams);
+        assert(lookaheadDepth > 0);
+
+        m_lookahead_depth = lookaheadDepth;
+    }
+
     size_t Load(void* buffer, const size_t length)
     {
         assert(buffer != nullptr);
@@ -300,6 +473,43 @@ public:
         return loadedSize;
     }
 
+    size_t LoadUntil(void* buffer, const size_t length, const uint8_t terminator)
+    {
+        assert(buffer != nullptr);
+
+        if (!m_initialized_streams)
+        {
+            InitStreams();
+        }
+
+        size_t loadedSize = 0;
+        while (!EndOfStream() && loadedSize < length)
+        {
+            auto* bufferPos = static_cast<uint8_t*>(buffer) + loadedSize;
+            const auto* chunkPos = &m_current_chunk[m_current_chunk_offset];
+            const size_t bytesToScan = std::min(length - loadedSize, m_current_chunk_size - m_current_chunk_offset);
+
+            // Scan the decoded chunk for the terminator and take over the whole run at once
+            const auto* terminatorPos = bytesToScan > 0 ? static_cast<const uint8_t*>(memchr(chunkPos, terminator, bytesToScan)) : nullptr;
+            const size_t runSize = terminatorPos ? static_cast<size_t>(terminatorPos - chunkPos) + 1 : bytesToScan;
+
+            if (runSize > 0)
+                memcpy(bufferPos, chunkPos, runSize);
+            loadedSize += runSize;
+            m_current_chunk_offset += runSize;
+
+            if (m_current_chunk_offset == m_current_chunk_size)
+            {
+                NextStream();
+            }
+
+            if (terminatorPos)
+                break;
+        }
+
+        return loadedSize;
+    }
+
     int64_t Pos() const
     {
         return m_base->m_base_stream->Pos();
@@ -327,11 +537,21 @@ void ProcessorXChunks::AddChunkProcessor(std::unique_ptr<IXChunkProcessor> chunk
     m_impl->AddChunkProcessor(std::move(chunkProcessor));
 }
 
+void ProcessorXChunks::SetLookaheadDepth(const size_t lookaheadDepth) const
+{
+    m_impl->SetLookaheadDepth(lookaheadDepth);
+}
+
 size_t ProcessorXChunks::Load(void* buffer, const size_t length)
 {
     return m_impl->Load(buffer, length);
 }
 
+size_t ProcessorXChunks::LoadUntil(void* buffer, const size_t length, const uint8_t terminator)
+{
+    return m_impl->LoadUntil(buffer, length, terminator);
+}
+
 int64_t ProcessorXChunks::Pos()
 {
     return m_impl->Pos();
@@ -10,12 +10,22 @@ class ProcessorXChunks : public StreamProcessor
     ProcessorXChunksImpl* m_impl;
 
 public:
+    static constexpr size_t DEFAULT_LOOKAHEAD_DEPTH = 4;
+
     ProcessorXChunks(int numStreams, size_t xChunkSize);
     ProcessorXChunks(int numStreams, size_t xChunkSize, size_t vanillaBufferSize);
     ~ProcessorXChunks() override;
 
     size_t Load(void* buffer, size_t length) override;
+    size_t LoadUntil(void* buffer, size_t length, uint8_t terminator) override;
     int64_t Pos() override;
 
     void AddChunkProcessor(std::unique_ptr<IXChunkProcessor> chunkProcessor) const;
+
+    /**
+     * \brief Sets the amount of chunks per stream that are read and processed ahead of the consumer.
+     * Must be called before the first load.
+     * \param lookaheadDepth The amount of chunks per stream to keep in flight.
+     */
+    void SetLookaheadDepth(size_t lookaheadDepth) const;
 };
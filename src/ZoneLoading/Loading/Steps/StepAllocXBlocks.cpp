@@ -22,6 +22,8 @@ void StepAllocXBlocks::PerformStep(ZoneLoader* zoneLoader, ILoadingStream* strea
         throw InvalidXBlockSizeException(totalMemory, MAX_XBLOCK_SIZE);
     }
 
+    zoneLoader->OnAllocatingBlocks(totalMemory);
+
     for (unsigned int block = 0; block < blockCount; block++)
     {
         zoneLoader->m_blocks[block]->Alloc(blockSizes[block]);
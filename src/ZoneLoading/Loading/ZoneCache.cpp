@@ -0,0 +1,198 @@
+#include "ZoneCache.h"
+
+#include "Crypto.h"
+#include "LoadingMappedFileStream.h"
+
+#include <cstdint>
+#include <format>
+#include <random>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    // Increase whenever the layout of cached data changes to invalidate old entries
+    constexpr uint32_t CACHE_VERSION = 2;
+
+    // Keys only hash the start of a fastfile, which avoids reading the whole fastfile when there is no entry for it yet
+    constexpr size_t KEY_HEADER_SIZE = 0x1000;
+
+    constexpr size_t HASH_READ_BUFFER_SIZE = 0x100000;
+
+    std::string FinishHash(IHashFunction& hash)
+    {
+        const auto hashSize = hash.GetHashSize();
+        const auto hashValue = std::make_unique<uint8_t[]>(hashSize);
+        hash.Finish(hashValue.get());
+
+        std::ostringstream ss;
+        for (auto i = 0u; i < hashSize; i++)
+            ss << std::format("{:02x}", hashValue[i]);
+
+        return ss.str();
+    }
+} // namespace
+
+ZoneCache::Entry::Entry(fs::path tempPath, fs::path finalPath)
+    : m_temp_path(std::move(tempPath)),
+      m_final_path(std::move(finalPath)),
+      m_stream(m_temp_path, std::ios::out | std::ios::binary | std::ios::trunc),
+      m_committed(false)
+{
+}
+
+ZoneCache::Entry::~Entry()
+{
+    if (m_committed)
+        return;
+
+    if (m_stream.is_open())
+        m_stream.close();
+
+    std::error_code ec;
+    fs::remove(m_temp_path, ec);
+}
+
+bool ZoneCache::Entry::IsOpen() const
+{
+    return m_stream.is_open();
+}
+
+std::ostream& ZoneCache::Entry::Stream()
+{
+    return m_stream;
+}
+
+bool ZoneCache::Entry::Commit()
+{
+    m_stream.close();
+    if (m_stream.fail())
+        return false;
+
+    // Renaming makes the entry appear atomically for concurrent runs using the same cache
+    std::error_code ec;
+    fs::rename(m_temp_path, m_final_path, ec);
+    if (ec)
+        return false;
+
+    m_committed = true;
+    return true;
+}
+
+ZoneCache::ZoneCache(fs::path cacheDirectory)
+    : m_cache_directory(std::move(cacheDirectory))
+{
+}
+
+bool ZoneCache::ComputeKey(const std::string& fastFilePath, std::string& key)
+{
+    std::error_code ec;
+    const auto fileSize = fs::file_size(fastFilePath, ec);
+    if (ec)
+        return false;
+
+    const auto lastWriteTime = fs::last_write_time(fastFilePath, ec);
+    if (ec)
+        return false;
+
+    std::ifstream file(fastFilePath, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    const auto hash = Crypto::CreateSHA1();
+    hash->Init();
+
+    const uint64_t keyFields[]{
+        CACHE_VERSION,
+        static_cast<uint64_t>(fileSize),
+        static_cast<uint64_t>(lastWriteTime.time_since_epoch().count()),
+    };
+    hash->Process(keyFields, sizeof(keyFields));
+
+    char header[KEY_HEADER_SIZE];
+    file.read(header, sizeof(header));
+    if (file.gcount() > 0)
+        hash->Process(header, static_cast<size_t>(file.gcount()));
+
+    key = FinishHash(*hash);
+    return true;
+}
+
+bool ZoneCache::ComputeContentHash(const std::string& fastFilePath, std::string& contentHash)
+{
+    std::ifstream file(fastFilePath, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    const auto hash = Crypto::CreateSHA1();
+    hash->Init();
+
+    const auto buffer = std::make_unique<char[]>(HASH_READ_BUFFER_SIZE);
+    while (file.read(buffer.get(), HASH_READ_BUFFER_SIZE) || file.gcount() > 0)
+        hash->Process(buffer.get(), static_cast<size_t>(file.gcount()));
+
+    if (file.bad())
+        return false;
+
+    contentHash = FinishHash(*hash);
+    return true;
+}
+
+std::unique_ptr<ILoadingStream> ZoneCache::Open(const std::string& zoneName, const std::string& key, const std::string& fastFilePath) const
+{
+    // Entries are only ever replaced by renaming a new file over them, so a mapped entry is never truncated
+    const auto entryPath = GetEntryPath(zoneName, key);
+    auto stream = LoadingMappedFileStream::Open(entryPath.string());
+    if (!stream)
+        return nullptr;
+
+    // The key only covers size, modification time and the start of the fastfile, which stay the same for some edits of unsigned zones.
+    // Now that there is an entry, the whole fastfile is hashed to make sure it is still the one the entry was created from.
+    std::string contentHash;
+    if (!ComputeContentHash(fastFilePath, contentHash))
+        return nullptr;
+
+    std::string entryContentHash(contentHash.size(), '\0');
+    if (stream->Load(entryContentHash.data(), entryContentHash.size()) != entryContentHash.size() || entryContentHash != contentHash)
+    {
+        stream.reset();
+
+        std::error_code ec;
+        fs::remove(entryPath, ec);
+        return nullptr;
+    }
+
+    return stream;
+}
+
+void ZoneCache::Remove(const std::string& zoneName, const std::string& key) const
+{
+    std::error_code ec;
+    fs::remove(GetEntryPath(zoneName, key), ec);
+}
+
+std::unique_ptr<ZoneCache::Entry> ZoneCache::Create(const std::string& zoneName, const std::string& key, const std::string& contentHash) const
+{
+    std::error_code ec;
+    fs::create_directories(m_cache_directory, ec);
+    if (ec)
+        return nullptr;
+
+    const auto finalPath = GetEntryPath(zoneName, key);
+    auto tempPath = finalPath;
+    tempPath += std::format(".{:08x}.tmp", std::random_device()());
+
+    auto entry = std::make_unique<Entry>(std::move(tempPath), finalPath);
+    if (!entry->IsOpen())
+        return nullptr;
+
+    entry->Stream().write(contentHash.data(), static_cast<std::streamsize>(contentHash.size()));
+
+    return entry;
+}
+
+fs::path ZoneCache::GetEntryPath(const std::string& zoneName, const std::string& key) const
+{
+    return m_cache_directory / std::format("{}_{}{}", zoneName, key, CACHE_FILE_EXTENSION);
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "ILoadingStream.h"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+/**
+ * \brief A disk cache of the plain XFile data of zones that allows skipping decryption and decompression when loading the same zone again.
+ * Entries are keyed by the size, modification time and a hash of the start of the fastfile they were created from.
+ * Each entry also stores a hash of the whole fastfile, which is only computed once an entry with a matching key exists.
+ */
+class ZoneCache
+{
+public:
+    static constexpr auto CACHE_FILE_EXTENSION = ".xfile";
+
+    class Entry
+    {
+        std::filesystem::path m_temp_path;
+        std::filesystem::path m_final_path;
+        std::ofstream m_stream;
+        bool m_committed;
+
+    public:
+        Entry(std::filesystem::path tempPath, std::filesystem::path finalPath);
+        ~Entry();
+        Entry(const Entry& other) = delete;
+        Entry(Entry&& other) noexcept = delete;
+        Entry& operator=(const Entry& other) = delete;
+        Entry& operator=(Entry&& other) noexcept = delete;
+
+        [[nodiscard]] bool IsOpen() const;
+        [[nodiscard]] std::ostream& Stream();
+
+        /**
+         * \brief Makes the entry available to future loads. Entries that are not committed are discarded.
+         * \return \c true if the entry was committed successfully, otherwise \c false.
+         */
+        bool Commit();
+    };
+
+    explicit ZoneCache(std::filesystem::path cacheDirectory);
+
+    /**
+     * \brief Computes the cache key of a fastfile.
+     * \param fastFilePath The path of the fastfile.
+     * \param key Receives the key of the fastfile.
+     * \return \c true if the key could be computed, otherwise \c false.
+     */
+    static bool ComputeKey(const std::string& fastFilePath, std::string& key);
+
+    /**
+     * \brief Computes a hash of the whole content of a fastfile.
+     * \param fastFilePath The path of the fastfile.
+     * \param contentHash Receives the hash of the fastfile.
+     * \return \c true if the hash could be computed, otherwise \c false.
+     */
+    static bool ComputeContentHash(const std::string& fastFilePath, std::string& contentHash);
+
+    /**
+     * \brief Opens the cached plain XFile data of a zone.
+     * An entry that was created from a fastfile with different content is removed.
+     * \param fastFilePath The path of the fastfile, which is hashed completely if there is an entry for the key.
+     * \return A stream of the cached data or \c nullptr if there is no up to date cache entry for the key.
+     */
+    [[nodiscard]] std::unique_ptr<ILoadingStream> Open(const std::string& zoneName, const std::string& key, const std::string& fastFilePath) const;
+
+    /**
+     * \brief Removes the cache entry of a zone, i.e. when its data turned out to be corrupt.
+     * The stream of the entry must be closed before removing it.
+     */
+    void Remove(const std::string& zoneName, const std::string& key) const;
+
+    /**
+     * \brief Creates a new cache entry to write the plain XFile data of a zone to.
+     * \param contentHash The hash of the whole fastfile the entry is created from.
+     * \return The new entry or \c nullptr if it could not be created.
+     */
+    [[nodiscard]] std::unique_ptr<Entry> Create(const std::string& zoneName, const std::string& key, const std::string& contentHash) const;
+
+private:
+    [[nodiscard]] std::filesystem::path GetEntryPath(const std::string& zoneName, const std::string& key) const;
+
+    std::filesystem::path m_cache_directory;
+};
@@ -1,27 +1,39 @@
 #include "ZoneLoader.h"
 
 #include "Exception/LoadingException.h"
+#include "LoadingCaptureStream.h"
 #include "LoadingFileStream.h"
+#include "Utils/TypeName.h"
+#include "ZoneLoadingProfile.h"
 
 #include <algorithm>
+#include <optional>
 
 ZoneLoader::ZoneLoader(std::unique_ptr<Zone> zone)
     : m_processor_chain_dirty(false),
+      m_xfile_start_step(0),
+      m_xfile_end_step(SIZE_MAX),
+      m_xfile_capture(nullptr),
       m_zone(std::move(zone))
 {
 }
 
 ILoadingStream* ZoneLoader::BuildLoadingChain(ILoadingStream* rootStream)
 {
-    auto* currentStream = rootStream;
+    // When profiling, every link of the chain is wrapped to account its time and bytes
+    auto* profile = ZoneLoadingProfile::Active();
+    auto* currentStream = profile ? profile->WrapStream(rootStream) : rootStream;
 
     for (const auto& processor : m_processors)
     {
         processor->SetBaseStream(currentStream);
 
-        currentStream = processor.get();
+        currentStream = profile ? profile->WrapStream(processor.get()) : processor.get();
     }
 
+    if (profile)
+        profile->SetEndStream(currentStream);
+
     m_processor_chain_dirty = false;
     return currentStream;
 }
@@ -63,20 +75,92 @@ void ZoneLoader::RemoveStreamProcessor(StreamProcessor* streamProcessor)
     }
 }
 
+void ZoneLoader::MarkXFileStart()
+{
+    m_xfile_start_step = m_steps.size();
+}
+
+void ZoneLoader::MarkXFileEnd()
+{
+    m_xfile_end_step = m_steps.size();
+}
+
+void ZoneLoader::SetXFileCapture(std::ostream* capture)
+{
+    m_xfile_capture = capture;
+}
+
+void ZoneLoader::SetBlockAllocationCallback(std::function<void(uint64_t totalSize)> callback)
+{
+    m_block_allocation_callback = std::move(callback);
+}
+
+void ZoneLoader::OnAllocatingBlocks(const uint64_t totalSize) const
+{
+    if (m_block_allocation_callback)
+        m_block_allocation_callback(totalSize);
+}
+
 std::unique_ptr<Zone> ZoneLoader::LoadZone(std::istream& stream)
 {
     LoadingFileStream fileStream(stream);
-    auto* endStream = BuildLoadingChain(&fileStream);
+    return LoadZone(fileStream);
+}
+
+std::unique_ptr<Zone> ZoneLoader::LoadZone(ILoadingStream& rootStream)
+{
+    return PerformSteps(rootStream, 0, m_steps.size());
+}
+
+std::unique_ptr<Zone> ZoneLoader::LoadZoneFromXFile(ILoadingStream& xFileStream)
+{
+    m_processors.clear();
+
+    return PerformSteps(xFileStream, m_xfile_start_step, std::min(m_xfile_end_step, m_steps.size()));
+}
+
+std::unique_ptr<Zone> ZoneLoader::PerformSteps(ILoadingStream& rootStream, const size_t startStep, const size_t endStep)
+{
+    auto* endStream = BuildLoadingChain(&rootStream);
+    std::optional<LoadingCaptureStream> captureStream;
 
     try
     {
-        for (const auto& step : m_steps)
+        for (auto stepIndex = startStep; stepIndex < endStep; stepIndex++)
         {
+            // Everything loaded by the XFile steps is the plain XFile data that can be captured
+            if (m_xfile_capture && stepIndex == m_xfile_start_step)
+            {
+                captureStream.emplace(endStream, *m_xfile_capture);
+                endStream = &*captureStream;
+            }
+            else if (captureStream && stepIndex == m_xfile_end_step)
+            {
+                endStream = BuildLoadingChain(&rootStream);
+                captureStream.reset();
+            }
+
+            auto* profile = ZoneLoadingProfile::Active();
+            const auto stepStart = ZoneLoadingProfile::clock_t::now();
+
+            const auto& step = m_steps[stepIndex];
             step->PerformStep(this, endStream);
 
+            if (profile)
+            {
+                profile->AddStep(utils::GetTypeName(typeid(*step)),
+                                 std::chrono::duration_cast<ZoneLoadingProfile::duration_t>(ZoneLoadingProfile::clock_t::now() - stepStart));
+            }
+
             if (m_processor_chain_dirty)
             {
-                endStream = BuildLoadingChain(&fileStream);
+                endStream = BuildLoadingChain(&rootStream);
+
+                if (captureStream)
+                {
+                    captureStream->SetBaseStream(endStream);
+                    endStream = &*captureStream;
+                }
             }
         }
     }
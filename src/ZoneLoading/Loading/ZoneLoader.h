@@ -5,8 +5,11 @@
 #include "Zone/XBlock.h"
 #include "Zone/Zone.h"
 
+#include <cstdint>
+#include <functional>
 #include <istream>
 #include <memory>
+#include <ostream>
 #include <vector>
 
 class ILoadingStep;
@@ -18,9 +21,15 @@ class ZoneLoader
 
     bool m_processor_chain_dirty;
 
+    size_t m_xfile_start_step;
+    size_t m_xfile_end_step;
+    std::ostream* m_xfile_capture;
+    std::function<void(uint64_t)> m_block_allocation_callback;
+
     std::unique_ptr<Zone> m_zone;
 
     ILoadingStream* BuildLoadingChain(ILoadingStream* rootStream);
+    std::unique_ptr<Zone> PerformSteps(ILoadingStream& rootStream, size_t startStep, size_t endStep);
 
 public:
     std::vector<XBlock*> m_blocks;
@@ -33,5 +42,37 @@ public:
 
     void RemoveStreamProcessor(StreamProcessor* streamProcessor);
 
+    /**
+     * \brief Marks the loading steps added from now on as the ones loading the plain XFile data of the zone.
+     */
+    void MarkXFileStart();
+
+    /**
+     * \brief Marks the end of the loading steps that load the plain XFile data of the zone.
+     */
+    void MarkXFileEnd();
+
+    /**
+     * \brief Sets a stream to write all plain XFile data to while it is loaded.
+     * \param capture The stream to write the data to or \c nullptr to not capture anything.
+     */
+    void SetXFileCapture(std::ostream* capture);
+
+    /**
+     * \brief Sets a function that is called with the combined size of all XBlocks of the zone right before they are allocated.
+     */
+    void SetBlockAllocationCallback(std::function<void(uint64_t totalSize)> callback);
+
+    void OnAllocatingBlocks(uint64_t totalSize) const;
+
     std::unique_ptr<Zone> LoadZone(std::istream& stream);
+    std::unique_ptr<Zone> LoadZone(ILoadingStream& rootStream);
+
+    /**
+     * \brief Loads the zone from its plain XFile data that was previously captured.
+     * Only the XFile loading steps are performed which means no decryption, decompression or verification takes place.
+     * \param xFileStream A stream of the plain XFile data.
+     * \return The loaded zone or \c nullptr if loading failed.
+     */
+    std::unique_ptr<Zone> LoadZoneFromXFile(ILoadingStream& xFileStream);
 };
@@ -0,0 +1,293 @@
+#include "ZoneLoadingProfile.h"
+
+#include "Utils/TypeName.h"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <nlohmann/json.hpp>
+
+using namespace nlohmann;
+
+namespace
+{
+    thread_local ZoneLoadingProfile* activeProfile = nullptr;
+
+    double ToMilliseconds(const ZoneLoadingProfile::duration_t duration)
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    // Microseconds are precise enough and keep the numbers short
+    double ToJsonMilliseconds(const ZoneLoadingProfile::duration_t duration)
+    {
+        return std::round(ToMilliseconds(duration) * 1000.0) / 1000.0;
+    }
+} // namespace
+
+ZoneLoadingProfile::ProfilingStream::ProfilingStream(ZoneLoadingProfile& profile, StreamEntry& entry, ILoadingStream* baseStream)
+    : m_profile(profile),
+      m_entry(entry),
+      m_base_stream(baseStream)
+{
+}
+
+template<typename Func> auto ZoneLoadingProfile::ProfilingStream::Measure(Func&& func)
+{
+    const auto outerNestedTime = m_profile.m_nested_time;
+    m_profile.m_nested_time = duration_t::zero();
+
+    const auto start = clock_t::now();
+    auto result = func();
+    const auto elapsed = std::chrono::duration_cast<duration_t>(clock_t::now() - start);
+
+    m_entry.m_time += elapsed - m_profile.m_nested_time;
+    m_profile.m_nested_time = outerNestedTime + elapsed;
+
+    return result;
+}
+
+size_t ZoneLoadingProfile::ProfilingStream::Load(void* buffer, const size_t length)
+{
+    const auto loadedSize = Measure(
+        [this, buffer, length]
+        {
+            return m_base_stream->Load(buffer, length);
+        });
+    m_entry.m_bytes += loadedSize;
+
+    return loadedSize;
+}
+
+size_t ZoneLoadingProfile::ProfilingStream::LoadUntil(void* buffer, const size_t length, const uint8_t terminator)
+{
+    const auto loadedSize = Measure(
+        [this, buffer, length, terminator]
+        {
+            return m_base_stream->LoadUntil(buffer, length, terminator);
+        });
+    m_entry.m_bytes += loadedSize;
+
+    return loadedSize;
+}
+
+int64_t ZoneLoadingProfile::ProfilingStream::Pos()
+{
+    return m_base_stream->Pos();
+}
+
+bool ZoneLoadingProfile::ProfilingStream::SupportsInPlaceLoading()
+{
+    return m_base_stream->SupportsInPlaceLoading();
+}
+
+std::span<const uint8_t> ZoneLoadingProfile::ProfilingStream::LoadInPlace(const size_t length)
+{
+    const auto data = Measure(
+        [this, length]
+        {
+            return m_base_stream->LoadInPlace(length);
+        });
+    m_entry.m_bytes += data.size();
+
+    return data;
+}
+
+ZoneLoadingProfile::AssetScope::AssetScope(const Zone* zone, const asset_type_t assetType)
+    : m_profile(activeProfile),
+      m_asset_type(assetType),
+      m_zone(zone),
+      m_start_bytes(0)
+{
+    if (!m_profile)
+        return;
+
+    m_start = clock_t::now();
+    m_start_bytes = m_profile->GetEndStreamBytes();
+}
+
+ZoneLoadingProfile::AssetScope::~AssetScope()
+{
+    if (!m_profile || m_asset_type < 0)
+        return;
+
+    const auto elapsed = std::chrono::duration_cast<duration_t>(clock_t::now() - m_start);
+
+    auto& assetTypes = m_profile->m_asset_types;
+    if (static_cast<size_t>(m_asset_type) >= assetTypes.size())
+        assetTypes.resize(static_cast<size_t>(m_asset_type) + 1u);
+
+    auto& entry = assetTypes[m_asset_type];
+    if (entry.m_name.empty())
+    {
+        const auto assetTypeName = m_zone->m_pools->GetAssetTypeName(m_asset_type);
+        entry.m_name = assetTypeName ? *assetTypeName : std::format("type_{}", m_asset_type);
+    }
+
+    entry.m_time += elapsed;
+    entry.m_count++;
+    entry.m_bytes += m_profile->GetEndStreamBytes() - m_start_bytes;
+}
+
+ZoneLoadingProfile::Activation::Activation(ZoneLoadingProfile& profile)
+    : m_previous(activeProfile)
+{
+    activeProfile = &profile;
+}
+
+ZoneLoadingProfile::Activation::~Activation()
+{
+    activeProfile = m_previous;
+}
+
+ZoneLoadingProfile::ZoneLoadingProfile(std::string zoneName)
+    : m_zone_name(std::move(zoneName)),
+      m_total_time(0),
+      m_end_stream_entry(nullptr),
+      m_nested_time(0)
+{
+}
+
+ZoneLoadingProfile* ZoneLoadingProfile::Active()
+{
+    return activeProfile;
+}
+
+void ZoneLoadingProfile::SetTotalTime(const duration_t totalTime)
+{
+    m_total_time = totalTime;
+}
+
+void ZoneLoadingProfile::AddStep(std::string name, const duration_t time)
+{
+    m_steps.emplace_back(std::move(name), time);
+}
+
+ILoadingStream* ZoneLoadingProfile::WrapStream(ILoadingStream* stream)
+{
+    auto name = utils::GetTypeName(typeid(*stream));
+
+    const auto existingRegistration = std::ranges::find_if(m_streams,
+                                                           [stream, &name](const StreamRegistration& registration)
+                                                           {
+                                                               return registration.m_stream == stream && registration.m_entry->m_name == name;
+                                                           });
+    if (existingRegistration != m_streams.end())
+        return existingRegistration->m_profiling_stream.get();
+
+    auto entry = std::make_unique<StreamEntry>();
+    entry->m_name = std::move(name);
+    auto profilingStream = std::make_unique<ProfilingStream>(*this, *entry, stream);
+    auto* result = profilingStream.get();
+
+    m_streams.emplace_back(stream, std::move(entry), std::move(profilingStream));
+
+    return result;
+}
+
+void ZoneLoadingProfile::SetEndStream(ILoadingStream* stream)
+{
+    m_end_stream_entry = nullptr;
+
+    for (const auto& registration : m_streams)
+    {
+        if (registration.m_profiling_stream.get() == stream)
+        {
+            m_end_stream_entry = registration.m_entry.get();
+            break;
+        }
+    }
+}
+
+uint64_t ZoneLoadingProfile::GetEndStreamBytes() const
+{
+    return m_end_stream_entry ? m_end_stream_entry->m_bytes : 0u;
+}
+
+void ZoneLoadingProfile::PrintText(std::ostream& stream) const
+{
+    stream << std::format("Profile of loading zone '{}': {:.2f}ms\n", m_zone_name, ToMilliseconds(m_total_time));
+
+    stream << "  Steps:\n";
+    for (const auto& step : m_steps)
+        stream << std::format("    {:<40} {:>12.2f}ms\n", step.m_name, ToMilliseconds(step.m_time));
+
+    stream << "  Streams:\n";
+    for (const auto& registration : m_streams)
+    {
+        const auto& entry = *registration.m_entry;
+        stream << std::format("    {:<40} {:>12.2f}ms {:>14} bytes\n", entry.m_name, ToMilliseconds(entry.m_time), entry.m_bytes);
+    }
+
+    std::vector<const AssetTypeEntry*> assetTypes;
+    for (const auto& assetType : m_asset_types)
+    {
+        if (assetType.m_count > 0)
+            assetTypes.emplace_back(&assetType);
+    }
+
+    std::ranges::sort(assetTypes,
+                      [](const AssetTypeEntry* e1, const AssetTypeEntry* e2)
+                      {
+                          return e1->m_time > e2->m_time;
+                      });
+
+    stream << "  Asset types:\n";
+    for (const auto* assetType : assetTypes)
+    {
+        stream << std::format("    {:<40} {:>12.2f}ms {:>8} assets {:>14} bytes\n",
+                              assetType->m_name,
+                              ToMilliseconds(assetType->m_time),
+                              assetType->m_count,
+                              assetType->m_bytes);
+    }
+}
+
+void ZoneLoadingProfile::PrintJson(std::ostream& stream) const
+{
+    auto jSteps = json::array();
+    for (const auto& step : m_steps)
+    {
+        jSteps.emplace_back(json{
+            {"name", step.m_name},
+            {"ms", ToJsonMilliseconds(step.m_time)},
+        });
+    }
+
+    auto jStreams = json::array();
+    for (const auto& registration : m_streams)
+    {
+        const auto& entry = *registration.m_entry;
+        jStreams.emplace_back(json{
+            {"name", entry.m_name},
+            {"ms", ToJsonMilliseconds(entry.m_time)},
+            {"bytes", entry.m_bytes},
+        });
+    }
+
+    auto jAssetTypes = json::array();
+    for (const auto& assetType : m_asset_types)
+    {
+        if (assetType.m_count == 0)
+            continue;
+
+        jAssetTypes.emplace_back(json{
+            {"name", assetType.m_name},
+            {"ms", ToJsonMilliseconds(assetType.m_time)},
+            {"count", assetType.m_count},
+            {"bytes", assetType.m_bytes},
+        });
+    }
+
+    const json jRoot{
+        {"zone", m_zone_name},
+        {"totalMs", ToJsonMilliseconds(m_total_time)},
+        {"steps", std::move(jSteps)},
+        {"streams", std::move(jStreams)},
+        {"assetTypes", std::move(jAssetTypes)},
+    };
+
+    // One object per line, so profiles of several zones can be appended to the same file.
+    // Names are not guaranteed to be valid UTF-8, so invalid sequences are replaced instead of failing.
+    stream << jRoot.dump(-1, ' ', false, json::error_handler_t::replace) << "\n";
+}
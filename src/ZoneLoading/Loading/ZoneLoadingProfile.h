@@ -0,0 +1,149 @@
+#pragma once
+
+#include "ILoadingStream.h"
+#include "Zone/Zone.h"
+#include "Zone/ZoneTypes.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Collects where the time of loading a zone is spent.
+ * A profile is only collected for loads on the thread it was activated on.
+ */
+class ZoneLoadingProfile
+{
+public:
+    using clock_t = std::chrono::steady_clock;
+    using duration_t = std::chrono::nanoseconds;
+
+    class StepEntry
+    {
+    public:
+        std::string m_name;
+        duration_t m_time{};
+    };
+
+    class StreamEntry
+    {
+    public:
+        std::string m_name;
+        // Time spent inside this stream only, excluding the time spent in the streams it loads from
+        duration_t m_time{};
+        uint64_t m_bytes = 0;
+    };
+
+    class AssetTypeEntry
+    {
+    public:
+        std::string m_name;
+        duration_t m_time{};
+        size_t m_count = 0;
+        uint64_t m_bytes = 0;
+    };
+
+    /**
+     * \brief Forwards all loads to a stream of the loading chain while accounting time and bytes to a stream entry.
+     */
+    class ProfilingStream final : public ILoadingStream
+    {
+        ZoneLoadingProfile& m_profile;
+        StreamEntry& m_entry;
+        ILoadingStream* m_base_stream;
+
+    public:
+        ProfilingStream(ZoneLoadingProfile& profile, StreamEntry& entry, ILoadingStream* baseStream);
+
+        size_t Load(void* buffer, size_t length) override;
+        size_t LoadUntil(void* buffer, size_t length, uint8_t terminator) override;
+        int64_t Pos() override;
+        bool SupportsInPlaceLoading() override;
+        std::span<const uint8_t> LoadInPlace(size_t length) override;
+
+    private:
+        template<typename Func> auto Measure(Func&& func);
+    };
+
+    /**
+     * \brief Accounts the time and bytes loaded while it is alive to an asset type of the active profile.
+     * Does nothing when there is no active profile.
+     */
+    class AssetScope
+    {
+        ZoneLoadingProfile* m_profile;
+        asset_type_t m_asset_type;
+        const Zone* m_zone;
+        clock_t::time_point m_start;
+        uint64_t m_start_bytes;
+
+    public:
+        AssetScope(const Zone* zone, asset_type_t assetType);
+        ~AssetScope();
+        AssetScope(const AssetScope& other) = delete;
+        AssetScope(AssetScope&& other) noexcept = delete;
+        AssetScope& operator=(const AssetScope& other) = delete;
+        AssetScope& operator=(AssetScope&& other) noexcept = delete;
+    };
+
+    /**
+     * \brief Makes a profile the active profile of the current thread while it is alive.
+     */
+    class Activation
+    {
+        ZoneLoadingProfile* m_previous;
+
+    public:
+        explicit Activation(ZoneLoadingProfile& profile);
+        ~Activation();
+        Activation(const Activation& other) = delete;
+        Activation(Activation&& other) noexcept = delete;
+        Activation& operator=(const Activation& other) = delete;
+        Activation& operator=(Activation&& other) noexcept = delete;
+    };
+
+    explicit ZoneLoadingProfile(std::string zoneName);
+
+    [[nodiscard]] static ZoneLoadingProfile* Active();
+
+    void SetTotalTime(duration_t totalTime);
+    void AddStep(std::string name, duration_t time);
+
+    /**
+     * \brief Wraps a stream of the loading chain to account its time and bytes.
+     * Wrapping the same stream again continues accounting to the same entry.
+     */
+    ILoadingStream* WrapStream(ILoadingStream* stream);
+
+    /**
+     * \brief Marks the stream that the loading steps load from. Bytes of assets are accounted by the bytes loaded from it.
+     */
+    void SetEndStream(ILoadingStream* stream);
+
+    void PrintText(std::ostream& stream) const;
+    void PrintJson(std::ostream& stream) const;
+
+private:
+    class StreamRegistration
+    {
+    public:
+        const ILoadingStream* m_stream;
+        std::unique_ptr<StreamEntry> m_entry;
+        std::unique_ptr<ProfilingStream> m_profiling_stream;
+    };
+
+    [[nodiscard]] uint64_t GetEndStreamBytes() const;
+
+    std::string m_zone_name;
+    duration_t m_total_time;
+    std::vector<StepEntry> m_steps;
+    std::vector<StreamRegistration> m_streams;
+    std::vector<AssetTypeEntry> m_asset_types;
+    const StreamEntry* m_end_stream_entry;
+
+    // Time spent in nested stream loads that has not been accounted to the calling stream yet
+    duration_t m_nested_time;
+};
@@ -0,0 +1,37 @@
+#include "IZoneInputStream.h"
+
+#include "Loading/Exception/InvalidOffsetBlockException.h"
+#include "Loading/Exception/InvalidOffsetBlockOffsetException.h"
+
+#include <cassert>
+
+void IZoneInputStream::InitBlockRanges(const std::vector<XBlock*>& blocks, const int blockBitCount)
+{
+    assert(blockBitCount > 0 && blockBitCount < static_cast<int>(sizeof(uintptr_t) * 8));
+    const auto blockNumCount = static_cast<size_t>(1) << blockBitCount;
+    assert(blocks.size() <= blockNumCount);
+
+    m_block_shift = static_cast<unsigned>(sizeof(uintptr_t) * 8 - blockBitCount);
+    m_block_offset_mask = UINTPTR_MAX >> blockBitCount;
+
+    m_block_ranges.clear();
+    m_block_ranges.resize(blockNumCount);
+    for (auto i = 0u; i < blocks.size(); i++)
+    {
+        auto& range = m_block_ranges[i];
+        range.m_block = blocks[i];
+        range.m_base = blocks[i]->m_buffer;
+        range.m_size = blocks[i]->m_buffer_size;
+    }
+}
+
+void IZoneInputStream::ThrowInvalidOffset(const uintptr_t offsetInt) const
+{
+    const auto blockNum = static_cast<block_t>(offsetInt >> m_block_shift);
+    const auto& range = m_block_ranges[offsetInt >> m_block_shift];
+
+    if (range.m_block == nullptr)
+        throw InvalidOffsetBlockException(blockNum);
+
+    throw InvalidOffsetBlockOffsetException(range.m_block, static_cast<size_t>(offsetInt & m_block_offset_mask));
+}
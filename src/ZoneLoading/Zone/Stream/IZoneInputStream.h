@@ -1,12 +1,35 @@
 #pragma once
 
 #include "Zone/Stream/IZoneStream.h"
+#include "Zone/XBlock.h"
 
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 
 class IZoneInputStream : public IZoneStream
 {
+    class BlockRange
+    {
+    public:
+        XBlock* m_block = nullptr;
+        uint8_t* m_base = nullptr;
+        size_t m_size = 0;
+    };
+
+    // One entry for every block number that can be encoded in an offset. Entries of blocks that do not exist have a size of 0.
+    std::vector<BlockRange> m_block_ranges;
+    unsigned m_block_shift = 0;
+    uintptr_t m_block_offset_mask = 0;
+
+    [[noreturn]] void ThrowInvalidOffset(uintptr_t offsetInt) const;
+
+protected:
+    /**
+     * \brief Builds the table used for resolving offsets. Must be called after the buffers of all blocks have been allocated.
+     */
+    void InitBlockRanges(const std::vector<XBlock*>& blocks, int blockBitCount);
+
 public:
     virtual void* Alloc(unsigned align) = 0;
 
@@ -42,16 +65,40 @@ public:
         return reinterpret_cast<T**>(InsertPointer());
     }
 
-    virtual void* ConvertOffsetToPointer(const void* offset) = 0;
+    // Offsets are resolved for every pointer of a zone, so resolving them is inlined and only needs a single table lookup and bounds check.
+    void* ConvertOffsetToPointer(const void* offset) const
+    {
+        // -1 because otherwise Block 0 Offset 0 would be just 0 which is already used to signalize a nullptr.
+        // So all offsets are moved by 1.
+        const auto offsetInt = reinterpret_cast<uintptr_t>(offset) - 1u;
+        const auto& range = m_block_ranges[offsetInt >> m_block_shift];
+        const auto blockOffset = static_cast<size_t>(offsetInt & m_block_offset_mask);
+
+        if (blockOffset >= range.m_size) [[unlikely]]
+            ThrowInvalidOffset(offsetInt);
 
-    template<typename T> T* ConvertOffsetToPointer(T* offset)
+        return &range.m_base[blockOffset];
+    }
+
+    template<typename T> T* ConvertOffsetToPointer(T* offset) const
     {
         return static_cast<T*>(ConvertOffsetToPointer(static_cast<const void*>(offset)));
     }
 
-    virtual void* ConvertOffsetToAlias(const void* offset) = 0;
+    void* ConvertOffsetToAlias(const void* offset) const
+    {
+        // For details see ConvertOffsetToPointer
+        const auto offsetInt = reinterpret_cast<uintptr_t>(offset) - 1u;
+        const auto& range = m_block_ranges[offsetInt >> m_block_shift];
+        const auto blockOffset = static_cast<size_t>(offsetInt & m_block_offset_mask);
+
+        if (blockOffset + sizeof(void*) >= range.m_size) [[unlikely]]
+            ThrowInvalidOffset(offsetInt);
+
+        return *reinterpret_cast<void**>(&range.m_base[blockOffset]);
+    }
 
-    template<typename T> T* ConvertOffsetToAlias(T* offset)
+    template<typename T> T* ConvertOffsetToAlias(T* offset) const
     {
         return static_cast<T*>(ConvertOffsetToAlias(static_cast<const void*>(offset)));
     }
@@ -1,12 +1,9 @@
 #include "XBlockInputStream.h"
 
 #include "Loading/Exception/BlockOverflowException.h"
-#include "Loading/Exception/InvalidOffsetBlockException.h"
-#include "Loading/Exception/InvalidOffsetBlockOffsetException.h"
 #include "Loading/Exception/OutOfBlockBoundsException.h"
 
 #include <cassert>
-#include <cstring>
 
 XBlockInputStream::XBlockInputStream(std::vector<XBlock*>& blocks, ILoadingStream* stream, const int blockBitCount, const block_t insertBlock)
     : m_blocks(blocks)
@@ -16,7 +13,7 @@ XBlockInputStream::XBlockInputStream(std::vector<XBlock*>& blocks, ILoadingStrea
     const unsigned int blockCount = blocks.size();
     m_block_offsets = new size_t[blockCount]{0};
 
-    m_block_bit_count = blockBitCount;
+    InitBlockRanges(blocks, blockBitCount);
 
     assert(insertBlock >= 0 && insertBlock < static_cast<block_t>(blocks.size()));
     m_insert_block = blocks[insertBlock];
@@ -132,7 +129,9 @@ void XBlockInputStream::LoadDataInBlock(void* dst, const size_t size)
         break;
 
     case XBlock::Type::BLOCK_TYPE_RUNTIME:
-        memset(dst, 0, size);
+        // Block buffers are zero initialized and runtime blocks are never written to while loading,
+        // so the memory is already zero and its pages do not need to be touched
+        assert(size == 0 || (static_cast<const uint8_t*>(dst)[0] == 0 && static_cast<const uint8_t*>(dst)[size - 1] == 0));
         break;
 
     case XBlock::Type::BLOCK_TYPE_DELAY:
@@ -171,20 +170,15 @@ void XBlockInputStream::LoadNullTerminated(void* dst)
     // Theoretically ptr should always be at the current block offset.
     assert(dst == &block->m_buffer[m_block_offsets[block->m_index]]);
 
-    uint8_t byte;
-    size_t offset = reinterpret_cast<uint8_t*>(dst) - block->m_buffer;
-    do
-    {
-        if (offset >= block->m_buffer_size)
-        {
-            throw BlockOverflowException(block);
-        }
+    const size_t offset = static_cast<uint8_t*>(dst) - block->m_buffer;
+    const auto loadedSize = m_stream->LoadUntil(dst, block->m_buffer_size - offset, 0);
 
-        m_stream->Load(&byte, 1);
-        block->m_buffer[offset++] = byte;
-    } while (byte != 0);
+    if (loadedSize == 0 || block->m_buffer[offset + loadedSize - 1] != 0)
+    {
+        throw BlockOverflowException(block);
+    }
 
-    m_block_offsets[block->m_index] = offset;
+    m_block_offsets[block->m_index] = offset + loadedSize;
 }
 
 void** XBlockInputStream::InsertPointer()
@@ -206,50 +200,3 @@ void** XBlockInputStream::InsertPointer()
 
     return ptr;
 }
-
-void* XBlockInputStream::ConvertOffsetToPointer(const void* offset)
-{
-    // -1 because otherwise Block 0 Offset 0 would be just 0 which is already used to signalize a nullptr.
-    // So all offsets are moved by 1.
-    auto offsetInt = reinterpret_cast<uintptr_t>(offset) - 1;
-
-    const block_t blockNum = offsetInt >> (sizeof(offsetInt) * 8 - m_block_bit_count);
-    const size_t blockOffset = offsetInt & (UINTPTR_MAX >> m_block_bit_count);
-
-    if (blockNum < 0 || blockNum >= static_cast<block_t>(m_blocks.size()))
-    {
-        throw InvalidOffsetBlockException(blockNum);
-    }
-
-    XBlock* block = m_blocks[blockNum];
-
-    if (block->m_buffer_size <= blockOffset)
-    {
-        throw InvalidOffsetBlockOffsetException(block, blockOffset);
-    }
-
-    return &block->m_buffer[blockOffset];
-}
-
-void* XBlockInputStream::ConvertOffsetToAlias(const void* offset)
-{
-    // For details see ConvertOffsetToPointer
-    auto offsetInt = reinterpret_cast<uintptr_t>(offset) - 1;
-
-    const block_t blockNum = offsetInt >> (sizeof(offsetInt) * 8 - m_block_bit_count);
-    const size_t blockOffset = offsetInt & (UINTPTR_MAX >> m_block_bit_count);
-
-    if (blockNum < 0 || blockNum >= static_cast<block_t>(m_blocks.size()))
-    {
-        throw InvalidOffsetBlockException(blockNum);
-    }
-
-    XBlock* block = m_blocks[blockNum];
-
-    if (block->m_buffer_size <= blockOffset + sizeof(void*))
-    {
-        throw InvalidOffsetBlockOffsetException(block, blockOffset);
-    }
-
-    return *reinterpret_cast<void**>(&block->m_buffer[blockOffset]);
-}
@@ -16,7 +16,6 @@ class XBlockInputStream final : public IZoneInputStream
     std::stack<size_t> m_temp_offsets;
     ILoadingStream* m_stream;
 
-    int m_block_bit_count;
     XBlock* m_insert_block;
 
     void Align(unsigned align);
@@ -36,7 +35,4 @@ public:
     void LoadNullTerminated(void* dst) override;
 
     void** InsertPointer() override;
-
-    void* ConvertOffsetToPointer(const void* offset) override;
-    void* ConvertOffsetToAlias(const void* offset) override;
 };
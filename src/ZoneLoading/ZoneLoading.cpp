@@ -1,53 +1,187 @@
 #include "ZoneLoading.h"
 
 #include "Loading/IZoneLoaderFactory.h"
+#include "Loading/LoadingFileStream.h"
+#include "Loading/LoadingMappedFileStream.h"
+#include "Loading/ZoneCache.h"
 #include "Loading/ZoneLoader.h"
+#include "Loading/ZoneLoadingProfile.h"
 #include "Utils/ObjFileStream.h"
 
 #include <filesystem>
 #include <format>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 
 namespace fs = std::filesystem;
 
-std::unique_ptr<Zone> ZoneLoading::LoadZone(const std::string& path)
+ZoneLoading::Configuration_t ZoneLoading::Configuration;
+
+namespace
 {
-    auto zoneName = fs::path(path).filename().replace_extension().string();
-    std::ifstream file(path, std::fstream::in | std::fstream::binary);
+    // Zones may be loaded concurrently and their reports must not interleave in the profile file
+    std::mutex profileJsonMutex;
 
-    if (!file.is_open())
+    std::unique_ptr<ZoneLoader> CreateZoneLoader(ZoneHeader& header, std::string& zoneName)
     {
-        std::cerr << std::format("Could not open file '{}'.\n", path);
+        for (auto game = 0u; game < static_cast<unsigned>(GameId::COUNT); game++)
+        {
+            const auto* factory = IZoneLoaderFactory::GetZoneLoaderFactoryForGame(static_cast<GameId>(game));
+            auto zoneLoader = factory->CreateLoaderForHeader(header, zoneName);
+
+            if (zoneLoader)
+                return zoneLoader;
+        }
+
         return nullptr;
     }
 
-    ZoneHeader header{};
-    file.read(reinterpret_cast<char*>(&header), sizeof(header));
-    if (file.gcount() != sizeof(header))
+    std::unique_ptr<Zone> LoadZoneWithCache(std::unique_ptr<ZoneLoader> zoneLoader,
+                                            ILoadingStream& rootStream,
+                                            ZoneHeader& header,
+                                            const std::string& path,
+                                            std::string& zoneName,
+                                            const std::function<void(uint64_t)>& blockAllocationCallback)
     {
-        std::cerr << std::format("Failed to read zone header from file '{}'.\n", path);
-        return nullptr;
+        const ZoneCache cache(ZoneLoading::Configuration.CacheDirectory);
+
+        // A zone may fall back to loading from its fastfile after it already allocated its blocks from a corrupt cache entry.
+        // The blocks of the failed attempt are freed before the new ones are allocated, so they are only reported once.
+        auto blocksReported = false;
+        const auto reportBlocksOnce = [&blockAllocationCallback, &blocksReported](const uint64_t totalSize)
+        {
+            if (blocksReported || !blockAllocationCallback)
+                return;
+
+            blocksReported = true;
+            blockAllocationCallback(totalSize);
+        };
+        zoneLoader->SetBlockAllocationCallback(reportBlocksOnce);
+
+        std::string key;
+        if (!ZoneCache::ComputeKey(path, key))
+            return zoneLoader->LoadZone(rootStream);
+
+        if (auto cachedStream = cache.Open(zoneName, key, path))
+        {
+            if (ZoneLoading::Configuration.Verbose)
+                std::cout << std::format("Loading zone '{}' from cache\n", zoneName);
+
+            if (auto zone = zoneLoader->LoadZoneFromXFile(*cachedStream))
+                return zone;
+
+            std::cerr << std::format("Cache entry of zone '{}' is corrupt, loading the zone from its fastfile instead\n", zoneName);
+            cachedStream.reset();
+            cache.Remove(zoneName, key);
+
+            // The failed loader holds partially loaded data, so start over with a new one
+            zoneLoader = CreateZoneLoader(header, zoneName);
+            if (!zoneLoader)
+                return nullptr;
+
+            zoneLoader->SetBlockAllocationCallback(reportBlocksOnce);
+        }
+
+        std::string contentHash;
+        if (!ZoneCache::ComputeContentHash(path, contentHash))
+            return zoneLoader->LoadZone(rootStream);
+
+        const auto entry = cache.Create(zoneName, key, contentHash);
+        if (!entry)
+        {
+            std::cerr << std::format("Could not create cache entry for zone '{}'\n", zoneName);
+            return zoneLoader->LoadZone(rootStream);
+        }
+
+        // Only zones that loaded and verified successfully are committed to the cache
+        zoneLoader->SetXFileCapture(&entry->Stream());
+        auto zone = zoneLoader->LoadZone(rootStream);
+        zoneLoader->SetXFileCapture(nullptr);
+
+        if (zone && !entry->Commit())
+            std::cerr << std::format("Could not write cache entry for zone '{}'\n", zoneName);
+
+        return zone;
     }
 
-    std::unique_ptr<ZoneLoader> zoneLoader;
-    for (auto game = 0u; game < static_cast<unsigned>(GameId::COUNT); game++)
+    std::unique_ptr<Zone> LoadZoneUnprofiled(const std::string& path, std::string zoneName, const std::function<void(uint64_t)>& blockAllocationCallback)
     {
-        const auto* factory = IZoneLoaderFactory::GetZoneLoaderFactoryForGame(static_cast<GameId>(game));
-        zoneLoader = factory->CreateLoaderForHeader(header, zoneName);
+        // Prefer mapping the file into memory so processors can read from it in place and fall back to regular file io otherwise.
+        // A fastfile that is truncated while it is mapped, i.e. by a linker rewriting it, terminates the process with SIGBUS on POSIX systems.
+        std::ifstream file;
+        std::unique_ptr<ILoadingStream> rootStream = LoadingMappedFileStream::Open(path);
+        if (!rootStream)
+        {
+            file.open(path, std::fstream::in | std::fstream::binary);
 
-        if (zoneLoader)
-            break;
+            if (!file.is_open())
+            {
+                std::cerr << std::format("Could not open file '{}'.\n", path);
+                return nullptr;
+            }
+
+            rootStream = std::make_unique<LoadingFileStream>(file);
+        }
+
+        ZoneHeader header{};
+        if (rootStream->Load(&header, sizeof(header)) != sizeof(header))
+        {
+            std::cerr << std::format("Failed to read zone header from file '{}'.\n", path);
+            return nullptr;
+        }
+
+        auto zoneLoader = CreateZoneLoader(header, zoneName);
+        if (!zoneLoader)
+        {
+            std::cerr << std::format("Could not create factory for zone '{}'.\n", zoneName);
+            return nullptr;
+        }
+
+        if (!ZoneLoading::Configuration.CacheDirectory.empty())
+            return LoadZoneWithCache(std::move(zoneLoader), *rootStream, header, path, zoneName, blockAllocationCallback);
+
+        zoneLoader->SetBlockAllocationCallback(blockAllocationCallback);
+
+        auto loadedZone = zoneLoader->LoadZone(*rootStream);
+
+        return std::move(loadedZone);
     }
+} // namespace
 
-    if (!zoneLoader)
+std::unique_ptr<Zone> ZoneLoading::LoadZone(const std::string& path)
+{
+    return LoadZone(path, nullptr);
+}
+
+std::unique_ptr<Zone> ZoneLoading::LoadZone(const std::string& path, const std::function<void(uint64_t totalSize)>& blockAllocationCallback)
+{
+    auto zoneName = fs::path(path).filename().replace_extension().string();
+
+    if (!Configuration.Profile && Configuration.ProfileJsonPath.empty())
+        return LoadZoneUnprofiled(path, zoneName, blockAllocationCallback);
+
+    ZoneLoadingProfile profile(zoneName);
+    std::unique_ptr<Zone> zone;
     {
-        std::cerr << std::format("Could not create factory for zone '{}'.\n", zoneName);
-        return nullptr;
+        ZoneLoadingProfile::Activation activation(profile);
+        const auto start = ZoneLoadingProfile::clock_t::now();
+        zone = LoadZoneUnprofiled(path, zoneName, blockAllocationCallback);
+        profile.SetTotalTime(std::chrono::duration_cast<ZoneLoadingProfile::duration_t>(ZoneLoadingProfile::clock_t::now() - start));
     }
 
-    auto loadedZone = zoneLoader->LoadZone(file);
+    if (Configuration.Profile)
+        profile.PrintText(std::cout);
+
+    if (!Configuration.ProfileJsonPath.empty())
+    {
+        std::lock_guard lock(profileJsonMutex);
+        std::ofstream jsonFile(Configuration.ProfileJsonPath, std::ios::out | std::ios::app);
+        if (jsonFile.is_open())
+            profile.PrintJson(jsonFile);
+        else
+            std::cerr << std::format("Could not open profile output file '{}'\n", Configuration.ProfileJsonPath);
+    }
 
-    file.close();
-    return std::move(loadedZone);
+    return zone;
 }
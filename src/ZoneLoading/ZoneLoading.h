@@ -1,10 +1,35 @@
 #pragma once
 #include "Zone/Zone.h"
 
+#include <cstdint>
+#include <functional>
 #include <string>
 
 class ZoneLoading
 {
 public:
+    static class Configuration_t
+    {
+    public:
+        bool Verbose = false;
+
+        // Directory to cache the plain XFile data of loaded zones in. Caching is disabled when empty.
+        std::string CacheDirectory;
+
+        // Prints a report of where the time of loading each zone was spent
+        bool Profile = false;
+
+        // File to append a report of each zone load to as one JSON object per line. Disabled when empty.
+        std::string ProfileJsonPath;
+
+    } Configuration;
+
     static std::unique_ptr<Zone> LoadZone(const std::string& path);
+
+    /**
+     * \brief Loads a zone and reports the memory it needs before allocating it.
+     * \param blockAllocationCallback Is called on the loading thread with the combined size of the XBlocks of the zone right before they are allocated.
+     * Can block to limit how much memory zones that are loaded at the same time take up.
+     */
+    static std::unique_ptr<Zone> LoadZone(const std::string& path, const std::function<void(uint64_t totalSize)>& blockAllocationCallback);
 };
@@ -52,6 +52,7 @@ function ZoneWriting:project()
         Crypto:include(includes)
         Utils:include(includes)
 		zlib:include(includes)
+		json:include(includes)
 		ZoneCode:include(includes)
 
 		ZoneCode:use()
@@ -15,6 +15,7 @@
 #include "Writing/Steps/StepWriteZoneSizes.h"
 
 #include <cstring>
+#include <zlib.h>
 
 using namespace IW4;
 
@@ -57,7 +58,12 @@ namespace
     }
 }; // namespace
 
-std::unique_ptr<ZoneWriter> ZoneWriterFactory::CreateWriter(Zone* zone) const
+int ZoneWriterFactory::GetReleaseCompressionLevel() const
+{
+    return Z_DEFAULT_COMPRESSION;
+}
+
+std::unique_ptr<ZoneWriter> ZoneWriterFactory::CreateWriter(Zone* zone, const int compressionLevel) const
 {
     auto writer = std::make_unique<ZoneWriter>();
 
@@ -80,7 +86,7 @@ std::unique_ptr<ZoneWriter> ZoneWriterFactory::CreateWriter(Zone* zone) const
     // Write timestamp
     writer->AddWritingStep(std::make_unique<StepWriteTimestamp>());
 
-    writer->AddWritingStep(std::make_unique<StepAddOutputProcessor>(std::make_unique<OutputProcessorDeflate>()));
+    writer->AddWritingStep(std::make_unique<StepAddOutputProcessor>(std::make_unique<OutputProcessorDeflate>(compressionLevel)));
 
     // Start of the XFile struct
     writer->AddWritingStep(std::make_unique<StepWriteZoneSizes>(contentInMemoryPtr));
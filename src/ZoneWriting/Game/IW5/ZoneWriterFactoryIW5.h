@@ -9,6 +9,7 @@ namespace IW5
     class ZoneWriterFactory final : public IZoneWriterFactory
     {
     public:
-        _NODISCARD std::unique_ptr<ZoneWriter> CreateWriter(Zone* zone) const override;
+        _NODISCARD int GetReleaseCompressionLevel() const override;
+        _NODISCARD std::unique_ptr<ZoneWriter> CreateWriter(Zone* zone, int compressionLevel) const override;
     };
 } // namespace IW5
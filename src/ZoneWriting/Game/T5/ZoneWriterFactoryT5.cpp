@@ -13,6 +13,7 @@
 #include "Writing/Steps/StepWriteZoneSizes.h"
 
 #include <cstring>
+#include <zlib.h>
 
 using namespace T5;
 
@@ -43,7 +44,12 @@ namespace
     }
 } // namespace
 
-std::unique_ptr<ZoneWriter> ZoneWriterFactory::CreateWriter(Zone* zone) const
+int ZoneWriterFactory::GetReleaseCompressionLevel() const
+{
+    return Z_DEFAULT_COMPRESSION;
+}
+
+std::unique_ptr<ZoneWriter> ZoneWriterFactory::CreateWriter(Zone* zone, const int compressionLevel) const
 {
     auto writer = std::make_unique<ZoneWriter>();
 
@@ -57,7 +63,7 @@ std::unique_ptr<ZoneWriter> ZoneWriterFactory::CreateWriter(Zone* zone) const
     // Write zone header
     writer->AddWritingStep(std::make_unique<StepWriteZoneHeader>(CreateHeaderForParams()));
 
-    writer->AddWritingStep(std::make_unique<StepAddOutputProcessor>(std::make_unique<OutputProcessorDeflate>()));
+    writer->AddWritingStep(std::make_unique<StepAddOutputProcessor>(std::make_unique<OutputProcessorDeflate>(compressionLevel)));
 
     // Start of the XFile struct
     writer->AddWritingStep(std::make_unique<StepWriteZoneSizes>(contentInMemoryPtr));
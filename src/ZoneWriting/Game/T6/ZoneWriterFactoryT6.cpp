@@ -20,6 +20,7 @@
 
 #include <cassert>
 #include <cstring>
+#include <zlib.h>
 
 using namespace T6;
 
@@ -67,6 +68,7 @@ namespace
     void AddXChunkProcessor(ZoneWriter& writer,
                             const Zone& zone,
                             const bool isEncrypted,
+                            const int compressionLevel,
                             ICapturedDataProvider** dataToSignProviderPtr,
                             OutputProcessorXChunks** xChunkProcessorPtr)
     {
@@ -76,7 +78,7 @@ namespace
             *xChunkProcessorPtr = xChunkProcessor.get();
 
         // Decompress the chunks using zlib
-        xChunkProcessor->AddChunkProcessor(std::make_unique<XChunkProcessorDeflate>());
+        xChunkProcessor->AddChunkProcessor(std::make_unique<XChunkProcessorDeflate>(compressionLevel));
 
         if (isEncrypted)
         {
@@ -95,7 +97,12 @@ namespace
     }
 }; // namespace
 
-std::unique_ptr<ZoneWriter> ZoneWriterFactory::CreateWriter(Zone* zone) const
+int ZoneWriterFactory::GetReleaseCompressionLevel() const
+{
+    return Z_BEST_COMPRESSION;
+}
+
+std::unique_ptr<ZoneWriter> ZoneWriterFactory::CreateWriter(Zone* zone, const int compressionLevel) const
 {
     auto writer = std::make_unique<ZoneWriter>();
 
@@ -116,7 +123,7 @@ std::unique_ptr<ZoneWriter> ZoneWriterFactory::CreateWriter(Zone* zone) const
     // Setup loading XChunks from the zone from this point on.
     ICapturedDataProvider* dataToSignProvider;
     OutputProcessorXChunks* xChunksProcessor;
-    AddXChunkProcessor(*writer, *zone, isEncrypted, &dataToSignProvider, &xChunksProcessor);
+    AddXChunkProcessor(*writer, *zone, isEncrypted, compressionLevel, &dataToSignProvider, &xChunksProcessor);
 
     // Start of the XFile struct
     // m_writer->AddWritingStep(std::make_unique<StepSkipBytes>(8)); // Skip size and externalSize fields since they are not interesting for us
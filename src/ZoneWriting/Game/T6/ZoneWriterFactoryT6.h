@@ -11,6 +11,7 @@ namespace T6
         class Impl;
 
     public:
-        _NODISCARD std::unique_ptr<ZoneWriter> CreateWriter(Zone* zone) const override;
+        _NODISCARD int GetReleaseCompressionLevel() const override;
+        _NODISCARD std::unique_ptr<ZoneWriter> CreateWriter(Zone* zone, int compressionLevel) const override;
     };
 } // namespace T6
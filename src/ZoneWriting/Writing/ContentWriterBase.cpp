@@ -1,6 +1,7 @@
 #include "ContentWriterBase.h"
 
 #include <cassert>
+#include <cstring>
 
 ContentWriterBase::ContentWriterBase()
     : varXString(nullptr),
@@ -28,7 +29,8 @@ void ContentWriterBase::WriteXString(const bool atStreamStart)
 
     assert(varXStringWritten != nullptr);
 
-    if (m_stream->ReusableShouldWrite(varXStringWritten))
+    const auto* str = *varXStringWritten;
+    if (m_stream->ReusableShouldWrite(varXStringWritten, str ? strlen(str) + 1u : 0u))
     {
         m_stream->Align(alignof(const char));
         m_stream->ReusableAddOffset(*varXStringWritten);
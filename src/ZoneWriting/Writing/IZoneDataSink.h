@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * \brief Receives the data of the content of a zone in the order it is written to the zone.
+ */
+class IZoneDataSink
+{
+public:
+    IZoneDataSink() = default;
+    virtual ~IZoneDataSink() = default;
+    IZoneDataSink(const IZoneDataSink& other) = default;
+    IZoneDataSink(IZoneDataSink&& other) noexcept = default;
+    IZoneDataSink& operator=(const IZoneDataSink& other) = default;
+    IZoneDataSink& operator=(IZoneDataSink&& other) noexcept = default;
+
+    /**
+     * \brief Adds data that can still be modified by the content writer.
+     * \return A copy of the data that stays valid until the content is written completely.
+     */
+    virtual void* AddData(const void* src, size_t size) = 0;
+
+    /**
+     * \brief Adds data that is not accessed by the content writer anymore after adding it.
+     */
+    virtual void AddFinalData(const void* src, size_t size) = 0;
+};
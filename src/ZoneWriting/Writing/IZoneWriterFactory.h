@@ -14,7 +14,12 @@ public:
     IZoneWriterFactory& operator=(const IZoneWriterFactory& other) = default;
     IZoneWriterFactory& operator=(IZoneWriterFactory&& other) noexcept = default;
 
-    _NODISCARD virtual std::unique_ptr<ZoneWriter> CreateWriter(Zone* zone) const = 0;
+    /**
+     * \brief Returns the deflate level the original linker of the game compresses zones with.
+     */
+    _NODISCARD virtual int GetReleaseCompressionLevel() const = 0;
+
+    _NODISCARD virtual std::unique_ptr<ZoneWriter> CreateWriter(Zone* zone, int compressionLevel) const = 0;
 
     static const IZoneWriterFactory* GetZoneWriterFactoryForGame(GameId game);
 };
@@ -1,9 +1,11 @@
 #include "InMemoryZoneData.h"
 
+#include <cstring>
 #include <stdexcept>
 
-InMemoryZoneData::InMemoryZoneData()
-    : m_total_size(0)
+InMemoryZoneData::InMemoryZoneData(const bool keepFinalData)
+    : m_total_size(0),
+      m_keep_final_data(keepFinalData)
 {
     m_buffers.emplace_back(BUFFER_SIZE);
 }
@@ -36,3 +38,18 @@ void* InMemoryZoneData::GetBufferOfSize(const size_t size)
     m_total_size += size;
     return result;
 }
+
+void* InMemoryZoneData::AddData(const void* src, const size_t size)
+{
+    auto* result = GetBufferOfSize(size);
+    std::memcpy(result, src, size);
+    return result;
+}
+
+void InMemoryZoneData::AddFinalData(const void* src, const size_t size)
+{
+    if (m_keep_final_data)
+        AddData(src, size);
+    else
+        m_total_size += size;
+}
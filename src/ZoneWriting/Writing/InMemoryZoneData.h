@@ -1,9 +1,12 @@
 #pragma once
 
+#include "IZoneDataSink.h"
+
+#include <cstdint>
 #include <memory>
 #include <vector>
 
-class InMemoryZoneData
+class InMemoryZoneData final : public IZoneDataSink
 {
     static constexpr size_t BUFFER_SIZE = 0x400000;
 
@@ -20,6 +23,16 @@ public:
     int64_t m_total_size;
     std::vector<MemoryBuffer> m_buffers;
 
-    InMemoryZoneData();
+    /**
+     * \param keepFinalData Whether to store final data as well. When \c false only the data that can still be modified is stored
+     * while final data only counts towards the total size.
+     */
+    explicit InMemoryZoneData(bool keepFinalData = true);
     void* GetBufferOfSize(size_t size);
+
+    void* AddData(const void* src, size_t size) override;
+    void AddFinalData(const void* src, size_t size) override;
+
+private:
+    bool m_keep_final_data;
 };
@@ -1,105 +1,319 @@
 #include "OutputProcessorDeflate.h"
 
 #include "Utils/ClassUtils.h"
+#include "Utils/ThreadPool.h"
 #include "Writing/WritingException.h"
+#include "Writing/ZoneSizeReport.h"
 
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
 #include <cstdint>
+#include <cstring>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <vector>
 #include <zlib.h>
 
+namespace
+{
+    // Maximum distance deflate can reference back into previous data
+    constexpr size_t DICTIONARY_SIZE = 0x8000;
+
+    // Amount of blocks per worker thread that may be queued before the writer waits for the oldest one
+    constexpr size_t BLOCKS_PER_THREAD = 2u;
+
+    constexpr uint8_t ZLIB_CMF = 0x78;
+} // namespace
+
+/*
+ * The zone is compressed like pigz does it: The data is split into blocks that are compressed independently on the thread pool.
+ * Every block is primed with the end of the previous block as dictionary and ends on a byte boundary with a sync flush,
+ * which makes the concatenated blocks one valid raw deflate stream. The writer adds the zlib header and the adler32 of all blocks.
+ */
 class OutputProcessorDeflate::Impl
 {
-    z_stream m_stream{};
+    class BlockSlot
+    {
+    public:
+        z_stream m_stream{};
+        bool m_stream_initialized = false;
+
+        std::unique_ptr<uint8_t[]> m_input;
+        size_t m_input_size = 0;
+
+        std::unique_ptr<uint8_t[]> m_dictionary;
+        size_t m_dictionary_size = 0;
+
+        std::vector<uint8_t> m_output;
+        size_t m_output_size = 0;
+        uLong m_adler = 0;
+
+        bool m_is_last = false;
+        bool m_is_done = false;
+        std::exception_ptr m_error;
+    };
+
     OutputProcessorDeflate* m_base;
+    int m_compression_level;
+    size_t m_block_size;
 
-    std::unique_ptr<uint8_t[]> m_buffer;
-    size_t m_buffer_size;
+    // Ring of blocks in stream order, starting at m_head.
+    // The slot after the queued blocks is the one that is currently being filled.
+    std::vector<BlockSlot> m_slots;
+    size_t m_head;
+    size_t m_queued_count;
 
-public:
-    Impl(OutputProcessorDeflate* baseClass, const size_t bufferSize)
-        : m_buffer(std::make_unique<uint8_t[]>(bufferSize)),
-          m_buffer_size(bufferSize)
-    {
-        m_base = baseClass;
+    bool m_header_written;
+    bool m_finished;
+    uLong m_adler;
 
-        m_stream.zalloc = Z_NULL;
-        m_stream.zfree = Z_NULL;
-        m_stream.opaque = Z_NULL;
-        m_stream.avail_in = 0;
-        m_stream.next_in = Z_NULL;
-        m_stream.next_out = m_buffer.get();
-        m_stream.avail_out = m_buffer_size;
+    size_t m_running_tasks;
+    std::mutex m_compress_mutex;
+    std::condition_variable m_block_done;
 
-        const int ret = deflateInit(&m_stream, Z_DEFAULT_COMPRESSION);
+    BlockSlot& SlotAt(const size_t queuePosition)
+    {
+        return m_slots[(m_head + queuePosition) % m_slots.size()];
+    }
 
-        if (ret != Z_OK)
+    void CompressBlock(BlockSlot& slot) const
+    {
+        auto& stream = slot.m_stream;
+        if (!slot.m_stream_initialized)
         {
-            throw std::runtime_error("Initializing deflate failed");
+            stream.zalloc = Z_NULL;
+            stream.zfree = Z_NULL;
+            stream.opaque = Z_NULL;
+
+            if (deflateInit2(&stream, m_compression_level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+                throw WritingException("Initializing deflate failed");
+
+            slot.m_stream_initialized = true;
         }
+        else if (deflateReset(&stream) != Z_OK)
+            throw WritingException("Failed to deflate memory of zone.");
+
+        if (slot.m_dictionary_size > 0 && deflateSetDictionary(&stream, slot.m_dictionary.get(), static_cast<uInt>(slot.m_dictionary_size)) != Z_OK)
+            throw WritingException("Failed to deflate memory of zone.");
+
+        // Leave room for the sync flush marker and the final block
+        const auto outputBound = deflateBound(&stream, static_cast<uLong>(slot.m_input_size)) + 16u;
+        if (slot.m_output.size() < outputBound)
+            slot.m_output.resize(outputBound);
+
+        stream.next_in = slot.m_input.get();
+        stream.avail_in = static_cast<uInt>(slot.m_input_size);
+        stream.next_out = slot.m_output.data();
+        stream.avail_out = static_cast<uInt>(slot.m_output.size());
+
+        const auto ret = deflate(&stream, slot.m_is_last ? Z_FINISH : Z_SYNC_FLUSH);
+        if (ret != (slot.m_is_last ? Z_STREAM_END : Z_OK) || stream.avail_in > 0 || stream.avail_out == 0)
+            throw WritingException("Failed to deflate memory of zone.");
+
+        slot.m_output_size = slot.m_output.size() - stream.avail_out;
+        slot.m_adler = adler32(adler32(0, Z_NULL, 0), slot.m_input.get(), static_cast<uInt>(slot.m_input_size));
     }
 
-    ~Impl()
+    void ProcessBlock(BlockSlot& slot)
     {
-        deflateEnd(&m_stream);
+        std::exception_ptr error;
+        try
+        {
+            CompressBlock(slot);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        std::lock_guard lock(m_compress_mutex);
+        slot.m_error = error;
+        slot.m_is_done = true;
+        m_running_tasks--;
+        m_block_done.notify_all();
     }
 
-    Impl(const Impl& other) = delete;
-    Impl(Impl&& other) noexcept = default;
-    Impl& operator=(const Impl& other) = delete;
-    Impl& operator=(Impl&& other) noexcept = default;
+    void WriteHeader()
+    {
+        // Same header deflateInit writes for the compression level
+        uint8_t flevel;
+        if (m_compression_level == Z_DEFAULT_COMPRESSION || m_compression_level == 6)
+            flevel = 2u;
+        else if (m_compression_level < 2)
+            flevel = 0u;
+        else if (m_compression_level < 6)
+            flevel = 1u;
+        else
+            flevel = 3u;
 
-    void Write(const void* buffer, const size_t length)
+        uint8_t header[2]{ZLIB_CMF, static_cast<uint8_t>(flevel << 6)};
+        header[1] += static_cast<uint8_t>(31u - ((header[0] << 8) + header[1]) % 31u);
+
+        m_base->m_base_stream->Write(header, sizeof(header));
+        m_header_written = true;
+    }
+
+    void QueueBlock(const bool isLast)
     {
-        m_stream.next_in = static_cast<const Bytef*>(buffer);
-        m_stream.avail_in = length;
+        auto& slot = SlotAt(m_queued_count);
+        slot.m_is_last = isLast;
+        slot.m_is_done = false;
+        slot.m_error = nullptr;
 
-        while (m_stream.avail_in > 0)
         {
-            if (m_stream.avail_out == 0)
-            {
-                m_base->m_base_stream->Write(m_buffer.get(), m_buffer_size);
-                m_stream.next_out = m_buffer.get();
-                m_stream.avail_out = m_buffer_size;
-            }
-
-            const auto ret = deflate(&m_stream, Z_NO_FLUSH);
-            if (ret != Z_OK)
-                throw WritingException("Failed to deflate memory of zone.");
+            std::lock_guard lock(m_compress_mutex);
+            m_queued_count++;
+            m_running_tasks++;
         }
+
+        ThreadPool::Default().Submit(
+            [this, &slot]
+            {
+                ProcessBlock(slot);
+            });
+
+        if (isLast)
+            return;
+
+        // Keep a slot free for the next block to be filled
+        if (m_queued_count >= m_slots.size())
+            WriteBlock();
+
+        // The next block references the end of this one. It is copied since this block may be written and refilled while the next one is still compressing.
+        auto& nextSlot = SlotAt(m_queued_count);
+        nextSlot.m_dictionary_size = std::min(slot.m_input_size, DICTIONARY_SIZE);
+        memcpy(nextSlot.m_dictionary.get(), &slot.m_input[slot.m_input_size - nextSlot.m_dictionary_size], nextSlot.m_dictionary_size);
+        nextSlot.m_input_size = 0;
     }
 
-    void Flush()
+    void WriteBlock()
     {
-        m_stream.avail_in = 0;
-        m_stream.next_in = Z_NULL;
-        while (true)
+        assert(m_queued_count > 0);
+
+        auto& slot = SlotAt(0);
         {
-            if (m_stream.avail_out < m_buffer_size)
-            {
-                m_base->m_base_stream->Write(m_buffer.get(), m_buffer_size - m_stream.avail_out);
-                m_stream.next_out = m_buffer.get();
-                m_stream.avail_out = m_buffer_size;
-            }
+            std::unique_lock lock(m_compress_mutex);
+            m_block_done.wait(lock,
+                              [&slot]
+                              {
+                                  return slot.m_is_done;
+                              });
+        }
+
+        if (slot.m_error)
+            std::rethrow_exception(slot.m_error);
+
+        if (!m_header_written)
+            WriteHeader();
+
+        m_base->m_base_stream->Write(slot.m_output.data(), slot.m_output_size);
+        m_adler = adler32_combine(m_adler, slot.m_adler, static_cast<z_off_t>(slot.m_input_size));
 
-            const auto ret = deflate(&m_stream, Z_FINISH);
-            if (ret == Z_OK)
-                continue;
+        if (auto* sizeReport = ZoneSizeReport::Active())
+            sizeReport->AddCompressedChunk(slot.m_input_size, slot.m_output_size);
+
+        if (slot.m_is_last)
+        {
+            const uint8_t trailer[4]{
+                static_cast<uint8_t>(m_adler >> 24),
+                static_cast<uint8_t>(m_adler >> 16),
+                static_cast<uint8_t>(m_adler >> 8),
+                static_cast<uint8_t>(m_adler),
+            };
+            m_base->m_base_stream->Write(trailer, sizeof(trailer));
+        }
+
+        std::lock_guard lock(m_compress_mutex);
+        m_head = (m_head + 1) % m_slots.size();
+        m_queued_count--;
+    }
 
-            if (ret != Z_STREAM_END)
-                throw WritingException("Failed to flush deflate memory of zone.");
+public:
+    Impl(OutputProcessorDeflate* baseClass, const int compressionLevel, const size_t bufferSize)
+        : m_base(baseClass),
+          m_compression_level(compressionLevel),
+          m_block_size(bufferSize),
+          m_head(0),
+          m_queued_count(0),
+          m_header_written(false),
+          m_finished(false),
+          m_adler(adler32(0, Z_NULL, 0)),
+          m_running_tasks(0)
+    {
+        assert(bufferSize > 0);
+
+        // One additional slot is the one being filled while all others are queued
+        const auto slotCount = std::max<size_t>(ThreadPool::Default().ThreadCount() * BLOCKS_PER_THREAD, 1u) + 1u;
+        m_slots = std::vector<BlockSlot>(slotCount);
+        for (auto& slot : m_slots)
+        {
+            slot.m_input = std::make_unique<uint8_t[]>(m_block_size);
+            slot.m_dictionary = std::make_unique<uint8_t[]>(DICTIONARY_SIZE);
+        }
+    }
+
+    ~Impl()
+    {
+        {
+            std::unique_lock lock(m_compress_mutex);
+            m_block_done.wait(lock,
+                              [this]
+                              {
+                                  return m_running_tasks == 0;
+                              });
+        }
 
-            break;
+        for (auto& slot : m_slots)
+        {
+            if (slot.m_stream_initialized)
+                deflateEnd(&slot.m_stream);
         }
+    }
+
+    Impl(const Impl& other) = delete;
+    Impl(Impl&& other) noexcept = delete;
+    Impl& operator=(const Impl& other) = delete;
+    Impl& operator=(Impl&& other) noexcept = delete;
 
-        if (m_stream.avail_out < m_buffer_size)
+    void Write(const void* buffer, const size_t length)
+    {
+        if (m_finished)
+            throw WritingException("Failed to deflate memory of zone.");
+
+        if (auto* sizeReport = ZoneSizeReport::Active())
+            sizeReport->AddCompressionInput(length);
+
+        auto sizeRemaining = length;
+        while (sizeRemaining > 0)
         {
-            m_base->m_base_stream->Write(m_buffer.get(), m_buffer_size - m_stream.avail_out);
-            m_stream.next_out = m_buffer.get();
-            m_stream.avail_out = m_buffer_size;
+            auto& slot = SlotAt(m_queued_count);
+            const auto toWrite = std::min(m_block_size - slot.m_input_size, sizeRemaining);
+
+            memcpy(&slot.m_input[slot.m_input_size], &static_cast<const uint8_t*>(buffer)[length - sizeRemaining], toWrite);
+            slot.m_input_size += toWrite;
+            if (slot.m_input_size >= m_block_size)
+                QueueBlock(false);
+
+            sizeRemaining -= toWrite;
         }
     }
 
+    void Flush()
+    {
+        if (m_finished)
+            return;
+
+        // Flushing ends the zlib stream, so the last block is queued even when it is empty
+        QueueBlock(true);
+        m_finished = true;
+
+        while (m_queued_count > 0)
+            WriteBlock();
+    }
+
     _NODISCARD int64_t Pos() const
     {
         return m_base->m_base_stream->Pos();
@@ -107,12 +321,17 @@ public:
 };
 
 OutputProcessorDeflate::OutputProcessorDeflate()
-    : m_impl(new Impl(this, DEFAULT_BUFFER_SIZE))
+    : m_impl(new Impl(this, Z_DEFAULT_COMPRESSION, DEFAULT_BUFFER_SIZE))
+{
+}
+
+OutputProcessorDeflate::OutputProcessorDeflate(const int compressionLevel)
+    : m_impl(new Impl(this, compressionLevel, DEFAULT_BUFFER_SIZE))
 {
 }
 
-OutputProcessorDeflate::OutputProcessorDeflate(const size_t bufferSize)
-    : m_impl(new Impl(this, bufferSize))
+OutputProcessorDeflate::OutputProcessorDeflate(const int compressionLevel, const size_t bufferSize)
+    : m_impl(new Impl(this, compressionLevel, bufferSize))
 {
 }
 
@@ -4,6 +4,10 @@
 #include <cstddef>
 #include <cstdint>
 
+/**
+ * \brief Compresses the written data into a single zlib stream.
+ * The data is compressed in blocks of the buffer size on the default thread pool and only ends when flushing.
+ */
 class OutputProcessorDeflate final : public OutputStreamProcessor
 {
     class Impl;
@@ -13,12 +17,13 @@ class OutputProcessorDeflate final : public OutputStreamProcessor
 
 public:
     OutputProcessorDeflate();
-    OutputProcessorDeflate(size_t bufferSize);
+    explicit OutputProcessorDeflate(int compressionLevel);
+    OutputProcessorDeflate(int compressionLevel, size_t bufferSize);
     ~OutputProcessorDeflate() override;
     OutputProcessorDeflate(const OutputProcessorDeflate& other) = delete;
-    OutputProcessorDeflate(OutputProcessorDeflate&& other) noexcept = default;
+    OutputProcessorDeflate(OutputProcessorDeflate&& other) noexcept = delete;
     OutputProcessorDeflate& operator=(const OutputProcessorDeflate& other) = delete;
-    OutputProcessorDeflate& operator=(OutputProcessorDeflate&& other) noexcept = default;
+    OutputProcessorDeflate& operator=(OutputProcessorDeflate&& other) noexcept = delete;
 
     void Write(const void* buffer, size_t length) override;
     void Flush() override;
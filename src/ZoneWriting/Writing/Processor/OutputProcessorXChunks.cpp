@@ -1,12 +1,21 @@
 #include "OutputProcessorXChunks.h"
 
+#include "Utils/ThreadPool.h"
 #include "Writing/WritingException.h"
+#include "Writing/ZoneSizeReport.h"
 #include "Zone/XChunk/XChunkException.h"
 #include "Zone/ZoneTypes.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
+namespace
+{
+    // Amount of chunks per worker thread that may be queued before the writer waits for the oldest one
+    constexpr size_t CHUNKS_PER_THREAD = 2u;
+} // namespace
+
 void OutputProcessorXChunks::Init()
 {
     if (m_vanilla_buffer_size > 0)
@@ -15,45 +24,169 @@ void OutputProcessorXChunks::Init()
     m_initialized = true;
 }
 
-void OutputProcessorXChunks::WriteChunk()
+OutputProcessorXChunks::ChunkSlot& OutputProcessorXChunks::SlotAt(const size_t queuePosition)
 {
-    if (m_vanilla_buffer_size > 0)
+    return m_slots[(m_head + queuePosition) % m_slots.size()];
+}
+
+// Processors that carry state from one chunk of a stream to the next like Salsa20 must see the chunks of every stream in file order.
+// All other stages may run for any amount of chunks at once.
+// Must be called with m_process_mutex held.
+void OutputProcessorXChunks::ScheduleStages()
+{
+    const auto stageCount = m_chunk_processors.size();
+
+    for (auto stage = 0u; stage < stageCount; stage++)
     {
-        if (m_vanilla_buffer_offset + sizeof(xchunk_size_t) > m_vanilla_buffer_size)
+        const auto isStreamOrdered = m_chunk_processors[stage]->IsStreamOrdered();
+        auto remainingStreams = m_stream_count;
+        std::fill(m_stream_visited.begin(), m_stream_visited.end(), false);
+
+        for (auto queuePosition = 0u; queuePosition < m_queued_count && remainingStreams > 0; queuePosition++)
         {
-            xchunk_size_t zeroMem = 0;
-            m_base_stream->Write(&zeroMem, m_vanilla_buffer_size - m_vanilla_buffer_offset);
-            m_vanilla_buffer_offset = 0;
+            auto& slot = SlotAt(queuePosition);
+            if (slot.m_completed_stages > stage)
+                continue;
+
+            if (isStreamOrdered)
+            {
+                // Only the earliest chunk of each stream that did not complete this stage yet may run it
+                if (m_stream_visited[slot.m_stream])
+                    continue;
+
+                m_stream_visited[slot.m_stream] = true;
+                remainingStreams--;
+            }
+
+            if (slot.m_completed_stages == stage && !slot.m_is_processing)
+            {
+                slot.m_is_processing = true;
+                m_running_tasks++;
+                ThreadPool::Default().Submit(
+                    [this, &slot, stage]
+                    {
+                        ProcessStage(slot, stage);
+                    });
+            }
         }
     }
+}
 
+void OutputProcessorXChunks::ProcessStage(ChunkSlot& slot, const size_t stage)
+{
+    std::exception_ptr error;
+    const auto outputBuffer = 1u - slot.m_data_buffer;
+    size_t outputSize = 0;
     try
     {
-        for (const auto& processor : m_chunk_processors)
+        outputSize = m_chunk_processors[stage]->Process(
+            slot.m_stream, slot.m_buffers[slot.m_data_buffer].get(), slot.m_data_size, slot.m_buffers[outputBuffer].get(), m_chunk_size);
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    std::lock_guard lock(m_process_mutex);
+
+    slot.m_is_processing = false;
+    if (error)
+    {
+        slot.m_error = error;
+        slot.m_completed_stages = m_chunk_processors.size();
+    }
+    else
+    {
+        slot.m_data_buffer = outputBuffer;
+        slot.m_data_size = outputSize;
+        slot.m_completed_stages = stage + 1;
+    }
+
+    m_running_tasks--;
+    if (!m_shutting_down)
+        ScheduleStages();
+
+    m_slot_changed.notify_all();
+}
+
+void OutputProcessorXChunks::QueueChunk()
+{
+    {
+        std::lock_guard lock(m_process_mutex);
+
+        auto& slot = SlotAt(m_queued_count);
+        slot.m_data_buffer = 0;
+        slot.m_data_size = m_input_size;
+        slot.m_input_size = m_input_size;
+        slot.m_stream = m_current_stream;
+        slot.m_completed_stages = 0;
+        slot.m_is_processing = false;
+        slot.m_error = nullptr;
+        m_queued_count++;
+
+        ScheduleStages();
+    }
+
+    m_current_stream = (m_current_stream + 1) % m_stream_count;
+    m_input_size = 0;
+
+    // Keep a slot free for the next chunk to be filled
+    if (m_queued_count >= m_slots.size())
+        WriteChunk();
+}
+
+void OutputProcessorXChunks::WriteChunk()
+{
+    assert(m_queued_count > 0);
+
+    auto& slot = SlotAt(0);
+    {
+        std::unique_lock lock(m_process_mutex);
+        m_slot_changed.wait(lock,
+                            [this, &slot]
+                            {
+                                return slot.m_completed_stages >= m_chunk_processors.size();
+                            });
+    }
+
+    if (slot.m_error)
+    {
+        try
         {
-            m_input_size = processor->Process(m_current_stream, m_input_buffer, m_input_size, m_output_buffer, m_chunk_size);
-            auto* swap = m_input_buffer;
-            m_input_buffer = m_output_buffer;
-            m_output_buffer = swap;
+            std::rethrow_exception(slot.m_error);
+        }
+        catch (XChunkException& e)
+        {
+            throw WritingException(e.Message());
         }
     }
-    catch (XChunkException& e)
+
+    if (m_vanilla_buffer_size > 0)
     {
-        throw WritingException(e.Message());
+        if (m_vanilla_buffer_offset + sizeof(xchunk_size_t) > m_vanilla_buffer_size)
+        {
+            xchunk_size_t zeroMem = 0;
+            m_base_stream->Write(&zeroMem, m_vanilla_buffer_size - m_vanilla_buffer_offset);
+            m_vanilla_buffer_offset = 0;
+        }
     }
 
-    auto chunkSize = static_cast<xchunk_size_t>(m_input_size);
+    auto chunkSize = static_cast<xchunk_size_t>(slot.m_data_size);
     m_base_stream->Write(&chunkSize, sizeof(chunkSize));
-    m_base_stream->Write(m_input_buffer, m_input_size);
+    m_base_stream->Write(slot.m_buffers[slot.m_data_buffer].get(), slot.m_data_size);
+
+    if (auto* sizeReport = ZoneSizeReport::Active())
+        sizeReport->AddCompressedChunk(slot.m_input_size, sizeof(chunkSize) + slot.m_data_size);
 
     if (m_vanilla_buffer_size > 0)
     {
-        m_vanilla_buffer_offset += sizeof(chunkSize) + m_input_size;
+        m_vanilla_buffer_offset += sizeof(chunkSize) + slot.m_data_size;
         m_vanilla_buffer_offset %= m_vanilla_buffer_size;
     }
 
-    m_current_stream = (m_current_stream + 1) % m_stream_count;
-    m_input_size = 0;
+    std::lock_guard lock(m_process_mutex);
+    m_head = (m_head + 1) % m_slots.size();
+    m_queued_count--;
 }
 
 OutputProcessorXChunks::OutputProcessorXChunks(const int numStreams, const size_t xChunkSize, const size_t xChunkWriteSize)
@@ -64,19 +197,25 @@ OutputProcessorXChunks::OutputProcessorXChunks(const int numStreams, const size_
       m_initialized(false),
       m_current_stream(0),
       m_vanilla_buffer_offset(0),
-      m_input_buffer(nullptr),
-      m_output_buffer(nullptr),
-      m_input_size(0)
+      m_head(0),
+      m_queued_count(0),
+      m_input_size(0),
+      m_running_tasks(0),
+      m_shutting_down(false),
+      m_stream_visited(static_cast<size_t>(numStreams))
 {
     assert(numStreams > 0);
     assert(xChunkSize > 0);
     assert(m_chunk_size >= m_chunk_write_size);
 
-    for (auto i = 0u; i < 2u; i++)
-        m_buffers.emplace_back(std::make_unique<uint8_t[]>(xChunkSize));
-
-    m_input_buffer = m_buffers[0].get();
-    m_output_buffer = m_buffers[1].get();
+    // One additional slot is the one being filled while all others are queued
+    const auto slotCount = std::max<size_t>(ThreadPool::Default().ThreadCount() * CHUNKS_PER_THREAD, static_cast<size_t>(numStreams)) + 1u;
+    m_slots = std::vector<ChunkSlot>(slotCount);
+    for (auto& slot : m_slots)
+    {
+        for (auto& buffer : slot.m_buffers)
+            buffer = std::make_unique<uint8_t[]>(xChunkSize);
+    }
 }
 
 OutputProcessorXChunks::OutputProcessorXChunks(const int numStreams, const size_t xChunkSize, const size_t xChunkWriteSize, const size_t vanillaBufferSize)
@@ -85,6 +224,17 @@ OutputProcessorXChunks::OutputProcessorXChunks(const int numStreams, const size_
     m_vanilla_buffer_size = vanillaBufferSize;
 }
 
+OutputProcessorXChunks::~OutputProcessorXChunks()
+{
+    std::unique_lock lock(m_process_mutex);
+    m_shutting_down = true;
+    m_slot_changed.wait(lock,
+                        [this]
+                        {
+                            return m_running_tasks == 0;
+                        });
+}
+
 void OutputProcessorXChunks::AddChunkProcessor(std::unique_ptr<IXChunkProcessor> chunkProcessor)
 {
     assert(chunkProcessor != nullptr);
@@ -99,15 +249,19 @@ void OutputProcessorXChunks::Write(const void* buffer, const size_t length)
     if (!m_initialized)
         Init();
 
+    if (auto* sizeReport = ZoneSizeReport::Active())
+        sizeReport->AddCompressionInput(length);
+
     auto sizeRemaining = length;
     while (sizeRemaining > 0)
     {
         const auto toWrite = std::min(m_chunk_write_size - m_input_size, sizeRemaining);
 
-        memcpy(&m_input_buffer[m_input_size], &static_cast<const char*>(buffer)[length - sizeRemaining], toWrite);
+        auto* inputBuffer = SlotAt(m_queued_count).m_buffers[0].get();
+        memcpy(&inputBuffer[m_input_size], &static_cast<const char*>(buffer)[length - sizeRemaining], toWrite);
         m_input_size += toWrite;
         if (m_input_size >= m_chunk_write_size)
-            WriteChunk();
+            QueueChunk();
 
         sizeRemaining -= toWrite;
     }
@@ -116,6 +270,9 @@ void OutputProcessorXChunks::Write(const void* buffer, const size_t length)
 void OutputProcessorXChunks::Flush()
 {
     if (m_input_size)
+        QueueChunk();
+
+    while (m_queued_count > 0)
         WriteChunk();
 
     m_base_stream->Flush();
@@ -2,13 +2,36 @@
 #include "Writing/OutputStreamProcessor.h"
 #include "Zone/XChunk/IXChunkProcessor.h"
 
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <vector>
 
+/**
+ * \brief Splits the written data into chunks that are distributed round-robin over a number of streams.
+ * Chunks are run through the chunk processors on the default thread pool and written to the base stream in order.
+ */
 class OutputProcessorXChunks final : public OutputStreamProcessor
 {
+    class ChunkSlot
+    {
+    public:
+        std::unique_ptr<uint8_t[]> m_buffers[2];
+
+        // Index of the buffer holding the data of the last completed stage
+        size_t m_data_buffer = 0;
+        size_t m_data_size = 0;
+        size_t m_input_size = 0;
+
+        int m_stream = 0;
+        size_t m_completed_stages = 0;
+        bool m_is_processing = false;
+        std::exception_ptr m_error;
+    };
+
     std::vector<std::unique_ptr<IXChunkProcessor>> m_chunk_processors;
 
     int m_stream_count;
@@ -20,23 +43,35 @@ class OutputProcessorXChunks final : public OutputStreamProcessor
     int m_current_stream;
     size_t m_vanilla_buffer_offset;
 
-    std::vector<std::unique_ptr<uint8_t[]>> m_buffers;
-    uint8_t* m_input_buffer;
-    uint8_t* m_output_buffer;
+    // Ring of chunks in file order, starting at m_head.
+    // The slot after the queued chunks is the one that is currently being filled.
+    std::vector<ChunkSlot> m_slots;
+    size_t m_head;
+    size_t m_queued_count;
     size_t m_input_size;
 
+    size_t m_running_tasks;
+    bool m_shutting_down;
+    std::vector<bool> m_stream_visited;
+    std::mutex m_process_mutex;
+    std::condition_variable m_slot_changed;
+
     void Init();
+    ChunkSlot& SlotAt(size_t queuePosition);
+    void ScheduleStages();
+    void ProcessStage(ChunkSlot& slot, size_t stage);
+    void QueueChunk();
     void WriteChunk();
 
 public:
     OutputProcessorXChunks(int numStreams, size_t xChunkSize, size_t xChunkWriteSize);
     OutputProcessorXChunks(int numStreams, size_t xChunkSize, size_t xChunkWriteSize, size_t vanillaBufferSize);
-    ~OutputProcessorXChunks() override = default;
+    ~OutputProcessorXChunks() override;
 
     OutputProcessorXChunks(const OutputProcessorXChunks& other) = delete;
-    OutputProcessorXChunks(OutputProcessorXChunks&& other) noexcept = default;
+    OutputProcessorXChunks(OutputProcessorXChunks&& other) noexcept = delete;
     OutputProcessorXChunks& operator=(const OutputProcessorXChunks& other) = delete;
-    OutputProcessorXChunks& operator=(OutputProcessorXChunks&& other) noexcept = default;
+    OutputProcessorXChunks& operator=(OutputProcessorXChunks&& other) noexcept = delete;
 
     void AddChunkProcessor(std::unique_ptr<IXChunkProcessor> chunkProcessor);
 
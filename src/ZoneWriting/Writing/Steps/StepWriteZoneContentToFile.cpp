@@ -1,5 +1,7 @@
 #include "StepWriteZoneContentToFile.h"
 
+#include "Writing/ZoneSizeReport.h"
+
 StepWriteZoneContentToFile::StepWriteZoneContentToFile(StepWriteZoneContentToMemory* zoneMemory)
     : m_memory(zoneMemory)
 {
@@ -7,6 +9,15 @@ StepWriteZoneContentToFile::StepWriteZoneContentToFile(StepWriteZoneContentToMem
 
 void StepWriteZoneContentToFile::PerformStep(ZoneWriter* zoneWriter, IWritingStream* stream)
 {
+    if (auto* sizeReport = ZoneSizeReport::Active())
+        sizeReport->BeginContent();
+
+    if (m_memory->IsStreamed())
+    {
+        m_memory->WriteContentToStream(zoneWriter, stream);
+        return;
+    }
+
     for (const auto& dataBuffer : m_memory->GetData()->m_buffers)
     {
         stream->Write(dataBuffer.m_data.get(), dataBuffer.m_size);
@@ -1,13 +1,51 @@
 #include "StepWriteZoneContentToMemory.h"
 
+#include "Utils/TypeName.h"
+#include "Writing/StreamedZoneData.h"
+#include "Writing/WritingException.h"
+#include "Writing/ZoneSizeReport.h"
 #include "Zone/Stream/Impl/InMemoryZoneOutputStream.h"
+#include "ZoneWriting.h"
+
+#include <algorithm>
+#include <cassert>
+#include <format>
+#include <iostream>
+
+namespace
+{
+    void PrintDeduplicationReport(const Zone* zone, const InMemoryZoneOutputStream& zoneOutputStream)
+    {
+        std::vector<std::pair<std::string, InMemoryZoneOutputStream::DeduplicationStats>> entries;
+        size_t totalBytes = 0;
+        for (const auto& [type, stats] : zoneOutputStream.GetDeduplicationStats())
+        {
+            entries.emplace_back(utils::GetTypeName(type), stats);
+            totalBytes += stats.m_bytes;
+        }
+
+        std::ranges::sort(entries,
+                          [](const auto& e1, const auto& e2)
+                          {
+                              return e1.second.m_bytes > e2.second.m_bytes;
+                          });
+
+        // Zones can be written concurrently, so the report is printed at once to not interleave with others
+        auto report = std::format("Deduplicated content of zone \"{}\": {} bytes saved\n", zone->m_name, totalBytes);
+        for (const auto& [typeName, stats] : entries)
+            report += std::format("  {:<40} {:>8} entries {:>14} bytes\n", typeName, stats.m_count, stats.m_bytes);
+
+        std::cout << report;
+    }
+} // namespace
 
 StepWriteZoneContentToMemory::StepWriteZoneContentToMemory(std::unique_ptr<IContentWritingEntryPoint> entryPoint,
                                                            Zone* zone,
                                                            int offsetBlockBitCount,
                                                            block_t insertBlock)
     : m_content_loader(std::move(entryPoint)),
-      m_zone_data(std::make_unique<InMemoryZoneData>()),
+      m_streamed(ZoneWriting::Configuration.StreamContent),
+      m_zone_data(std::make_unique<InMemoryZoneData>(!m_streamed)),
       m_zone(zone),
       m_offset_block_bit_count(offsetBlockBitCount),
       m_insert_block(insertBlock)
@@ -20,11 +58,49 @@ void StepWriteZoneContentToMemory::PerformStep(ZoneWriter* zoneWriter, IWritingS
     for (const auto& block : zoneWriter->m_blocks)
         blocks.push_back(block.get());
 
-    const auto zoneOutputStream = std::make_unique<InMemoryZoneOutputStream>(m_zone_data.get(), std::move(blocks), m_offset_block_bit_count, m_insert_block);
+    const auto deduplicateContent = ZoneWriting::Configuration.DeduplicateContent;
+    const auto zoneOutputStream = std::make_unique<InMemoryZoneOutputStream>(
+        m_zone_data.get(), std::move(blocks), m_offset_block_bit_count, m_insert_block, deduplicateContent, ZoneSizeReport::Active());
     m_content_loader->WriteContent(m_zone, zoneOutputStream.get());
+
+    if (deduplicateContent && ZoneWriting::Configuration.Verbose)
+        PrintDeduplicationReport(m_zone, *zoneOutputStream);
 }
 
 InMemoryZoneData* StepWriteZoneContentToMemory::GetData() const
 {
     return m_zone_data.get();
 }
+
+bool StepWriteZoneContentToMemory::IsStreamed() const
+{
+    return m_streamed;
+}
+
+void StepWriteZoneContentToMemory::WriteContentToStream(ZoneWriter* zoneWriter, IWritingStream* stream) const
+{
+    assert(m_streamed);
+
+    // The second pass needs to start with empty blocks to come up with the same offsets
+    std::vector<XBlock*> blocks;
+    std::vector<size_t> blockSizes;
+    for (const auto& block : zoneWriter->m_blocks)
+    {
+        blocks.push_back(block.get());
+        blockSizes.push_back(block->m_buffer_size);
+        block->m_buffer_size = 0;
+    }
+
+    StreamedZoneData streamedData(m_zone_data.get(), stream);
+    // The data was already attributed to the assets in the first pass
+    const auto zoneOutputStream = std::make_unique<InMemoryZoneOutputStream>(
+        &streamedData, blocks, m_offset_block_bit_count, m_insert_block, ZoneWriting::Configuration.DeduplicateContent, nullptr);
+    m_content_loader->WriteContent(m_zone, zoneOutputStream.get());
+    streamedData.Finish();
+
+    for (auto i = 0u; i < blocks.size(); i++)
+    {
+        if (blocks[i]->m_buffer_size != blockSizes[i])
+            throw WritingException(std::format("Size of block \"{}\" changed between sizing and writing the zone content", blocks[i]->m_name));
+    }
+}
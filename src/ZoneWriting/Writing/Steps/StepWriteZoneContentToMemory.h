@@ -7,9 +7,15 @@
 
 #include <memory>
 
+/**
+ * \brief Writes the content of a zone to memory to know the sizes of its blocks before writing it to the file.
+ * When streaming, only the data that the content writer modifies after writing it is kept and the content is written a second time
+ * by WriteContentToStream.
+ */
 class StepWriteZoneContentToMemory final : public IWritingStep
 {
     std::unique_ptr<IContentWritingEntryPoint> m_content_loader;
+    bool m_streamed;
     std::unique_ptr<InMemoryZoneData> m_zone_data;
     Zone* m_zone;
     int m_offset_block_bit_count;
@@ -20,4 +26,11 @@ public:
 
     void PerformStep(ZoneWriter* zoneWriter, IWritingStream* stream) override;
     _NODISCARD InMemoryZoneData* GetData() const;
+    _NODISCARD bool IsStreamed() const;
+
+    /**
+     * \brief Writes the content for the second time directly to the specified stream.
+     * Only available when streaming.
+     */
+    void WriteContentToStream(ZoneWriter* zoneWriter, IWritingStream* stream) const;
 };
@@ -0,0 +1,51 @@
+#include "StreamedZoneData.h"
+
+#include "WritingException.h"
+
+#include <cstring>
+
+StreamedZoneData::StreamedZoneData(InMemoryZoneData* firstPassData, IWritingStream* stream)
+    : m_first_pass_data(firstPassData),
+      m_stream(stream),
+      m_buffer_index(0),
+      m_buffer_offset(0),
+      m_total_size(0)
+{
+}
+
+void* StreamedZoneData::AddData(const void* src, const size_t size)
+{
+    const auto& buffers = m_first_pass_data->m_buffers;
+
+    // Data is never split between buffers, so continue with the next buffer when it does not fit the current one anymore
+    while (m_buffer_index < buffers.size() && m_buffer_offset + size > buffers[m_buffer_index].m_size)
+    {
+        m_buffer_index++;
+        m_buffer_offset = 0;
+    }
+
+    if (m_buffer_index >= buffers.size())
+        throw WritingException("Zone content changed between sizing and writing it");
+
+    auto* data = &buffers[m_buffer_index].m_data[m_buffer_offset];
+    m_buffer_offset += size;
+    m_total_size += static_cast<int64_t>(size);
+
+    m_stream->Write(data, size);
+
+    // The final state is written, the content writer continues with a fresh copy just like in the first pass
+    std::memcpy(data, src, size);
+    return data;
+}
+
+void StreamedZoneData::AddFinalData(const void* src, const size_t size)
+{
+    m_total_size += static_cast<int64_t>(size);
+    m_stream->Write(src, size);
+}
+
+void StreamedZoneData::Finish() const
+{
+    if (m_total_size != m_first_pass_data->m_total_size)
+        throw WritingException("Zone content changed between sizing and writing it");
+}
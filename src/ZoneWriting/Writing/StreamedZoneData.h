@@ -0,0 +1,32 @@
+#pragma once
+
+#include "IWritingStream.h"
+#include "IZoneDataSink.h"
+#include "InMemoryZoneData.h"
+
+/**
+ * \brief Passes the content of a zone straight on to a writing stream while it is being written for the second time.
+ * Data that can still be modified is taken from the first pass, which already contains its final state.
+ * Final data is passed on as it is added.
+ */
+class StreamedZoneData final : public IZoneDataSink
+{
+public:
+    StreamedZoneData(InMemoryZoneData* firstPassData, IWritingStream* stream);
+
+    void* AddData(const void* src, size_t size) override;
+    void AddFinalData(const void* src, size_t size) override;
+
+    /**
+     * \brief Makes sure the second pass added the same data as the first pass.
+     */
+    void Finish() const;
+
+private:
+    InMemoryZoneData* m_first_pass_data;
+    IWritingStream* m_stream;
+
+    size_t m_buffer_index;
+    size_t m_buffer_offset;
+    int64_t m_total_size;
+};
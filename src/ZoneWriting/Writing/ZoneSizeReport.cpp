@@ -0,0 +1,198 @@
+#include "ZoneSizeReport.h"
+
+#include "Zone/Zone.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <format>
+#include <nlohmann/json.hpp>
+
+using namespace nlohmann;
+
+namespace
+{
+    thread_local ZoneSizeReport* activeReport = nullptr;
+} // namespace
+
+ZoneSizeReport::Activation::Activation(ZoneSizeReport& report)
+    : m_previous(activeReport)
+{
+    activeReport = &report;
+}
+
+ZoneSizeReport::Activation::~Activation()
+{
+    activeReport = m_previous;
+}
+
+ZoneSizeReport::ZoneSizeReport(std::string zoneName, const std::vector<std::unique_ptr<XBlock>>& blocks)
+    : m_zone_name(std::move(zoneName)),
+      m_current_asset(0),
+      m_compression_input(0),
+      m_content_start(0),
+      m_compressed_size(0)
+{
+    for (const auto& block : blocks)
+        m_block_names.emplace_back(block->m_name);
+
+    auto& zoneEntry = m_assets.emplace_back();
+    zoneEntry.m_type_name = "zone";
+    zoneEntry.m_name = m_zone_name;
+    zoneEntry.m_block_sizes.resize(m_block_names.size());
+}
+
+ZoneSizeReport* ZoneSizeReport::Active()
+{
+    return activeReport;
+}
+
+void ZoneSizeReport::SetCurrentAsset(const XAssetInfoGeneric* asset, const uint64_t contentPos)
+{
+    if (m_current_asset > 0)
+        m_assets[m_current_asset].m_content_end = contentPos;
+
+    if (asset == nullptr)
+    {
+        m_current_asset = 0;
+        return;
+    }
+
+    m_current_asset = m_assets.size();
+    auto& entry = m_assets.emplace_back();
+
+    const auto assetTypeName = asset->m_zone ? asset->m_zone->m_pools->GetAssetTypeName(asset->m_type) : std::nullopt;
+    entry.m_type_name = assetTypeName ? *assetTypeName : std::format("type_{}", asset->m_type);
+    entry.m_name = asset->m_name;
+    entry.m_block_sizes.resize(m_block_names.size());
+    entry.m_content_start = contentPos;
+    entry.m_content_end = contentPos;
+}
+
+void ZoneSizeReport::AddBlockSize(const block_t block, const size_t size)
+{
+    assert(block >= 0 && static_cast<size_t>(block) < m_block_names.size());
+
+    auto& entry = m_assets[m_current_asset];
+    entry.m_block_sizes[block] += size;
+    entry.m_size += size;
+}
+
+void ZoneSizeReport::BeginContent()
+{
+    m_content_start = m_compression_input;
+}
+
+void ZoneSizeReport::AddCompressionInput(const size_t size)
+{
+    m_compression_input += size;
+}
+
+void ZoneSizeReport::AddCompressedChunk(const size_t inputSize, const size_t outputSize)
+{
+    const auto inputStart = m_compressed_chunks.empty() ? 0u : m_compressed_chunks.back().m_input_end;
+    m_compressed_chunks.emplace_back(CompressedChunk{inputStart, inputStart + inputSize, outputSize});
+    m_compressed_size += outputSize;
+}
+
+void ZoneSizeReport::Finish()
+{
+    // Assets are added in the order of their content, so both can be walked in parallel.
+    // Each chunk is distributed onto the assets by how much of its input they make up.
+    auto chunk = m_compressed_chunks.begin();
+    double assetsCompressedSize = 0;
+    for (auto i = 1u; i < m_assets.size(); i++)
+    {
+        auto& asset = m_assets[i];
+        const auto start = m_content_start + asset.m_content_start;
+        const auto end = m_content_start + asset.m_content_end;
+
+        asset.m_compressed_size = 0;
+        while (chunk != m_compressed_chunks.end() && chunk->m_input_end <= start)
+            ++chunk;
+
+        for (auto overlapping = chunk; overlapping != m_compressed_chunks.end() && overlapping->m_input_start < end; ++overlapping)
+        {
+            const auto overlap = std::min(end, overlapping->m_input_end) - std::max(start, overlapping->m_input_start);
+            const auto chunkInputSize = overlapping->m_input_end - overlapping->m_input_start;
+            asset.m_compressed_size += static_cast<double>(overlapping->m_output_size) * static_cast<double>(overlap) / static_cast<double>(chunkInputSize);
+        }
+
+        assetsCompressedSize += asset.m_compressed_size;
+    }
+
+    m_assets[0].m_compressed_size = std::max(static_cast<double>(m_compressed_size) - assetsCompressedSize, 0.0);
+}
+
+std::vector<const ZoneSizeReport::AssetEntry*> ZoneSizeReport::GetSortedAssets() const
+{
+    std::vector<const AssetEntry*> assets;
+    assets.reserve(m_assets.size());
+    for (const auto& asset : m_assets)
+        assets.emplace_back(&asset);
+
+    std::ranges::stable_sort(assets,
+                             [](const AssetEntry* e1, const AssetEntry* e2)
+                             {
+                                 return e1->m_size > e2->m_size;
+                             });
+
+    return assets;
+}
+
+void ZoneSizeReport::PrintText(std::ostream& stream) const
+{
+    std::vector<uint64_t> blockTotals(m_block_names.size());
+    uint64_t total = 0;
+    for (const auto& asset : m_assets)
+    {
+        for (auto i = 0u; i < blockTotals.size(); i++)
+            blockTotals[i] += asset.m_block_sizes[i];
+        total += asset.m_size;
+    }
+
+    stream << std::format("Size report of zone '{}': {} bytes, {} bytes compressed\n", m_zone_name, total, m_compressed_size);
+
+    stream << "  Blocks:\n";
+    for (auto i = 0u; i < m_block_names.size(); i++)
+        stream << std::format("    {:<40} {:>14} bytes\n", m_block_names[i], blockTotals[i]);
+
+    stream << "  Assets:\n";
+    for (const auto* asset : GetSortedAssets())
+    {
+        stream << std::format(
+            "    {:<24} {:<60} {:>14} bytes {:>14.0f} bytes compressed\n", asset->m_type_name, asset->m_name, asset->m_size, asset->m_compressed_size);
+
+        for (auto i = 0u; i < m_block_names.size(); i++)
+        {
+            if (asset->m_block_sizes[i] > 0)
+                stream << std::format("      {:<40} {:>14} bytes\n", m_block_names[i], asset->m_block_sizes[i]);
+        }
+    }
+}
+
+void ZoneSizeReport::PrintJson(std::ostream& stream) const
+{
+    auto jAssets = json::array();
+    for (const auto* asset : GetSortedAssets())
+    {
+        jAssets.emplace_back(json{
+            {"type", asset->m_type_name},
+            {"name", asset->m_name},
+            {"size", asset->m_size},
+            {"compressedSize", static_cast<uint64_t>(std::llround(asset->m_compressed_size))},
+            {"blockSizes", asset->m_block_sizes},
+        });
+    }
+
+    const json jRoot{
+        {"zone", m_zone_name},
+        {"compressedSize", m_compressed_size},
+        {"blocks", m_block_names},
+        {"assets", std::move(jAssets)},
+    };
+
+    // One object per line, so reports of several zones can be appended to the same file.
+    // Names are not guaranteed to be valid UTF-8, so invalid sequences are replaced instead of failing.
+    stream << jRoot.dump(-1, ' ', false, json::error_handler_t::replace) << "\n";
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Pool/XAssetInfo.h"
+#include "Zone/XBlock.h"
+#include "Zone/ZoneTypes.h"
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Attributes the data of a written zone to the assets it belongs to.
+ * A report is only collected for zones written on the thread it was activated on.
+ */
+class ZoneSizeReport
+{
+public:
+    class AssetEntry
+    {
+    public:
+        std::string m_type_name;
+        std::string m_name;
+
+        // Bytes the asset takes up in each block, by block index
+        std::vector<uint64_t> m_block_sizes;
+        uint64_t m_size = 0;
+
+        // Range of the written content that contains the data of the asset
+        uint64_t m_content_start = 0;
+        uint64_t m_content_end = 0;
+
+        // Share of the compressed output that is made up of the content of the asset
+        double m_compressed_size = 0;
+    };
+
+    /**
+     * \brief Makes a report the active report of the current thread while it is alive.
+     */
+    class Activation
+    {
+        ZoneSizeReport* m_previous;
+
+    public:
+        explicit Activation(ZoneSizeReport& report);
+        ~Activation();
+        Activation(const Activation& other) = delete;
+        Activation(Activation&& other) noexcept = delete;
+        Activation& operator=(const Activation& other) = delete;
+        Activation& operator=(Activation&& other) noexcept = delete;
+    };
+
+    ZoneSizeReport(std::string zoneName, const std::vector<std::unique_ptr<XBlock>>& blocks);
+
+    [[nodiscard]] static ZoneSizeReport* Active();
+
+    /**
+     * \brief Attributes all data added from now on to the specified asset. \c nullptr attributes it to the zone itself.
+     * \param contentPos The amount of content bytes that were written so far.
+     */
+    void SetCurrentAsset(const XAssetInfoGeneric* asset, uint64_t contentPos);
+    void AddBlockSize(block_t block, size_t size);
+
+    /**
+     * \brief Marks the start of the content in the data passed to the compression.
+     */
+    void BeginContent();
+    void AddCompressionInput(size_t size);
+
+    /**
+     * \brief Adds the next unit the compression processed, in the order of its input.
+     */
+    void AddCompressedChunk(size_t inputSize, size_t outputSize);
+
+    /**
+     * \brief Distributes the compressed size onto the assets. Must be called after the zone was written completely.
+     */
+    void Finish();
+
+    void PrintText(std::ostream& stream) const;
+    void PrintJson(std::ostream& stream) const;
+
+private:
+    class CompressedChunk
+    {
+    public:
+        uint64_t m_input_start;
+        uint64_t m_input_end;
+        size_t m_output_size;
+    };
+
+    [[nodiscard]] std::vector<const AssetEntry*> GetSortedAssets() const;
+
+    std::string m_zone_name;
+    std::vector<std::string> m_block_names;
+
+    // The first entry holds the data of the zone itself
+    std::vector<AssetEntry> m_assets;
+    size_t m_current_asset;
+
+    uint64_t m_compression_input;
+    uint64_t m_content_start;
+    uint64_t m_compressed_size;
+    std::vector<CompressedChunk> m_compressed_chunks;
+};
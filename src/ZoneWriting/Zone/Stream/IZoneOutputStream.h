@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Pool/XAssetInfo.h"
 #include "Zone/Stream/IZoneStream.h"
 
 #include <cstddef>
@@ -16,10 +17,27 @@ public:
 
     virtual void* WriteDataRaw(const void* dst, size_t size) = 0;
     virtual void* WriteDataInBlock(const void* dst, size_t size) = 0;
+
+    /**
+     * \brief Writes data to the current block that is not accessed anymore after writing it.
+     * Unlike WriteDataInBlock this does not return a copy that can be modified, which allows the stream to pass the data on right away.
+     */
+    virtual void WriteFinalDataInBlock(const void* src, size_t size) = 0;
     virtual void IncBlockPos(size_t size) = 0;
     virtual void WriteNullTerminated(const void* dst) = 0;
 
+    /**
+     * \brief Marks the data written from now on as data of the specified asset. \c nullptr marks it as data of the zone itself.
+     */
+    virtual void SetCurrentAsset(const XAssetInfoGeneric* asset) = 0;
+
     virtual bool ReusableShouldWrite(void** pPtr, size_t size, std::type_index type) = 0;
+
+    /**
+     * \brief Like ReusableShouldWrite but also knows the amount of entries the pointer points to.
+     * This allows the stream to reuse previously written data with identical content instead of only data at the same address.
+     */
+    virtual bool ReusableShouldWrite(void** pPtr, size_t size, size_t count, std::type_index type) = 0;
     virtual void ReusableAddOffset(void* ptr, size_t size, size_t count, std::type_index type) = 0;
     virtual void MarkFollowing(void** pPtr) = 0;
 
@@ -28,6 +46,11 @@ public:
         return ReusableShouldWrite(reinterpret_cast<void**>(reinterpret_cast<uintptr_t>(pPtr)), sizeof(T), std::type_index(typeid(T)));
     }
 
+    template<typename T> bool ReusableShouldWrite(T** pPtr, const size_t count)
+    {
+        return ReusableShouldWrite(reinterpret_cast<void**>(reinterpret_cast<uintptr_t>(pPtr)), sizeof(T), count, std::type_index(typeid(T)));
+    }
+
     template<typename T> void ReusableAddOffset(T* ptr)
     {
         ReusableAddOffset(const_cast<void*>(reinterpret_cast<const void*>(ptr)), sizeof(T), 1, std::type_index(typeid(T)));
@@ -48,6 +71,16 @@ public:
         return static_cast<T*>(WriteDataInBlock(reinterpret_cast<const void*>(dst), count * sizeof(T)));
     }
 
+    template<typename T> void WriteFinal(T* src)
+    {
+        WriteFinalDataInBlock(reinterpret_cast<const void*>(src), sizeof(T));
+    }
+
+    template<typename T> void WriteFinal(T* src, const uint32_t count)
+    {
+        WriteFinalDataInBlock(reinterpret_cast<const void*>(src), count * sizeof(T));
+    }
+
     template<typename T> T* WritePartial(T* dst, const size_t size)
     {
         return static_cast<T*>(WriteDataInBlock(reinterpret_cast<const void*>(dst), size));
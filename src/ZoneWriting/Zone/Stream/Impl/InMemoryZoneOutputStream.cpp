@@ -1,13 +1,24 @@
 #include "InMemoryZoneOutputStream.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
-
-InMemoryZoneOutputStream::InMemoryZoneOutputStream(InMemoryZoneData* zoneData, std::vector<XBlock*> blocks, const int blockBitCount, const block_t insertBlock)
+#include <string_view>
+
+InMemoryZoneOutputStream::InMemoryZoneOutputStream(IZoneDataSink* zoneData,
+                                                   std::vector<XBlock*> blocks,
+                                                   const int blockBitCount,
+                                                   const block_t insertBlock,
+                                                   const bool deduplicateContent,
+                                                   ZoneSizeReport* sizeReport)
     : m_zone_data(zoneData),
       m_blocks(std::move(blocks)),
       m_block_bit_count(blockBitCount),
-      m_insert_block(m_blocks[insertBlock])
+      m_insert_block(m_blocks[insertBlock]),
+      m_deduplicate_content(deduplicateContent),
+      m_pending_content_hash(0),
+      m_size_report(sizeReport),
+      m_content_size(0)
 {
 }
 
@@ -20,6 +31,54 @@ InMemoryZoneOutputStream::ReusableEntry::ReusableEntry(void* startPtr, const siz
 {
 }
 
+void InMemoryZoneOutputStream::ReusableEntries::Add(void* ptr, const size_t size, const size_t count, const uintptr_t zonePtr)
+{
+    const auto entryIndex = m_entries.size();
+    const auto& entry = m_entries.emplace_back(ptr, size, count, zonePtr);
+
+    const auto end = reinterpret_cast<uintptr_t>(entry.m_end_ptr);
+    auto pos = reinterpret_cast<uintptr_t>(entry.m_start_ptr);
+
+    // Skip the part that is covered by the range starting before this entry
+    auto nextRange = m_ranges.upper_bound(pos);
+    if (nextRange != m_ranges.begin())
+    {
+        const auto& previousRange = std::prev(nextRange)->second;
+        pos = std::max(pos, previousRange.m_end);
+    }
+
+    // Index the gaps between the ranges of entries that were added before
+    while (pos < end)
+    {
+        if (nextRange == m_ranges.end() || nextRange->first >= end)
+        {
+            m_ranges.emplace_hint(nextRange, pos, ReusableRange{end, entryIndex});
+            break;
+        }
+
+        if (nextRange->first > pos)
+            m_ranges.emplace_hint(nextRange, pos, ReusableRange{nextRange->first, entryIndex});
+
+        pos = std::max(pos, nextRange->second.m_end);
+        ++nextRange;
+    }
+}
+
+const InMemoryZoneOutputStream::ReusableEntry* InMemoryZoneOutputStream::ReusableEntries::Find(const void* ptr) const
+{
+    const auto address = reinterpret_cast<uintptr_t>(ptr);
+
+    auto range = m_ranges.upper_bound(address);
+    if (range == m_ranges.begin())
+        return nullptr;
+
+    --range;
+    if (address >= range->second.m_end)
+        return nullptr;
+
+    return &m_entries[range->second.m_entry_index];
+}
+
 void InMemoryZoneOutputStream::PushBlock(const block_t block)
 {
     assert(block >= 0 && block < static_cast<block_t>(m_blocks.size()));
@@ -70,18 +129,17 @@ void InMemoryZoneOutputStream::Align(const int align)
     {
         auto* block = m_block_stack.top();
 
-        if (block->m_type == XBlock::Type::BLOCK_TYPE_TEMP)
-            m_temp_sizes.top() = (m_temp_sizes.top() + align - 1) / align * align;
-        else
-            block->m_buffer_size = (block->m_buffer_size + align - 1) / align * align;
+        auto& blockSize = block->m_type == XBlock::Type::BLOCK_TYPE_TEMP ? m_temp_sizes.top() : block->m_buffer_size;
+        const auto alignedSize = (blockSize + align - 1) / align * align;
+        AddBlockSize(block, alignedSize - blockSize);
+        blockSize = alignedSize;
     }
 }
 
 void* InMemoryZoneOutputStream::WriteDataRaw(const void* src, const size_t size)
 {
-    auto* result = m_zone_data->GetBufferOfSize(size);
-    memcpy(result, src, size);
-    return result;
+    m_content_size += size;
+    return m_zone_data->AddData(src, size);
 }
 
 void* InMemoryZoneOutputStream::WriteDataInBlock(const void* src, const size_t size)
@@ -98,8 +156,8 @@ void* InMemoryZoneOutputStream::WriteDataInBlock(const void* src, const size_t s
     {
     case XBlock::Type::BLOCK_TYPE_TEMP:
     case XBlock::Type::BLOCK_TYPE_NORMAL:
-        result = m_zone_data->GetBufferOfSize(size);
-        memcpy(result, src, size);
+        result = m_zone_data->AddData(src, size);
+        m_content_size += size;
         break;
 
     case XBlock::Type::BLOCK_TYPE_RUNTIME:
@@ -114,6 +172,32 @@ void* InMemoryZoneOutputStream::WriteDataInBlock(const void* src, const size_t s
     return result;
 }
 
+void InMemoryZoneOutputStream::WriteFinalDataInBlock(const void* src, const size_t size)
+{
+    assert(!m_block_stack.empty());
+
+    if (m_block_stack.empty())
+        return;
+
+    switch (m_block_stack.top()->m_type)
+    {
+    case XBlock::Type::BLOCK_TYPE_TEMP:
+    case XBlock::Type::BLOCK_TYPE_NORMAL:
+        m_zone_data->AddFinalData(src, size);
+        m_content_size += size;
+        break;
+
+    case XBlock::Type::BLOCK_TYPE_RUNTIME:
+        break;
+
+    case XBlock::Type::BLOCK_TYPE_DELAY:
+        assert(false);
+        break;
+    }
+
+    IncBlockPos(size);
+}
+
 void InMemoryZoneOutputStream::IncBlockPos(const size_t size)
 {
     assert(!m_block_stack.empty());
@@ -130,12 +214,20 @@ void InMemoryZoneOutputStream::IncBlockPos(const size_t size)
     {
         block->m_buffer_size += size;
     }
+
+    AddBlockSize(block, size);
+}
+
+void InMemoryZoneOutputStream::AddBlockSize(const XBlock* block, const size_t size) const
+{
+    if (m_size_report && size > 0)
+        m_size_report->AddBlockSize(block->m_index, size);
 }
 
 void InMemoryZoneOutputStream::WriteNullTerminated(const void* src)
 {
     const auto len = strlen(static_cast<const char*>(src));
-    WriteDataInBlock(src, len + 1);
+    WriteFinalDataInBlock(src, len + 1);
 }
 
 uintptr_t InMemoryZoneOutputStream::GetCurrentZonePointer()
@@ -171,7 +263,20 @@ void InMemoryZoneOutputStream::MarkFollowing(void** pPtr)
     *pPtr = m_block_stack.top()->m_type == XBlock::Type::BLOCK_TYPE_TEMP ? PTR_INSERT : PTR_FOLLOWING;
 }
 
+void InMemoryZoneOutputStream::SetCurrentAsset(const XAssetInfoGeneric* asset)
+{
+    if (m_size_report)
+        m_size_report->SetCurrentAsset(asset, m_content_size);
+}
+
 bool InMemoryZoneOutputStream::ReusableShouldWrite(void** pPtr, const size_t entrySize, const std::type_index type)
+{
+    m_pending_content_entry.reset();
+
+    return ShouldWriteByAddress(pPtr, entrySize, type);
+}
+
+bool InMemoryZoneOutputStream::ShouldWriteByAddress(void** pPtr, const size_t entrySize, const std::type_index type)
 {
     assert(!m_block_stack.empty());
     assert(pPtr != nullptr);
@@ -185,16 +290,54 @@ bool InMemoryZoneOutputStream::ReusableShouldWrite(void** pPtr, const size_t ent
         return true;
     }
 
-    for (const auto& entry : foundEntriesForType->second)
+    const auto* entry = foundEntriesForType->second.Find(*pPtr);
+    if (entry == nullptr)
+        return true;
+
+    assert((reinterpret_cast<uintptr_t>(*pPtr) - reinterpret_cast<uintptr_t>(entry->m_start_ptr)) % entrySize == 0);
+    *pPtr = reinterpret_cast<void*>(entry->m_start_zone_ptr + (reinterpret_cast<uintptr_t>(*pPtr) - reinterpret_cast<uintptr_t>(entry->m_start_ptr)));
+    return false;
+}
+
+bool InMemoryZoneOutputStream::ReusableShouldWrite(void** pPtr, const size_t entrySize, const size_t count, const std::type_index type)
+{
+    m_pending_content_entry.reset();
+
+    if (!ShouldWriteByAddress(pPtr, entrySize, type))
+        return false;
+
+    if (!m_deduplicate_content || count == 0)
+        return true;
+
+    // The loader resolves pointers into temp blocks differently, so data can only be shared within the same block
+    const auto* block = m_block_stack.top();
+    if (block->m_type != XBlock::Type::BLOCK_TYPE_NORMAL && block->m_type != XBlock::Type::BLOCK_TYPE_TEMP)
+        return true;
+
+    const auto size = entrySize * count;
+    const auto hash = std::hash<std::string_view>()(std::string_view(static_cast<const char*>(*pPtr), size));
+
+    const auto [begin, end] = m_content_entries.equal_range(hash);
+    for (auto i = begin; i != end; ++i)
     {
-        if (*pPtr >= entry.m_start_ptr && *pPtr < entry.m_end_ptr)
-        {
-            assert((reinterpret_cast<uintptr_t>(*pPtr) - reinterpret_cast<uintptr_t>(entry.m_start_ptr)) % entrySize == 0);
-            *pPtr = reinterpret_cast<void*>(entry.m_start_zone_ptr + (reinterpret_cast<uintptr_t>(*pPtr) - reinterpret_cast<uintptr_t>(entry.m_start_ptr)));
-            return false;
-        }
+        const auto& entry = i->second;
+        if (entry.m_type != type || entry.m_block != block->m_index || entry.m_size != size || memcmp(entry.m_ptr, *pPtr, size) != 0)
+            continue;
+
+        // Resolve the duplicate by its address from now on as well
+        m_reusable_entries[type].Add(*pPtr, entrySize, count, entry.m_zone_ptr);
+
+        auto& stats = m_deduplication_stats[type];
+        stats.m_count++;
+        stats.m_bytes += size;
+
+        *pPtr = reinterpret_cast<void*>(entry.m_zone_ptr);
+        return false;
     }
 
+    m_pending_content_entry = ContentEntry{type, *pPtr, size, block->m_index, 0};
+    m_pending_content_hash = hash;
+
     return true;
 }
 
@@ -202,17 +345,22 @@ void InMemoryZoneOutputStream::ReusableAddOffset(void* ptr, size_t size, size_t
 {
     assert(!m_block_stack.empty());
 
-    const auto inTemp = m_block_stack.top()->m_type == XBlock::Type::BLOCK_TYPE_TEMP;
+    const auto* block = m_block_stack.top();
+    const auto inTemp = block->m_type == XBlock::Type::BLOCK_TYPE_TEMP;
     auto zoneOffset = inTemp ? InsertPointer() : GetCurrentZonePointer();
-    const auto foundEntriesForType = m_reusable_entries.find(type);
-    if (foundEntriesForType == m_reusable_entries.end())
-    {
-        std::vector<ReusableEntry> entries;
-        entries.emplace_back(ptr, size, count, zoneOffset);
-        m_reusable_entries.emplace(std::make_pair(type, std::move(entries)));
-    }
-    else
+    m_reusable_entries[type].Add(ptr, size, count, zoneOffset);
+
+    // The pending entry only lives until the next reusable call, which is the one adding the offset of the data that passed the content lookup
+    if (m_pending_content_entry && m_pending_content_entry->m_ptr == ptr && m_pending_content_entry->m_type == type
+        && m_pending_content_entry->m_block == block->m_index)
     {
-        foundEntriesForType->second.emplace_back(ptr, size, count, zoneOffset);
+        m_pending_content_entry->m_zone_ptr = zoneOffset;
+        m_content_entries.emplace(m_pending_content_hash, *m_pending_content_entry);
     }
+    m_pending_content_entry.reset();
+}
+
+const std::unordered_map<std::type_index, InMemoryZoneOutputStream::DeduplicationStats>& InMemoryZoneOutputStream::GetDeduplicationStats() const
+{
+    return m_deduplication_stats;
 }
@@ -1,14 +1,26 @@
 #pragma once
-#include "Writing/InMemoryZoneData.h"
+#include "Writing/IZoneDataSink.h"
+#include "Writing/ZoneSizeReport.h"
 #include "Zone/Stream/IZoneOutputStream.h"
 #include "Zone/XBlock.h"
 
+#include <map>
+#include <optional>
 #include <stack>
 #include <unordered_map>
 #include <vector>
 
 class InMemoryZoneOutputStream final : public IZoneOutputStream
 {
+public:
+    class DeduplicationStats
+    {
+    public:
+        size_t m_count = 0;
+        size_t m_bytes = 0;
+    };
+
+private:
     class ReusableEntry
     {
     public:
@@ -21,7 +33,38 @@ class InMemoryZoneOutputStream final : public IZoneOutputStream
         ReusableEntry(void* startPtr, size_t entrySize, size_t entryCount, uintptr_t startZonePtr);
     };
 
-    InMemoryZoneData* m_zone_data;
+    // Part of the memory of a reusable entry that is not already covered by an entry that was added before it
+    class ReusableRange
+    {
+    public:
+        uintptr_t m_end;
+        size_t m_entry_index;
+    };
+
+    class ReusableEntries
+    {
+    public:
+        std::vector<ReusableEntry> m_entries;
+
+        // Ranges keyed by their start address. Ranges never overlap and resolve to the earliest added entry covering them.
+        std::map<uintptr_t, ReusableRange> m_ranges;
+
+        void Add(void* ptr, size_t size, size_t count, uintptr_t zonePtr);
+        [[nodiscard]] const ReusableEntry* Find(const void* ptr) const;
+    };
+
+    // Data that was written to a block and can be referenced by any pointer to data with the same content
+    class ContentEntry
+    {
+    public:
+        std::type_index m_type;
+        const void* m_ptr;
+        size_t m_size;
+        block_t m_block;
+        uintptr_t m_zone_ptr;
+    };
+
+    IZoneDataSink* m_zone_data;
     std::vector<XBlock*> m_blocks;
 
     std::stack<XBlock*> m_block_stack;
@@ -30,22 +73,49 @@ class InMemoryZoneOutputStream final : public IZoneOutputStream
     int m_block_bit_count;
     XBlock* m_insert_block;
 
-    std::unordered_map<std::type_index, std::vector<ReusableEntry>> m_reusable_entries;
+    std::unordered_map<std::type_index, ReusableEntries> m_reusable_entries;
+
+    bool m_deduplicate_content;
+    // Content entries keyed by the hash of their data
+    std::unordered_multimap<size_t, ContentEntry> m_content_entries;
+    // Data that passed the content lookup and is added as content entry once its offset is known
+    std::optional<ContentEntry> m_pending_content_entry;
+    size_t m_pending_content_hash;
+    std::unordered_map<std::type_index, DeduplicationStats> m_deduplication_stats;
+
+    ZoneSizeReport* m_size_report;
+    uint64_t m_content_size;
 
     uintptr_t GetCurrentZonePointer();
     uintptr_t InsertPointer();
+    void AddBlockSize(const XBlock* block, size_t size) const;
+    bool ShouldWriteByAddress(void** pPtr, size_t entrySize, std::type_index type);
 
 public:
-    InMemoryZoneOutputStream(InMemoryZoneData* zoneData, std::vector<XBlock*> blocks, int blockBitCount, block_t insertBlock);
+    /**
+     * \param deduplicateContent Whether data with the same content as previously written data should reference the written data instead of being written
+     * again. Only applies to data that the writer reports the count of, and only within the same block.
+     * \param sizeReport The report to attribute the written data to. May be \c nullptr.
+     */
+    InMemoryZoneOutputStream(
+        IZoneDataSink* zoneData, std::vector<XBlock*> blocks, int blockBitCount, block_t insertBlock, bool deduplicateContent, ZoneSizeReport* sizeReport);
 
     void PushBlock(block_t block) override;
     block_t PopBlock() override;
     void Align(int align) override;
     void* WriteDataRaw(const void* src, size_t size) override;
     void* WriteDataInBlock(const void* src, size_t size) override;
+    void WriteFinalDataInBlock(const void* src, size_t size) override;
     void IncBlockPos(size_t size) override;
     void WriteNullTerminated(const void* src) override;
     void MarkFollowing(void** pPtr) override;
+    void SetCurrentAsset(const XAssetInfoGeneric* asset) override;
     bool ReusableShouldWrite(void** pPtr, size_t entrySize, std::type_index type) override;
+    bool ReusableShouldWrite(void** pPtr, size_t entrySize, size_t count, std::type_index type) override;
     void ReusableAddOffset(void* ptr, size_t size, size_t count, std::type_index type) override;
+
+    /**
+     * \brief Returns the amount of deduplicated entries and the bytes that were not written because of them by their type.
+     */
+    [[nodiscard]] const std::unordered_map<std::type_index, DeduplicationStats>& GetDeduplicationStats() const;
 };
@@ -1,10 +1,22 @@
 #include "ZoneWriting.h"
 
 #include "Writing/IZoneWriterFactory.h"
+#include "Writing/ZoneSizeReport.h"
 
 #include <chrono>
 #include <format>
+#include <fstream>
 #include <iostream>
+#include <mutex>
+#include <zlib.h>
+
+ZoneWriting::Configuration_t ZoneWriting::Configuration;
+
+namespace
+{
+    // Zones can be written concurrently, their reports must not interleave
+    std::mutex sizeReportMutex;
+} // namespace
 
 bool ZoneWriting::WriteZone(std::ostream& stream, Zone* zone)
 {
@@ -12,14 +24,49 @@ bool ZoneWriting::WriteZone(std::ostream& stream, Zone* zone)
 
     const auto factory = IZoneWriterFactory::GetZoneWriterFactoryForGame(zone->m_game->GetId());
 
-    const auto zoneWriter = factory->CreateWriter(zone);
+    const auto compressionLevel = Configuration.CompressionLevel.value_or(factory->GetReleaseCompressionLevel());
+    if (Configuration.Verbose)
+    {
+        // zlib's default level is level 6
+        const auto printedLevel = compressionLevel == Z_DEFAULT_COMPRESSION ? 6 : compressionLevel;
+        if (Configuration.CompressionLevel)
+            std::cout << std::format("Compressing zone \"{}\" with deflate level {}. This is not a release build.\n", zone->m_name, printedLevel);
+        else
+            std::cout << std::format("Compressing zone \"{}\" with release deflate level {}.\n", zone->m_name, printedLevel);
+    }
+
+    const auto zoneWriter = factory->CreateWriter(zone, compressionLevel);
     if (zoneWriter == nullptr)
     {
         std::cerr << std::format("Could not create ZoneWriter for zone \"{}\".\n", zone->m_name);
         return false;
     }
 
-    const auto result = zoneWriter->WriteZone(stream);
+    bool result;
+    if (Configuration.SizeReport || !Configuration.SizeReportJsonPath.empty())
+    {
+        ZoneSizeReport report(zone->m_name, zoneWriter->m_blocks);
+        {
+            ZoneSizeReport::Activation activation(report);
+            result = zoneWriter->WriteZone(stream);
+        }
+        report.Finish();
+
+        std::lock_guard lock(sizeReportMutex);
+        if (Configuration.SizeReport)
+            report.PrintText(std::cout);
+
+        if (!Configuration.SizeReportJsonPath.empty())
+        {
+            std::ofstream jsonFile(Configuration.SizeReportJsonPath, std::ios::out | std::ios::app);
+            if (jsonFile.is_open())
+                report.PrintJson(jsonFile);
+            else
+                std::cerr << std::format("Could not open size report output file '{}'\n", Configuration.SizeReportJsonPath);
+        }
+    }
+    else
+        result = zoneWriter->WriteZone(stream);
 
     const auto end = std::chrono::high_resolution_clock::now();
 
@@ -1,11 +1,37 @@
 #pragma once
 #include "Zone/Zone.h"
 
+#include <optional>
 #include <ostream>
 #include <string>
 
 class ZoneWriting
 {
 public:
+    static class Configuration_t
+    {
+    public:
+        bool Verbose = false;
+
+        // Deflate level to compress zones with instead of the one the original linker of the game uses.
+        // Meant for faster iteration builds. 0 stores the data uncompressed.
+        std::optional<int> CompressionLevel;
+
+        // Writes data that has the same content as previously written data only once.
+        // Makes zones smaller at the cost of hashing all reusable data while writing.
+        bool DeduplicateContent = false;
+
+        // Sizes the zone content in a first pass and writes it straight to the compression in a second pass.
+        // Only the data that is modified after writing it is kept in memory, at the cost of writing the content twice.
+        bool StreamContent = false;
+
+        // Prints a report of how much each asset contributes to the size of each written zone
+        bool SizeReport = false;
+
+        // File to append a size report of each written zone to as one JSON object per line. Disabled when empty.
+        std::string SizeReportJsonPath;
+
+    } Configuration;
+
     static bool WriteZone(std::ostream& stream, Zone* zone);
 };
@@ -0,0 +1,53 @@
+CryptoTests = {}
+
+function CryptoTests:include(includes)
+	if includes:handle(self:name()) then
+		includedirs {
+			path.join(TestFolder(), "CryptoTests")
+		}
+	end
+end
+
+function CryptoTests:link(links)
+	
+end
+
+function CryptoTests:use()
+	
+end
+
+function CryptoTests:name()
+    return "CryptoTests"
+end
+
+function CryptoTests:project()
+	local folder = TestFolder()
+	local includes = Includes:create()
+	local links = Links:create()
+
+	project(self:name())
+        targetdir(TargetDirectoryTest)
+		location "%{wks.location}/test/%{prj.name}"
+		kind "ConsoleApp"
+		language "C++"
+		
+		files {
+			path.join(folder, "CryptoTests/**.h"), 
+			path.join(folder, "CryptoTests/**.cpp")
+		}
+		
+        vpaths {
+			["*"] = {
+				path.join(folder, "CryptoTests")
+			}
+		}
+		
+		self:include(includes)
+		Crypto:include(includes)
+		salsa20:include(includes)
+		catch2:include(includes)
+
+		links:linkto(Crypto)
+		links:linkto(catch2)
+		links:linkall()
+end
@@ -0,0 +1,128 @@
+#include "Impl/Salsa20Kernel.h"
+
+#include "salsa20.h"
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    class NamedKernel
+    {
+    public:
+        std::string m_name;
+        salsa20::kernel_t m_kernel;
+    };
+
+    /**
+     * \brief Returns all kernels that the cpu of this machine can run.
+     */
+    std::vector<NamedKernel> GetSupportedKernels()
+    {
+        std::vector<NamedKernel> kernels{
+            {"Scalar", salsa20::ProcessScalar},
+        };
+
+#ifdef SALSA20_X86_KERNELS
+        // The fastest supported kernel is chosen, so the kernels before it are supported as well
+        const auto fastestKernel = salsa20::GetKernel();
+        if (fastestKernel == salsa20::ProcessSse2 || fastestKernel == salsa20::ProcessAvx2)
+            kernels.emplace_back("SSE2", salsa20::ProcessSse2);
+        if (fastestKernel == salsa20::ProcessAvx2)
+            kernels.emplace_back("AVX2", salsa20::ProcessAvx2);
+#endif
+
+        return kernels;
+    }
+
+    salsa20_ctx_t CreateContext(const uint32_t counter)
+    {
+        uint8_t key[32];
+        for (auto i = 0u; i < sizeof(key); i++)
+            key[i] = static_cast<uint8_t>(i * 7u + 3u);
+
+        uint8_t iv[8];
+        for (auto i = 0u; i < sizeof(iv); i++)
+            iv[i] = static_cast<uint8_t>(0xA0u + i);
+
+        salsa20_ctx_t context{};
+        Salsa20_KeySetup(&context, key, 256);
+        Salsa20_IVSetup(&context, iv);
+
+        // Words 8 and 9 are the block counter
+        context.m_input[8] = counter;
+
+        return context;
+    }
+
+    std::vector<uint8_t> CreateInput(const size_t size)
+    {
+        std::vector<uint8_t> input(size);
+        auto value = 0x9E3779B9u;
+        for (auto& byte : input)
+        {
+            value = value * 1664525u + 1013904223u;
+            byte = static_cast<uint8_t>(value >> 24u);
+        }
+
+        return input;
+    }
+
+    TEST_CASE("Salsa20Kernel: All kernels match the reference implementation", "[crypto][salsa20]")
+    {
+        // Lengths around the block sizes of the kernels: 64 bytes for the scalar kernel, 256 for SSE2 and 512 for AVX2
+        const auto length = GENERATE(0u, 1u, 7u, 63u, 64u, 65u, 127u, 255u, 256u, 257u, 511u, 512u, 513u, 1000u, 4097u);
+        const auto offset = GENERATE(0u, 1u, 3u, 13u);
+        const auto counter = GENERATE(0u, 0xFFFFFFFEu);
+
+        const auto input = CreateInput(length + offset);
+
+        // Multiple calls continue the keystream at the next block
+        constexpr auto CALL_COUNT = 3u;
+
+        auto referenceContext = CreateContext(counter);
+        std::vector<uint8_t> expected(CALL_COUNT * length);
+        for (auto call = 0u; call < CALL_COUNT; call++)
+            Salsa20_Encrypt_Bytes(&referenceContext, input.data() + offset, expected.data() + call * length, static_cast<uint32_t>(length));
+
+        for (const auto& [name, kernel] : GetSupportedKernels())
+        {
+            INFO("Kernel: " << name << ", length: " << length << ", offset: " << offset << ", counter: " << counter);
+
+            auto context = CreateContext(counter);
+            std::vector<uint8_t> output(CALL_COUNT * length + offset);
+            for (auto call = 0u; call < CALL_COUNT; call++)
+                kernel(context.m_input, input.data() + offset, output.data() + offset + call * length, length);
+
+            REQUIRE(std::equal(expected.begin(), expected.end(), output.begin() + offset));
+            REQUIRE(std::memcmp(context.m_input, referenceContext.m_input, sizeof(context.m_input)) == 0);
+        }
+    }
+
+    TEST_CASE("Salsa20Kernel: All kernels can process data in place", "[crypto][salsa20]")
+    {
+        const auto length = GENERATE(1u, 64u, 300u, 1025u);
+        const auto offset = GENERATE(0u, 5u);
+
+        const auto input = CreateInput(length + offset);
+
+        auto referenceContext = CreateContext(0u);
+        std::vector<uint8_t> expected(length);
+        Salsa20_Encrypt_Bytes(&referenceContext, input.data() + offset, expected.data(), static_cast<uint32_t>(length));
+
+        for (const auto& [name, kernel] : GetSupportedKernels())
+        {
+            INFO("Kernel: " << name << ", length: " << length << ", offset: " << offset);
+
+            auto context = CreateContext(0u);
+            auto data = input;
+            kernel(context.m_input, data.data() + offset, data.data() + offset, length);
+
+            REQUIRE(std::equal(expected.begin(), expected.end(), data.begin() + offset));
+        }
+    }
+} // namespace
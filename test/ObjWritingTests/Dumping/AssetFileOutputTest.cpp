@@ -0,0 +1,332 @@
+#include "Dumping/AssetFileOutput.h"
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    class TempFolder
+    {
+    public:
+        fs::path m_path;
+
+        explicit TempFolder(const std::string& name)
+            : m_path(fs::temp_directory_path() / name)
+        {
+            fs::remove_all(m_path);
+            fs::create_directories(m_path);
+        }
+
+        ~TempFolder()
+        {
+            std::error_code ec;
+            fs::remove_all(m_path, ec);
+        }
+
+        TempFolder(const TempFolder& other) = delete;
+        TempFolder(TempFolder&& other) noexcept = delete;
+        TempFolder& operator=(const TempFolder& other) = delete;
+        TempFolder& operator=(TempFolder&& other) noexcept = delete;
+    };
+
+    std::string ReadFile(const fs::path& path)
+    {
+        std::ifstream stream(path, std::fstream::in | std::fstream::binary);
+        REQUIRE(stream.is_open());
+
+        return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+
+    void WriteFiles(AssetFileOutput& output, const fs::path& folder, const unsigned threadCount, const unsigned fileCount)
+    {
+        // Assertions cannot be made on other threads
+        std::atomic_bool openFailed = false;
+
+        std::vector<std::thread> threads;
+        for (auto threadIndex = 0u; threadIndex < threadCount; threadIndex++)
+        {
+            threads.emplace_back(
+                [&output, &folder, &openFailed, threadIndex, threadCount, fileCount]
+                {
+                    for (auto fileIndex = threadIndex; fileIndex < fileCount; fileIndex += threadCount)
+                    {
+                        const auto file = output.Open(folder / std::format("folder_{}", fileIndex % 7u) / std::format("file_{}.txt", fileIndex));
+                        if (!file)
+                        {
+                            openFailed = true;
+                            continue;
+                        }
+
+                        *file << std::format("content of file {}\n", fileIndex);
+                    }
+                });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        REQUIRE(!openFailed);
+    }
+
+    void CheckFiles(const AssetFileOutput& output, const fs::path& folder, const unsigned fileCount)
+    {
+        uint64_t byteCount = 0u;
+        for (auto fileIndex = 0u; fileIndex < fileCount; fileIndex++)
+        {
+            const auto expectedContent = std::format("content of file {}\n", fileIndex);
+            REQUIRE(ReadFile(folder / std::format("folder_{}", fileIndex % 7u) / std::format("file_{}.txt", fileIndex)) == expectedContent);
+            byteCount += expectedContent.size();
+        }
+
+        REQUIRE(output.GetWrittenFileCount() == fileCount);
+        REQUIRE(output.GetWrittenByteCount() == byteCount);
+    }
+
+    void DumpFiles(AssetFileOutput& output, const fs::path& folder, const std::vector<std::pair<std::string, std::string>>& files)
+    {
+        for (const auto& [filePath, content] : files)
+        {
+            const auto file = output.Open(folder / filePath);
+            REQUIRE(file);
+            *file << content;
+        }
+
+        REQUIRE(output.Close());
+    }
+
+    // Files that are written again get a new last write time, so it is set to one in the past to be able to tell
+    const auto OLD_WRITE_TIME = fs::file_time_type::clock::now() - std::chrono::hours(24);
+
+    void SetOldWriteTime(const fs::path& folder, const std::vector<std::pair<std::string, std::string>>& files)
+    {
+        for (const auto& [filePath, content] : files)
+            fs::last_write_time(folder / filePath, OLD_WRITE_TIME);
+    }
+
+    TEST_CASE("AssetFileOutput: Writes files and creates their folders", "[dumping][output]")
+    {
+        const TempFolder folder("oat_assetfileoutput_sync");
+
+        AssetFileOutput output(AssetFileOutput::DEFAULT_WRITE_BUFFER_SIZE, false);
+        WriteFiles(output, folder.m_path, 4u, 100u);
+
+        REQUIRE(output.Close());
+        CheckFiles(output, folder.m_path, 100u);
+    }
+
+    TEST_CASE("AssetFileOutput: Writes files on the writer thread with async writing", "[dumping][output]")
+    {
+        const TempFolder folder("oat_assetfileoutput_async");
+
+        AssetFileOutput output(AssetFileOutput::DEFAULT_WRITE_BUFFER_SIZE, true);
+        WriteFiles(output, folder.m_path, 4u, 100u);
+
+        REQUIRE(output.Close());
+        CheckFiles(output, folder.m_path, 100u);
+    }
+
+    TEST_CASE("AssetFileOutput: Writes files larger than the write buffer", "[dumping][output]")
+    {
+        const TempFolder folder("oat_assetfileoutput_large");
+        const std::string data(100000u, 'x');
+
+        AssetFileOutput output(1024u, false);
+        {
+            const auto file = output.Open(folder.m_path / "large.bin");
+            REQUIRE(file);
+            file->write(data.data(), static_cast<std::streamsize>(data.size()));
+        }
+
+        REQUIRE(output.Close());
+        REQUIRE(ReadFile(folder.m_path / "large.bin") == data);
+        REQUIRE(output.GetWrittenByteCount() == data.size());
+    }
+
+    TEST_CASE("AssetFileOutput: Fails to close when a file could not be opened", "[dumping][output]")
+    {
+        const TempFolder folder("oat_assetfileoutput_failure");
+
+        // A file that is in the way of a folder cannot be replaced by it
+        std::ofstream(folder.m_path / "blocked").put('x');
+
+        AssetFileOutput output(AssetFileOutput::DEFAULT_WRITE_BUFFER_SIZE, false);
+        REQUIRE(output.Open(folder.m_path / "blocked" / "file.txt") == nullptr);
+
+        REQUIRE(!output.Close());
+        REQUIRE(output.GetWrittenFileCount() == 0u);
+    }
+
+    TEST_CASE("AssetFileOutput: Fails to close when a file could not be written with async writing", "[dumping][output]")
+    {
+        const TempFolder folder("oat_assetfileoutput_async_failure");
+
+        std::ofstream(folder.m_path / "blocked").put('x');
+
+        AssetFileOutput output(AssetFileOutput::DEFAULT_WRITE_BUFFER_SIZE, true);
+        {
+            // The file is only written once it is closed, so opening it cannot fail yet
+            const auto file = output.Open(folder.m_path / "blocked" / "file.txt");
+            REQUIRE(file);
+            *file << "content";
+        }
+        {
+            const auto file = output.Open(folder.m_path / "file.txt");
+            REQUIRE(file);
+            *file << "content";
+        }
+
+        REQUIRE(!output.Close());
+        REQUIRE(output.GetWrittenFileCount() == 1u);
+        REQUIRE(ReadFile(folder.m_path / "file.txt") == "content");
+    }
+
+    TEST_CASE("AssetFileOutput: Does not write unchanged files in incremental mode", "[dumping][output][incremental]")
+    {
+        const TempFolder folder("oat_assetfileoutput_incremental");
+        const auto asyncWrite = GENERATE(false, true);
+
+        const std::vector<std::pair<std::string, std::string>> files{
+            {"first.txt",      "first content" },
+            {"sub/second.txt", "second content"},
+            {"sub/third.txt",  "third content" },
+        };
+
+        {
+            AssetFileOutput output(AssetFileOutput::DEFAULT_WRITE_BUFFER_SIZE, asyncWrite);
+            output.EnableIncremental(folder.m_path, nullptr);
+            DumpFiles(output, folder.m_path, files);
+
+            REQUIRE(output.GetWrittenFileCount() == 3u);
+            REQUIRE(output.GetUnchangedFileCount() == 0u);
+        }
+
+        SetOldWriteTime(folder.m_path, files);
+
+        auto changedFiles = files;
+        changedFiles[1].second = "changed content";
+
+        AssetFileOutput output(AssetFileOutput::DEFAULT_WRITE_BUFFER_SIZE, asyncWrite);
+        output.EnableIncremental(folder.m_path, nullptr);
+        DumpFiles(output, folder.m_path, changedFiles);
+
+        REQUIRE(output.GetWrittenFileCount() == 1u);
+        REQUIRE(output.GetUnchangedFileCount() == 2u);
+
+        REQUIRE(ReadFile(folder.m_path / "sub" / "second.txt") == "changed content");
+        REQUIRE(fs::last_write_time(folder.m_path / "sub" / "second.txt") != OLD_WRITE_TIME);
+        REQUIRE(fs::last_write_time(folder.m_path / "first.txt") == OLD_WRITE_TIME);
+        REQUIRE(fs::last_write_time(folder.m_path / "sub" / "third.txt") == OLD_WRITE_TIME);
+    }
+
+    TEST_CASE("AssetFileOutput: Creates manifest of written and unchanged files in incremental mode", "[dumping][output][incremental]")
+    {
+        const TempFolder folder("oat_assetfileoutput_incremental_manifest");
+
+        const std::vector<std::pair<std::string, std::string>> files{
+            {"first.txt",      "first content" },
+            {"sub/second.txt", "second content"},
+        };
+
+        {
+            AssetFileOutput output(AssetFileOutput::DEFAULT_WRITE_BUFFER_SIZE, false);
+            output.EnableIncremental(folder.m_path, nullptr);
+            DumpFiles(output, folder.m_path, files);
+        }
+
+        AssetFileOutput output(AssetFileOutput::DEFAULT_WRITE_BUFFER_SIZE, false);
+        output.EnableIncremental(folder.m_path, nullptr);
+        DumpFiles(output, folder.m_path, files);
+        REQUIRE(output.GetUnchangedFileCount() == 2u);
+
+        const auto manifest = output.CreateManifest("test key");
+        REQUIRE(manifest.m_key == "test key");
+        REQUIRE(manifest.m_files.size() == files.size());
+
+        for (const auto& [filePath, content] : files)
+        {
+            const auto entry = manifest.m_files.find(filePath);
+            REQUIRE(entry != manifest.m_files.end());
+            REQUIRE(entry->second.m_size == content.size());
+            REQUIRE(entry->second.m_hash == DumpManifest::ComputeHash(content.data(), content.size()));
+            REQUIRE(entry->second.m_last_write_time == DumpManifest::ToManifestTime(fs::last_write_time(folder.m_path / filePath)));
+        }
+
+        REQUIRE(manifest.FilesAreUnchanged(folder.m_path));
+    }
+
+    TEST_CASE("AssetFileOutput: Compares files with the hash of the previous manifest in incremental mode", "[dumping][output][incremental]")
+    {
+        const TempFolder folder("oat_assetfileoutput_incremental_previous");
+
+        const std::vector<std::pair<std::string, std::string>> files{
+            {"first.txt",  "first content" },
+            {"second.txt", "second content"},
+        };
+
+        std::unique_ptr<DumpManifest> previousManifest;
+        {
+            AssetFileOutput output(AssetFileOutput::DEFAULT_WRITE_BUFFER_SIZE, false);
+            output.EnableIncremental(folder.m_path, nullptr);
+            DumpFiles(output, folder.m_path, files);
+            previousManifest = std::make_unique<DumpManifest>(output.CreateManifest("key"));
+        }
+
+        // Files that were not touched since the previous dump are not read back, so a recorded hash that does not match
+        // the content makes the file count as changed even though the content on disk is the same
+        previousManifest->m_files["second.txt"].m_hash = "0000";
+
+        AssetFileOutput output(AssetFileOutput::DEFAULT_WRITE_BUFFER_SIZE, false);
+        output.EnableIncremental(folder.m_path, std::move(previousManifest));
+        DumpFiles(output, folder.m_path, files);
+
+        REQUIRE(output.GetWrittenFileCount() == 1u);
+        REQUIRE(output.GetUnchangedFileCount() == 1u);
+        REQUIRE(ReadFile(folder.m_path / "second.txt") == "second content");
+    }
+
+    TEST_CASE("AssetFileOutput: Ignores incremental mode when writing into an archive", "[dumping][output][incremental]")
+    {
+        const TempFolder folder("oat_assetfileoutput_incremental_archive");
+
+        class MemoryArchiveWriter final : public IArchiveWriter
+        {
+        public:
+            void AddFile(std::string path, std::string data) override
+            {
+                m_files.emplace_back(std::move(path), std::move(data));
+            }
+
+            bool Write() override
+            {
+                return true;
+            }
+
+            std::vector<std::pair<std::string, std::string>> m_files;
+        };
+
+        auto archive = std::make_unique<MemoryArchiveWriter>();
+        auto* archivePtr = archive.get();
+
+        AssetFileOutput output(std::make_unique<std::ostringstream>(), std::move(archive), folder.m_path);
+        output.EnableIncremental(folder.m_path, nullptr);
+        DumpFiles(output, folder.m_path, {{"file.txt", "content"}});
+
+        REQUIRE(output.GetWrittenFileCount() == 1u);
+        REQUIRE(output.GetUnchangedFileCount() == 0u);
+        REQUIRE(archivePtr->m_files.size() == 1u);
+        REQUIRE(output.CreateManifest("key").m_files.empty());
+    }
+} // namespace
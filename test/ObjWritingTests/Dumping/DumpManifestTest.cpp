@@ -0,0 +1,182 @@
+#include "Dumping/DumpManifest.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    class TempFolder
+    {
+    public:
+        fs::path m_path;
+
+        explicit TempFolder(const std::string& name)
+            : m_path(fs::temp_directory_path() / name)
+        {
+            fs::remove_all(m_path);
+            fs::create_directories(m_path);
+        }
+
+        ~TempFolder()
+        {
+            std::error_code ec;
+            fs::remove_all(m_path, ec);
+        }
+
+        TempFolder(const TempFolder& other) = delete;
+        TempFolder(TempFolder&& other) noexcept = delete;
+        TempFolder& operator=(const TempFolder& other) = delete;
+        TempFolder& operator=(TempFolder&& other) noexcept = delete;
+    };
+
+    void WriteFile(const fs::path& path, const std::string& content)
+    {
+        fs::create_directories(path.parent_path());
+        std::ofstream stream(path, std::fstream::out | std::fstream::binary | std::fstream::trunc);
+        stream << content;
+        REQUIRE(stream.good());
+    }
+
+    void AddFile(DumpManifest& manifest, const fs::path& outputFolder, const std::string& filePath, const std::string& content)
+    {
+        const auto fullPath = outputFolder / filePath;
+        WriteFile(fullPath, content);
+
+        manifest.m_files[filePath] = DumpManifest::Entry{
+            .m_size = content.size(),
+            .m_last_write_time = DumpManifest::ToManifestTime(fs::last_write_time(fullPath)),
+            .m_hash = DumpManifest::ComputeHash(content.data(), content.size()),
+        };
+    }
+
+    TEST_CASE("DumpManifest: Can read written manifests", "[dumping][manifest]")
+    {
+        const TempFolder folder("oat_dumpmanifest_roundtrip");
+        const auto manifestPath = folder.m_path / "zone_source" / "test.manifest";
+
+        DumpManifest manifest;
+        manifest.m_key = "0123456789abcdef";
+        manifest.m_files["images/test.iwi"] = DumpManifest::Entry{.m_size = 1234u, .m_last_write_time = 5678, .m_hash = "aabbcc"};
+        manifest.m_files["maps/mp/file with spaces.gsc"] = DumpManifest::Entry{.m_size = 0u, .m_last_write_time = -42, .m_hash = "ddeeff"};
+
+        REQUIRE(manifest.Write(manifestPath));
+        REQUIRE(!fs::exists(fs::path(manifestPath) += ".tmp"));
+
+        const auto readManifest = DumpManifest::Read(manifestPath);
+        REQUIRE(readManifest);
+        REQUIRE(readManifest->m_key == manifest.m_key);
+        REQUIRE(readManifest->m_files.size() == 2u);
+
+        for (const auto& [filePath, entry] : manifest.m_files)
+        {
+            const auto readEntry = readManifest->m_files.find(filePath);
+            REQUIRE(readEntry != readManifest->m_files.end());
+            REQUIRE(readEntry->second.m_size == entry.m_size);
+            REQUIRE(readEntry->second.m_last_write_time == entry.m_last_write_time);
+            REQUIRE(readEntry->second.m_hash == entry.m_hash);
+        }
+    }
+
+    TEST_CASE("DumpManifest: Writing replaces previous manifests", "[dumping][manifest]")
+    {
+        const TempFolder folder("oat_dumpmanifest_replace");
+        const auto manifestPath = folder.m_path / "test.manifest";
+
+        DumpManifest firstManifest;
+        firstManifest.m_key = "first";
+        firstManifest.m_files["first.txt"] = DumpManifest::Entry{.m_size = 1u, .m_last_write_time = 1, .m_hash = "11"};
+        REQUIRE(firstManifest.Write(manifestPath));
+
+        DumpManifest secondManifest;
+        secondManifest.m_key = "second";
+        secondManifest.m_files["second.txt"] = DumpManifest::Entry{.m_size = 2u, .m_last_write_time = 2, .m_hash = "22"};
+        REQUIRE(secondManifest.Write(manifestPath));
+
+        const auto readManifest = DumpManifest::Read(manifestPath);
+        REQUIRE(readManifest);
+        REQUIRE(readManifest->m_key == "second");
+        REQUIRE(readManifest->m_files.size() == 1u);
+        REQUIRE(readManifest->m_files.contains("second.txt"));
+    }
+
+    TEST_CASE("DumpManifest: Does not read invalid manifests", "[dumping][manifest]")
+    {
+        const TempFolder folder("oat_dumpmanifest_invalid");
+        const auto manifestPath = folder.m_path / "test.manifest";
+
+        SECTION("Missing file")
+        {
+            REQUIRE(!DumpManifest::Read(manifestPath));
+        }
+
+        SECTION("Wrong magic")
+        {
+            WriteFile(manifestPath, "SOMETHING_ELSE 1\nkey abc\n");
+            REQUIRE(!DumpManifest::Read(manifestPath));
+        }
+
+        SECTION("Wrong version")
+        {
+            WriteFile(manifestPath, "OAT_DUMP_MANIFEST 9999\nkey abc\n");
+            REQUIRE(!DumpManifest::Read(manifestPath));
+        }
+
+        SECTION("Missing key")
+        {
+            WriteFile(manifestPath, "OAT_DUMP_MANIFEST 1\n");
+            REQUIRE(!DumpManifest::Read(manifestPath));
+        }
+
+        SECTION("Malformed file entry")
+        {
+            WriteFile(manifestPath, "OAT_DUMP_MANIFEST 1\nkey abc\naabbcc notasize 5 file.txt\n");
+            REQUIRE(!DumpManifest::Read(manifestPath));
+        }
+
+        SECTION("File entry without path")
+        {
+            WriteFile(manifestPath, "OAT_DUMP_MANIFEST 1\nkey abc\naabbcc 1 5\n");
+            REQUIRE(!DumpManifest::Read(manifestPath));
+        }
+    }
+
+    TEST_CASE("DumpManifest: Detects whether dumped files changed", "[dumping][manifest]")
+    {
+        const TempFolder folder("oat_dumpmanifest_unchanged");
+
+        DumpManifest manifest;
+        manifest.m_key = "key";
+        AddFile(manifest, folder.m_path, "first.txt", "first content");
+        AddFile(manifest, folder.m_path, "sub/second.txt", "second content");
+
+        REQUIRE(manifest.FilesAreUnchanged(folder.m_path));
+
+        SECTION("Removed file")
+        {
+            fs::remove(folder.m_path / "sub" / "second.txt");
+            REQUIRE(!manifest.FilesAreUnchanged(folder.m_path));
+        }
+
+        SECTION("Changed size")
+        {
+            const auto lastWriteTime = fs::last_write_time(folder.m_path / "first.txt");
+            WriteFile(folder.m_path / "first.txt", "longer first content");
+            fs::last_write_time(folder.m_path / "first.txt", lastWriteTime);
+
+            REQUIRE(!manifest.FilesAreUnchanged(folder.m_path));
+        }
+
+        SECTION("Changed last write time")
+        {
+            const auto lastWriteTime = fs::last_write_time(folder.m_path / "first.txt");
+            fs::last_write_time(folder.m_path / "first.txt", lastWriteTime + std::chrono::seconds(10));
+
+            REQUIRE(!manifest.FilesAreUnchanged(folder.m_path));
+        }
+    }
+} // namespace
@@ -0,0 +1,122 @@
+#include "ObjContainer/IWD/IWDWriter.h"
+#include "ObjLoading.h"
+#include "SearchPath/SearchPathFilesystem.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    class TempFolder
+    {
+    public:
+        fs::path m_path;
+
+        explicit TempFolder(const std::string& name)
+            : m_path(fs::temp_directory_path() / name)
+        {
+            fs::remove_all(m_path);
+            fs::create_directories(m_path);
+        }
+
+        ~TempFolder()
+        {
+            std::error_code ec;
+            fs::remove_all(m_path, ec);
+        }
+
+        TempFolder(const TempFolder& other) = delete;
+        TempFolder(TempFolder&& other) noexcept = delete;
+        TempFolder& operator=(const TempFolder& other) = delete;
+        TempFolder& operator=(TempFolder&& other) noexcept = delete;
+    };
+
+    /**
+     * \brief Loads the IWDs of a search path while it is alive.
+     */
+    class LoadedSearchPath
+    {
+    public:
+        SearchPathFilesystem m_search_path;
+
+        explicit LoadedSearchPath(const fs::path& path)
+            : m_search_path(path.string())
+        {
+            ObjLoading::LoadIWDsInSearchPath(m_search_path);
+        }
+
+        ~LoadedSearchPath()
+        {
+            ObjLoading::UnloadIWDsInSearchPath(m_search_path);
+        }
+
+        LoadedSearchPath(const LoadedSearchPath& other) = delete;
+        LoadedSearchPath(LoadedSearchPath&& other) noexcept = delete;
+        LoadedSearchPath& operator=(const LoadedSearchPath& other) = delete;
+        LoadedSearchPath& operator=(LoadedSearchPath&& other) noexcept = delete;
+    };
+
+    void WriteIwd(const fs::path& path, const std::map<std::string, std::string>& files)
+    {
+        std::ofstream stream(path, std::fstream::out | std::fstream::binary);
+        REQUIRE(stream.is_open());
+
+        const auto writer = IWDWriter::Create(stream);
+        for (const auto& [fileName, data] : files)
+            writer->AddFile(fileName, data);
+
+        REQUIRE(writer->Write());
+    }
+
+    std::string ReadFile(ISearchPath& searchPath, const std::string& fileName)
+    {
+        const auto file = searchPath.Open(fileName);
+        REQUIRE(file.IsOpen());
+
+        std::string data(static_cast<size_t>(file.m_length), '\0');
+        file.m_stream->read(data.data(), file.m_length);
+        REQUIRE(file.m_stream->gcount() == file.m_length);
+
+        return data;
+    }
+
+    TEST_CASE("ObjLoading: IWD search paths of a search path only contain its own IWDs", "[iwd][searchpath]")
+    {
+        // Two zone directories that both ship an IWD with a file of the same name
+        const TempFolder firstFolder("oat_iwd_search_paths_first");
+        const TempFolder secondFolder("oat_iwd_search_paths_second");
+        WriteIwd(firstFolder.m_path / "data.iwd", {{"images/colliding.iwi", "first"}});
+        WriteIwd(secondFolder.m_path / "data.iwd", {{"images/colliding.iwi", "second"}});
+
+        LoadedSearchPath firstSearchPath(firstFolder.m_path);
+        LoadedSearchPath secondSearchPath(secondFolder.m_path);
+
+        auto firstIwds = ObjLoading::GetIWDSearchPaths(firstSearchPath.m_search_path);
+        auto secondIwds = ObjLoading::GetIWDSearchPaths(secondSearchPath.m_search_path);
+
+        REQUIRE(ReadFile(firstIwds, "images/colliding.iwi") == "first");
+        REQUIRE(ReadFile(secondIwds, "images/colliding.iwi") == "second");
+
+        // All loaded IWDs together can only provide one of the colliding files
+        auto allIwds = ObjLoading::GetIWDSearchPaths();
+        REQUIRE(ReadFile(allIwds, "images/colliding.iwi") == "first");
+    }
+
+    TEST_CASE("ObjLoading: IWD search paths of a search path without IWDs are empty", "[iwd][searchpath]")
+    {
+        const TempFolder iwdFolder("oat_iwd_search_paths_with_iwd");
+        const TempFolder emptyFolder("oat_iwd_search_paths_without_iwd");
+        WriteIwd(iwdFolder.m_path / "data.iwd", {{"images/file.iwi", "data"}});
+
+        LoadedSearchPath iwdSearchPath(iwdFolder.m_path);
+        LoadedSearchPath emptySearchPath(emptyFolder.m_path);
+
+        auto emptyIwds = ObjLoading::GetIWDSearchPaths(emptySearchPath.m_search_path);
+        REQUIRE(!emptyIwds.Open("images/file.iwi").IsOpen());
+    }
+} // namespace
@@ -0,0 +1,150 @@
+#include "ObjContainer/IWD/IWDWriter.h"
+
+#include "ObjContainer/IWD/IWD.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    class TempIwdFile
+    {
+    public:
+        fs::path m_path;
+
+        explicit TempIwdFile(const std::string& name)
+            : m_path(fs::temp_directory_path() / name)
+        {
+        }
+
+        ~TempIwdFile()
+        {
+            std::error_code ec;
+            fs::remove(m_path, ec);
+        }
+
+        TempIwdFile(const TempIwdFile& other) = delete;
+        TempIwdFile(TempIwdFile&& other) noexcept = delete;
+        TempIwdFile& operator=(const TempIwdFile& other) = delete;
+        TempIwdFile& operator=(TempIwdFile&& other) noexcept = delete;
+    };
+
+    void WriteIwd(const fs::path& path, const std::map<std::string, std::string>& files)
+    {
+        std::ofstream stream(path, std::fstream::out | std::fstream::binary);
+        REQUIRE(stream.is_open());
+
+        const auto writer = IWDWriter::Create(stream);
+        for (const auto& [fileName, data] : files)
+            writer->AddFile(fileName, data);
+
+        REQUIRE(writer->Write());
+    }
+
+    std::map<std::string, std::string> ReadIwd(const fs::path& path)
+    {
+        IWD iwd(path.string(), std::make_unique<std::ifstream>(path, std::fstream::in | std::fstream::binary));
+        REQUIRE(iwd.Initialize());
+
+        std::vector<std::string> fileNames;
+        iwd.Find(SearchPathSearchOptions().IncludeSubdirectories(true),
+                 [&fileNames](const std::string& fileName)
+                 {
+                     fileNames.emplace_back(fileName);
+                 });
+
+        std::map<std::string, std::string> files;
+        for (const auto& fileName : fileNames)
+        {
+            const auto file = iwd.Open(fileName);
+            REQUIRE(file.IsOpen());
+
+            std::string data(static_cast<size_t>(file.m_length), '\0');
+            file.m_stream->read(data.data(), file.m_length);
+            REQUIRE(file.m_stream->gcount() == file.m_length);
+
+            files.emplace(fileName, std::move(data));
+        }
+
+        return files;
+    }
+
+    TEST_CASE("IWDWriter: Written files can be read back", "[iwd][archive]")
+    {
+        const TempIwdFile iwdFile("oat_iwdwriter_roundtrip.iwd");
+
+        std::string compressibleData;
+        for (auto i = 0u; i < 10000u; i++)
+            compressibleData += "compressible ";
+
+        // Random looking data does not get smaller and is stored
+        std::string incompressibleData(4096u, '\0');
+        auto value = 0x12345678u;
+        for (auto& c : incompressibleData)
+        {
+            value = value * 1664525u + 1013904223u;
+            c = static_cast<char>(value >> 24u);
+        }
+
+        const std::map<std::string, std::string> files{
+            {"empty.txt",                ""                },
+            {"images/compressible.iwi",  compressibleData  },
+            {"sound/nested/random.wav",  incompressibleData},
+            {"zone_source/mp_test.zone", "// A zone\n"     },
+        };
+
+        WriteIwd(iwdFile.m_path, files);
+
+        REQUIRE(ReadIwd(iwdFile.m_path) == files);
+        REQUIRE(fs::file_size(iwdFile.m_path) < compressibleData.size());
+    }
+
+    TEST_CASE("IWDWriter: Files can be added from multiple threads", "[iwd][archive]")
+    {
+        const TempIwdFile iwdFile("oat_iwdwriter_threads.iwd");
+
+        std::map<std::string, std::string> files;
+        for (auto i = 0u; i < 200u; i++)
+            files.emplace(std::format("files/file_{}.txt", i), std::string(i * 37u, static_cast<char>('a' + i % 26u)));
+
+        {
+            std::ofstream stream(iwdFile.m_path, std::fstream::out | std::fstream::binary);
+            REQUIRE(stream.is_open());
+
+            const auto writer = IWDWriter::Create(stream);
+
+            std::vector<std::thread> threads;
+            for (auto threadIndex = 0u; threadIndex < 4u; threadIndex++)
+            {
+                threads.emplace_back(
+                    [&files, &writer, threadIndex]
+                    {
+                        auto fileIndex = 0u;
+                        for (const auto& [fileName, data] : files)
+                        {
+                            if (fileIndex++ % 4u == threadIndex)
+                                writer->AddFile(fileName, data);
+                        }
+                    });
+            }
+
+            for (auto& thread : threads)
+                thread.join();
+
+            REQUIRE(writer->Write());
+        }
+
+        REQUIRE(ReadIwd(iwdFile.m_path) == files);
+    }
+} // namespace
@@ -0,0 +1,145 @@
+#include "ObjContainer/Tar/TarWriter.h"
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <format>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr size_t BLOCK_SIZE = 512u;
+
+    uint64_t ReadOctal(const char* field, const size_t fieldSize)
+    {
+        uint64_t value = 0u;
+        for (auto i = 0u; i < fieldSize && field[i] >= '0' && field[i] <= '7'; i++)
+            value = value * 8u + static_cast<uint64_t>(field[i] - '0');
+
+        return value;
+    }
+
+    std::string ReadString(const char* field, const size_t fieldSize)
+    {
+        return std::string(field, strnlen(field, fieldSize));
+    }
+
+    /**
+     * \brief Reads the regular files of a ustar archive including the long names of GNU tar.
+     */
+    std::vector<std::pair<std::string, std::string>> ReadTar(const std::string& archive)
+    {
+        REQUIRE(archive.size() % BLOCK_SIZE == 0u);
+
+        std::vector<std::pair<std::string, std::string>> files;
+        std::string longName;
+        size_t offset = 0u;
+        while (true)
+        {
+            REQUIRE(offset + BLOCK_SIZE <= archive.size());
+            const auto* header = archive.data() + offset;
+            offset += BLOCK_SIZE;
+
+            // The archive ends with two empty blocks
+            if (header[0] == '\0')
+            {
+                REQUIRE(offset + BLOCK_SIZE == archive.size());
+                REQUIRE(archive.find_first_not_of('\0', offset - BLOCK_SIZE) == std::string::npos);
+                return files;
+            }
+
+            REQUIRE(std::memcmp(header + 257, "ustar", 6u) == 0);
+
+            unsigned checksum = 0u;
+            for (auto i = 0u; i < BLOCK_SIZE; i++)
+                checksum += i >= 148u && i < 156u ? static_cast<unsigned>(' ') : static_cast<unsigned char>(header[i]);
+            REQUIRE(ReadOctal(header + 148, 8u) == checksum);
+
+            const auto size = ReadOctal(header + 124, 12u);
+            REQUIRE(offset + size <= archive.size());
+            std::string data(archive.data() + offset, size);
+            offset += (size + BLOCK_SIZE - 1u) / BLOCK_SIZE * BLOCK_SIZE;
+
+            const auto typeFlag = header[156];
+            if (typeFlag == 'L')
+            {
+                longName = ReadString(data.data(), data.size());
+                continue;
+            }
+
+            REQUIRE(typeFlag == '0');
+
+            std::string fileName;
+            if (!longName.empty())
+                fileName = std::move(longName);
+            else
+            {
+                const auto prefix = ReadString(header + 345, 155u);
+                fileName = ReadString(header, 100u);
+                if (!prefix.empty())
+                    fileName = std::format("{}/{}", prefix, fileName);
+            }
+
+            longName.clear();
+            files.emplace_back(std::move(fileName), std::move(data));
+        }
+    }
+
+    TEST_CASE("TarWriter: Written files can be read back in the order they were added", "[tar][archive]")
+    {
+        const std::string prefixedName = std::string(120u, 'p') + "/" + std::string(90u, 'n') + ".txt";
+        const std::string longName = "folder/" + std::string(300u, 'l') + ".txt";
+
+        const std::vector<std::pair<std::string, std::string>> files{
+            {"empty.txt",                ""                          },
+            {"zone_source/mp_test.zone", "// A zone\n"               },
+            {"block_sized.bin",          std::string(BLOCK_SIZE, 'b')},
+            {prefixedName,               "has a prefix"              },
+            {longName,                   std::string(1000u, 'x')     },
+        };
+
+        std::ostringstream stream;
+        const auto writer = TarWriter::Create(stream);
+        for (const auto& [fileName, data] : files)
+            writer->AddFile(fileName, data);
+
+        REQUIRE(writer->Write());
+        REQUIRE(ReadTar(stream.str()) == files);
+    }
+
+    TEST_CASE("TarWriter: Files can be added from multiple threads", "[tar][archive]")
+    {
+        std::vector<std::pair<std::string, std::string>> files;
+        for (auto i = 0u; i < 200u; i++)
+            files.emplace_back(std::format("files/file_{}.txt", i), std::string(i * 37u, static_cast<char>('a' + i % 26u)));
+
+        std::ostringstream stream;
+        const auto writer = TarWriter::Create(stream);
+
+        std::vector<std::thread> threads;
+        for (auto threadIndex = 0u; threadIndex < 4u; threadIndex++)
+        {
+            threads.emplace_back(
+                [&files, &writer, threadIndex]
+                {
+                    for (auto fileIndex = threadIndex; fileIndex < files.size(); fileIndex += 4u)
+                        writer->AddFile(files[fileIndex].first, files[fileIndex].second);
+                });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        REQUIRE(writer->Write());
+
+        // The order of files added from multiple threads is not defined
+        auto readFiles = ReadTar(stream.str());
+        std::ranges::sort(readFiles);
+        std::ranges::sort(files);
+        REQUIRE(readFiles == files);
+    }
+} // namespace
@@ -0,0 +1,188 @@
+#include "Utils/OutputCapture.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <format>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /**
+     * \brief Replaces the buffers of std::cout and std::cerr with string buffers, so that what is printed can be checked.
+     */
+    class PrintedOutput
+    {
+    public:
+        PrintedOutput()
+            : m_previous_out_buffer(std::cout.rdbuf(m_out.rdbuf())),
+              m_previous_err_buffer(std::cerr.rdbuf(m_err.rdbuf()))
+        {
+        }
+
+        ~PrintedOutput()
+        {
+            std::cout.rdbuf(m_previous_out_buffer);
+            std::cerr.rdbuf(m_previous_err_buffer);
+        }
+
+        PrintedOutput(const PrintedOutput& other) = delete;
+        PrintedOutput(PrintedOutput&& other) noexcept = delete;
+        PrintedOutput& operator=(const PrintedOutput& other) = delete;
+        PrintedOutput& operator=(PrintedOutput&& other) noexcept = delete;
+
+        [[nodiscard]] std::string Out() const
+        {
+            return m_out.str();
+        }
+
+        [[nodiscard]] std::string Err() const
+        {
+            return m_err.str();
+        }
+
+    private:
+        std::ostringstream m_out;
+        std::ostringstream m_err;
+        std::streambuf* m_previous_out_buffer;
+        std::streambuf* m_previous_err_buffer;
+    };
+
+    TEST_CASE("OutputCapture: Prints directly without an active capture", "[utils][outputcapture]")
+    {
+        std::string out;
+        std::string err;
+        {
+            const PrintedOutput printed;
+            const OutputCapture::Redirection redirection;
+
+            std::cout << "out text\n";
+            std::cerr << "err text\n";
+
+            out = printed.Out();
+            err = printed.Err();
+        }
+
+        REQUIRE(out == "out text\n");
+        REQUIRE(err == "err text\n");
+    }
+
+    TEST_CASE("OutputCapture: Keeps output of the active capture until it is printed", "[utils][outputcapture]")
+    {
+        std::string outBeforePrint;
+        std::string errBeforePrint;
+        std::string out;
+        std::string err;
+        {
+            const PrintedOutput printed;
+            const OutputCapture::Redirection redirection;
+
+            OutputCapture capture;
+            {
+                const OutputCapture::Activation activation(capture);
+                std::cout << "first " << 1 << '\n';
+                std::cerr << "second\n";
+                std::cout << "third" << std::endl;
+            }
+
+            outBeforePrint = printed.Out();
+            errBeforePrint = printed.Err();
+
+            capture.Print();
+
+            out = printed.Out();
+            err = printed.Err();
+        }
+
+        REQUIRE(outBeforePrint.empty());
+        REQUIRE(errBeforePrint.empty());
+        REQUIRE(out == "first 1\nthird\n");
+        REQUIRE(err == "second\n");
+    }
+
+    TEST_CASE("OutputCapture: Does not capture without a redirection", "[utils][outputcapture]")
+    {
+        std::string out;
+        {
+            const PrintedOutput printed;
+
+            OutputCapture capture;
+            {
+                const OutputCapture::Activation activation(capture);
+                std::cout << "text\n";
+            }
+
+            out = printed.Out();
+        }
+
+        REQUIRE(out == "text\n");
+    }
+
+    TEST_CASE("OutputCapture: Nested redirections keep capturing", "[utils][outputcapture]")
+    {
+        std::string outBeforePrint;
+        std::string out;
+        {
+            const PrintedOutput printed;
+            const OutputCapture::Redirection redirection;
+
+            OutputCapture capture;
+            {
+                const OutputCapture::Redirection nestedRedirection;
+                const OutputCapture::Activation activation(capture);
+                std::cout << "text\n";
+            }
+
+            outBeforePrint = printed.Out();
+            capture.Print();
+            out = printed.Out();
+        }
+
+        REQUIRE(outBeforePrint.empty());
+        REQUIRE(out == "text\n");
+    }
+
+    TEST_CASE("OutputCapture: Prints output of concurrent threads in a deterministic order", "[utils][outputcapture]")
+    {
+        constexpr auto THREAD_COUNT = 8u;
+        constexpr auto LINE_COUNT = 100u;
+
+        std::string out;
+        {
+            const PrintedOutput printed;
+            const OutputCapture::Redirection redirection;
+
+            std::vector<OutputCapture> captures(THREAD_COUNT);
+            std::vector<std::thread> threads;
+            for (auto threadIndex = 0u; threadIndex < THREAD_COUNT; threadIndex++)
+            {
+                threads.emplace_back(
+                    [&capture = captures[threadIndex], threadIndex]
+                    {
+                        const OutputCapture::Activation activation(capture);
+                        for (auto line = 0u; line < LINE_COUNT; line++)
+                            std::cout << std::format("thread {} line {}\n", threadIndex, line);
+                    });
+            }
+
+            for (auto& thread : threads)
+                thread.join();
+
+            for (const auto& capture : captures)
+                capture.Print();
+
+            out = printed.Out();
+        }
+
+        std::string expectedOut;
+        for (auto threadIndex = 0u; threadIndex < THREAD_COUNT; threadIndex++)
+        {
+            for (auto line = 0u; line < LINE_COUNT; line++)
+                expectedOut += std::format("thread {} line {}\n", threadIndex, line);
+        }
+
+        REQUIRE(out == expectedOut);
+    }
+} // namespace
@@ -0,0 +1,112 @@
+#include "Utils/ThreadPool.h"
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace
+{
+    TEST_CASE("ThreadPool: Has at least one worker thread", "[utils][threadpool]")
+    {
+        const ThreadPool emptyPool(0u);
+        REQUIRE(emptyPool.ThreadCount() == 1u);
+
+        const ThreadPool pool(4u);
+        REQUIRE(pool.ThreadCount() == 4u);
+
+        REQUIRE(ThreadPool::Default().ThreadCount() >= 1u);
+    }
+
+    TEST_CASE("ThreadPool: Executes all submitted tasks before it is destroyed", "[utils][threadpool]")
+    {
+        constexpr auto TASK_COUNT = 1000u;
+        std::atomic_uint executedTaskCount = 0u;
+
+        {
+            ThreadPool pool(4u);
+            for (auto i = 0u; i < TASK_COUNT; i++)
+            {
+                pool.Submit(
+                    [&executedTaskCount]
+                    {
+                        ++executedTaskCount;
+                    });
+            }
+        }
+
+        REQUIRE(executedTaskCount == TASK_COUNT);
+    }
+
+    TEST_CASE("ThreadPool: Executes tasks on its worker threads", "[utils][threadpool]")
+    {
+        constexpr auto THREAD_COUNT = 4u;
+
+        std::mutex threadIdsMutex;
+        std::set<std::thread::id> threadIds;
+
+        // Every task waits for all others to have started, which only finishes in time when they run at the same time
+        std::atomic_uint startedTaskCount = 0u;
+        std::atomic_bool timedOut = false;
+
+        {
+            ThreadPool pool(THREAD_COUNT);
+            for (auto i = 0u; i < THREAD_COUNT; i++)
+            {
+                pool.Submit(
+                    [&threadIdsMutex, &threadIds, &startedTaskCount, &timedOut]
+                    {
+                        {
+                            std::lock_guard lock(threadIdsMutex);
+                            threadIds.emplace(std::this_thread::get_id());
+                        }
+
+                        ++startedTaskCount;
+
+                        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+                        while (startedTaskCount < THREAD_COUNT)
+                        {
+                            if (std::chrono::steady_clock::now() > deadline)
+                            {
+                                timedOut = true;
+                                return;
+                            }
+
+                            std::this_thread::yield();
+                        }
+                    });
+            }
+        }
+
+        REQUIRE(!timedOut);
+        REQUIRE(threadIds.size() == THREAD_COUNT);
+        REQUIRE(!threadIds.contains(std::this_thread::get_id()));
+    }
+
+    TEST_CASE("ThreadPool: Tasks can submit further tasks", "[utils][threadpool]")
+    {
+        std::atomic_uint executedTaskCount = 0u;
+
+        {
+            ThreadPool pool(2u);
+            pool.Submit(
+                [&pool, &executedTaskCount]
+                {
+                    for (auto i = 0u; i < 10u; i++)
+                    {
+                        pool.Submit(
+                            [&executedTaskCount]
+                            {
+                                ++executedTaskCount;
+                            });
+                    }
+
+                    ++executedTaskCount;
+                });
+        }
+
+        REQUIRE(executedTaskCount == 11u);
+    }
+} // namespace
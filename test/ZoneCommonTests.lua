@@ -46,9 +46,11 @@ function ZoneCommonTests:project()
 		
 		self:include(includes)
 		ZoneCommon:include(includes)
+		zlib:include(includes)
 		catch2:include(includes)
 
 		links:linkto(ZoneCommon)
+		links:linkto(zlib)
 		links:linkto(catch2)
 		links:linkall()
 
@@ -0,0 +1,170 @@
+#include "Zone/XChunk/XChunkProcessorDeflate.h"
+#include "Zone/XChunk/XChunkProcessorInflate.h"
+
+#include <algorithm>
+#include <atomic>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include <zlib.h>
+
+namespace
+{
+    constexpr size_t MAX_CHUNK_SIZE = 0x8000u;
+
+    /**
+     * \brief Creates data that compresses roughly like zone content: repeated structures with varying values.
+     */
+    std::vector<uint8_t> CreateChunk(const size_t size, const uint32_t seed)
+    {
+        std::vector<uint8_t> chunk(size);
+        auto value = seed;
+        for (auto i = 0u; i < size; i++)
+        {
+            if (i % 16u == 0u)
+                value = value * 1664525u + 1013904223u;
+
+            chunk[i] = i % 16u < 4u ? static_cast<uint8_t>(value >> (i % 4u * 8u)) : static_cast<uint8_t>(i % 16u);
+        }
+
+        return chunk;
+    }
+
+    /**
+     * \brief Deflates a chunk the way it was done before contexts were reused: with a new zlib context for every chunk.
+     */
+    size_t DeflateWithNewContext(const std::vector<uint8_t>& input, uint8_t* output, const size_t outputBufferSize)
+    {
+        z_stream stream{};
+        REQUIRE(deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) == Z_OK);
+
+        stream.avail_in = static_cast<uInt>(input.size());
+        stream.next_in = input.data();
+        stream.avail_out = static_cast<uInt>(outputBufferSize);
+        stream.next_out = output;
+
+        REQUIRE(deflate(&stream, Z_FINISH) == Z_STREAM_END);
+        const auto outputSize = static_cast<size_t>(stream.total_out);
+        deflateEnd(&stream);
+
+        return outputSize;
+    }
+
+    size_t InflateWithNewContext(const uint8_t* input, const size_t inputLength, uint8_t* output, const size_t outputBufferSize)
+    {
+        z_stream stream{};
+        REQUIRE(inflateInit2(&stream, -MAX_WBITS) == Z_OK);
+
+        stream.avail_in = static_cast<uInt>(inputLength);
+        stream.next_in = input;
+        stream.avail_out = static_cast<uInt>(outputBufferSize);
+        stream.next_out = output;
+
+        REQUIRE(inflate(&stream, Z_FULL_FLUSH) == Z_STREAM_END);
+        const auto outputSize = static_cast<size_t>(stream.total_out);
+        inflateEnd(&stream);
+
+        return outputSize;
+    }
+
+    TEST_CASE("XChunkProcessorDeflate: Reused contexts produce the same chunks as new ones", "[zone][xchunk]")
+    {
+        XChunkProcessorDeflate deflateProcessor(Z_BEST_COMPRESSION);
+        XChunkProcessorInflate inflateProcessor;
+
+        std::vector<uint8_t> compressed(MAX_CHUNK_SIZE * 2u);
+        std::vector<uint8_t> expectedCompressed(MAX_CHUNK_SIZE * 2u);
+        std::vector<uint8_t> decompressed(MAX_CHUNK_SIZE);
+
+        // The last chunk of a zone is usually smaller than the others
+        const std::vector<size_t> chunkSizes{MAX_CHUNK_SIZE, 512u, 1u, MAX_CHUNK_SIZE, 4096u, 0u, 12345u};
+        for (auto i = 0u; i < chunkSizes.size(); i++)
+        {
+            INFO("Chunk " << i << " with size " << chunkSizes[i]);
+            const auto chunk = CreateChunk(chunkSizes[i], i);
+
+            const auto compressedSize = deflateProcessor.Process(0, chunk.data(), chunk.size(), compressed.data(), compressed.size());
+            const auto expectedCompressedSize = DeflateWithNewContext(chunk, expectedCompressed.data(), expectedCompressed.size());
+            REQUIRE(compressedSize == expectedCompressedSize);
+            REQUIRE(std::equal(compressed.begin(), compressed.begin() + compressedSize, expectedCompressed.begin()));
+
+            const auto decompressedSize = inflateProcessor.Process(0, compressed.data(), compressedSize, decompressed.data(), decompressed.size());
+            REQUIRE(decompressedSize == chunk.size());
+            REQUIRE(std::equal(chunk.begin(), chunk.end(), decompressed.begin()));
+        }
+    }
+
+    TEST_CASE("XChunkProcessorDeflate: Chunks can be processed concurrently", "[zone][xchunk]")
+    {
+        XChunkProcessorDeflate deflateProcessor(Z_BEST_COMPRESSION);
+        XChunkProcessorInflate inflateProcessor;
+
+        // Assertions cannot be made on other threads
+        std::atomic_bool mismatch = false;
+
+        std::vector<std::thread> threads;
+        for (auto threadIndex = 0u; threadIndex < 4u; threadIndex++)
+        {
+            threads.emplace_back(
+                [&deflateProcessor, &inflateProcessor, &mismatch, threadIndex]
+                {
+                    std::vector<uint8_t> compressed(MAX_CHUNK_SIZE * 2u);
+                    std::vector<uint8_t> decompressed(MAX_CHUNK_SIZE);
+                    for (auto i = 0u; i < 50u; i++)
+                    {
+                        const auto chunk = CreateChunk(1000u + i * 300u, threadIndex * 100u + i);
+                        const auto compressedSize =
+                            deflateProcessor.Process(static_cast<int>(threadIndex), chunk.data(), chunk.size(), compressed.data(), compressed.size());
+                        const auto decompressedSize =
+                            inflateProcessor.Process(static_cast<int>(threadIndex), compressed.data(), compressedSize, decompressed.data(), decompressed.size());
+
+                        if (decompressedSize != chunk.size() || !std::equal(chunk.begin(), chunk.end(), decompressed.begin()))
+                            mismatch = true;
+                    }
+                });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        REQUIRE(!mismatch);
+    }
+
+    TEST_CASE("XChunkProcessorDeflate: Benchmark reusing zlib contexts", "[.benchmark][zone][xchunk]")
+    {
+        // Many small chunks are where the cost of initializing a zlib context matters the most
+        const auto chunkSize = GENERATE(static_cast<size_t>(512u), static_cast<size_t>(4096u), MAX_CHUNK_SIZE);
+        const auto chunk = CreateChunk(chunkSize, 1u);
+
+        XChunkProcessorDeflate deflateProcessor(Z_BEST_COMPRESSION);
+        XChunkProcessorInflate inflateProcessor;
+
+        std::vector<uint8_t> compressed(MAX_CHUNK_SIZE * 2u);
+        std::vector<uint8_t> decompressed(MAX_CHUNK_SIZE);
+        const auto compressedSize = deflateProcessor.Process(0, chunk.data(), chunk.size(), compressed.data(), compressed.size());
+
+        BENCHMARK("Deflate " + std::to_string(chunkSize) + " byte chunk with a new context")
+        {
+            return DeflateWithNewContext(chunk, compressed.data(), compressed.size());
+        };
+
+        BENCHMARK("Deflate " + std::to_string(chunkSize) + " byte chunk with a reused context")
+        {
+            return deflateProcessor.Process(0, chunk.data(), chunk.size(), compressed.data(), compressed.size());
+        };
+
+        BENCHMARK("Inflate " + std::to_string(chunkSize) + " byte chunk with a new context")
+        {
+            return InflateWithNewContext(compressed.data(), compressedSize, decompressed.data(), decompressed.size());
+        };
+
+        BENCHMARK("Inflate " + std::to_string(chunkSize) + " byte chunk with a reused context")
+        {
+            return inflateProcessor.Process(0, compressed.data(), compressedSize, decompressed.data(), decompressed.size());
+        };
+    }
+} // namespace
@@ -0,0 +1,94 @@
+#include "Loading/LoadingMappedFileStream.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <random>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    class TempFile
+    {
+    public:
+        explicit TempFile(const std::string& data)
+            : m_path(fs::temp_directory_path() / std::format("oat_mapped_file_test_{:08x}.bin", std::random_device()()))
+        {
+            std::ofstream stream(m_path, std::ios::out | std::ios::binary | std::ios::trunc);
+            stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+        }
+
+        ~TempFile()
+        {
+            std::error_code ec;
+            fs::remove(m_path, ec);
+        }
+
+        TempFile(const TempFile& other) = delete;
+        TempFile(TempFile&& other) noexcept = delete;
+        TempFile& operator=(const TempFile& other) = delete;
+        TempFile& operator=(TempFile&& other) noexcept = delete;
+
+        [[nodiscard]] std::string Path() const
+        {
+            return m_path.string();
+        }
+
+    private:
+        fs::path m_path;
+    };
+
+    TEST_CASE("LoadingMappedFileStream: Can load data of a file", "[zoneloading][stream]")
+    {
+        const TempFile file("Hello World");
+        const auto stream = LoadingMappedFileStream::Open(file.Path());
+        REQUIRE(stream);
+
+        char buffer[6]{};
+        REQUIRE(stream->Load(buffer, 5) == 5);
+        REQUIRE(std::string(buffer) == "Hello");
+        REQUIRE(stream->Pos() == 5);
+
+        const auto inPlaceData = stream->LoadInPlace(1);
+        REQUIRE(inPlaceData.size() == 1);
+        REQUIRE(inPlaceData[0] == ' ');
+        REQUIRE(stream->Pos() == 6);
+    }
+
+    TEST_CASE("LoadingMappedFileStream: Loads less data at the end of a file", "[zoneloading][stream]")
+    {
+        const TempFile file("Hello World");
+        const auto stream = LoadingMappedFileStream::Open(file.Path());
+        REQUIRE(stream);
+
+        char buffer[32]{};
+        REQUIRE(stream->Load(buffer, sizeof(buffer)) == 11);
+        REQUIRE(std::string(buffer) == "Hello World");
+
+        REQUIRE(stream->Load(buffer, sizeof(buffer)) == 0);
+        REQUIRE(stream->LoadInPlace(sizeof(buffer)).empty());
+        REQUIRE(stream->Pos() == 11);
+    }
+
+    TEST_CASE("LoadingMappedFileStream: Can load from empty files", "[zoneloading][stream]")
+    {
+        const TempFile file("");
+        const auto stream = LoadingMappedFileStream::Open(file.Path());
+        REQUIRE(stream);
+
+        char buffer[8]{};
+        REQUIRE(stream->Load(buffer, sizeof(buffer)) == 0);
+        REQUIRE(stream->LoadInPlace(sizeof(buffer)).empty());
+        REQUIRE(stream->Pos() == 0);
+    }
+
+    TEST_CASE("LoadingMappedFileStream: Cannot open files that do not exist", "[zoneloading][stream]")
+    {
+        const auto path = fs::temp_directory_path() / std::format("oat_mapped_file_test_{:08x}.missing", std::random_device()());
+
+        REQUIRE(!LoadingMappedFileStream::Open(path.string()));
+    }
+} // namespace
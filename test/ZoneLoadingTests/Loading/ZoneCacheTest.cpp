@@ -0,0 +1,231 @@
+#include "Loading/ZoneCache.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    class TempFolder
+    {
+    public:
+        TempFolder()
+            : m_path(fs::temp_directory_path() / std::format("oat_zone_cache_test_{:08x}", std::random_device()()))
+        {
+            fs::create_directories(m_path);
+        }
+
+        ~TempFolder()
+        {
+            std::error_code ec;
+            fs::remove_all(m_path, ec);
+        }
+
+        TempFolder(const TempFolder& other) = delete;
+        TempFolder(TempFolder&& other) noexcept = delete;
+        TempFolder& operator=(const TempFolder& other) = delete;
+        TempFolder& operator=(TempFolder&& other) noexcept = delete;
+
+        [[nodiscard]] const fs::path& Path() const
+        {
+            return m_path;
+        }
+
+    private:
+        fs::path m_path;
+    };
+
+    void WriteFile(const fs::path& path, const std::vector<char>& data)
+    {
+        std::ofstream stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+        REQUIRE(stream.good());
+    }
+
+    std::vector<char> CreateFastFileData(const size_t size)
+    {
+        std::vector<char> data(size);
+        for (auto i = 0u; i < size; i++)
+            data[i] = static_cast<char>(i * 31u + 7u);
+
+        return data;
+    }
+
+    std::string ComputeKey(const fs::path& path)
+    {
+        std::string key;
+        REQUIRE(ZoneCache::ComputeKey(path.string(), key));
+        REQUIRE(!key.empty());
+
+        return key;
+    }
+
+    std::string ComputeContentHash(const fs::path& path)
+    {
+        std::string contentHash;
+        REQUIRE(ZoneCache::ComputeContentHash(path.string(), contentHash));
+        REQUIRE(!contentHash.empty());
+
+        return contentHash;
+    }
+
+    TEST_CASE("ZoneCache: Key of an unchanged fastfile stays the same", "[zoneloading][zonecache]")
+    {
+        TempFolder folder;
+        const auto fastFilePath = folder.Path() / "test.ff";
+        WriteFile(fastFilePath, CreateFastFileData(0x3000));
+
+        REQUIRE(ComputeKey(fastFilePath) == ComputeKey(fastFilePath));
+    }
+
+    TEST_CASE("ZoneCache: Key changes when the header of the fastfile changes", "[zoneloading][zonecache]")
+    {
+        TempFolder folder;
+        const auto fastFilePath = folder.Path() / "test.ff";
+        auto data = CreateFastFileData(0x3000);
+        WriteFile(fastFilePath, data);
+
+        const auto lastWriteTime = fs::last_write_time(fastFilePath);
+        const auto originalKey = ComputeKey(fastFilePath);
+
+        // Keep size and modification time so only the changed content can make the key differ
+        data[0x10] = static_cast<char>(data[0x10] + 1);
+        WriteFile(fastFilePath, data);
+        fs::last_write_time(fastFilePath, lastWriteTime);
+
+        REQUIRE(ComputeKey(fastFilePath) != originalKey);
+    }
+
+    TEST_CASE("ZoneCache: Key changes when size or modification time of the fastfile change", "[zoneloading][zonecache]")
+    {
+        TempFolder folder;
+        const auto fastFilePath = folder.Path() / "test.ff";
+        auto data = CreateFastFileData(0x3000);
+        WriteFile(fastFilePath, data);
+
+        const auto lastWriteTime = fs::last_write_time(fastFilePath);
+        const auto originalKey = ComputeKey(fastFilePath);
+
+        SECTION("Size")
+        {
+            data.push_back('\0');
+            WriteFile(fastFilePath, data);
+            fs::last_write_time(fastFilePath, lastWriteTime);
+
+            REQUIRE(ComputeKey(fastFilePath) != originalKey);
+        }
+
+        SECTION("Modification time")
+        {
+            fs::last_write_time(fastFilePath, lastWriteTime + std::chrono::seconds(10));
+
+            REQUIRE(ComputeKey(fastFilePath) != originalKey);
+        }
+    }
+
+    TEST_CASE("ZoneCache: Can open committed entries", "[zoneloading][zonecache]")
+    {
+        TempFolder folder;
+        const auto fastFilePath = folder.Path() / "test.ff";
+        WriteFile(fastFilePath, CreateFastFileData(0x3000));
+
+        const ZoneCache cache(folder.Path() / "cache");
+        const auto key = ComputeKey(fastFilePath);
+
+        const std::string data = "plain xfile data";
+        {
+            const auto entry = cache.Create("test", key, ComputeContentHash(fastFilePath));
+            REQUIRE(entry);
+            entry->Stream().write(data.data(), static_cast<std::streamsize>(data.size()));
+            REQUIRE(entry->Commit());
+        }
+
+        const auto stream = cache.Open("test", key, fastFilePath.string());
+        REQUIRE(stream);
+
+        std::string loadedData(data.size(), '\0');
+        REQUIRE(stream->Load(loadedData.data(), loadedData.size()) == data.size());
+        REQUIRE(loadedData == data);
+
+        REQUIRE(!cache.Open("test", "other_key", fastFilePath.string()));
+    }
+
+    TEST_CASE("ZoneCache: Entries that are not committed are discarded", "[zoneloading][zonecache]")
+    {
+        TempFolder folder;
+        const auto fastFilePath = folder.Path() / "test.ff";
+        WriteFile(fastFilePath, CreateFastFileData(0x3000));
+
+        const ZoneCache cache(folder.Path() / "cache");
+        const auto key = ComputeKey(fastFilePath);
+
+        {
+            const auto entry = cache.Create("test", key, ComputeContentHash(fastFilePath));
+            REQUIRE(entry);
+            entry->Stream() << "incomplete data";
+        }
+
+        REQUIRE(!cache.Open("test", key, fastFilePath.string()));
+        REQUIRE(fs::is_empty(folder.Path() / "cache"));
+    }
+
+    TEST_CASE("ZoneCache: Removed entries cannot be opened anymore", "[zoneloading][zonecache]")
+    {
+        TempFolder folder;
+        const auto fastFilePath = folder.Path() / "test.ff";
+        WriteFile(fastFilePath, CreateFastFileData(0x3000));
+
+        const ZoneCache cache(folder.Path() / "cache");
+        const auto key = ComputeKey(fastFilePath);
+
+        {
+            const auto entry = cache.Create("test", key, ComputeContentHash(fastFilePath));
+            REQUIRE(entry);
+            entry->Stream() << "corrupt data";
+            REQUIRE(entry->Commit());
+        }
+
+        REQUIRE(cache.Open("test", key, fastFilePath.string()));
+
+        cache.Remove("test", key);
+
+        REQUIRE(!cache.Open("test", key, fastFilePath.string()));
+    }
+
+    TEST_CASE("ZoneCache: Entries of fastfiles edited without changing size, modification time and header are not used", "[zoneloading][zonecache]")
+    {
+        TempFolder folder;
+        const auto fastFilePath = folder.Path() / "test.ff";
+        auto data = CreateFastFileData(0x3000);
+        WriteFile(fastFilePath, data);
+
+        const auto lastWriteTime = fs::last_write_time(fastFilePath);
+        const auto key = ComputeKey(fastFilePath);
+
+        const ZoneCache cache(folder.Path() / "cache");
+        {
+            const auto entry = cache.Create("test", key, ComputeContentHash(fastFilePath));
+            REQUIRE(entry);
+            entry->Stream() << "plain xfile data";
+            REQUIRE(entry->Commit());
+        }
+
+        // Like copying a file while preserving its modification time, i.e. with "cp -p"
+        data[0x2000] = static_cast<char>(data[0x2000] + 1);
+        WriteFile(fastFilePath, data);
+        fs::last_write_time(fastFilePath, lastWriteTime);
+
+        REQUIRE(ComputeKey(fastFilePath) == key);
+        REQUIRE(!cache.Open("test", key, fastFilePath.string()));
+
+        // The outdated entry is removed
+        REQUIRE(fs::is_empty(folder.Path() / "cache"));
+    }
+} // namespace
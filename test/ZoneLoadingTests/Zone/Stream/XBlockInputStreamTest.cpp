@@ -0,0 +1,101 @@
+#include "Zone/Stream/Impl/XBlockInputStream.h"
+
+#include "Loading/Exception/InvalidOffsetBlockException.h"
+#include "Loading/Exception/InvalidOffsetBlockOffsetException.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    constexpr int BLOCK_BIT_COUNT = 4;
+    constexpr auto BLOCK_SHIFT = sizeof(uintptr_t) * 8u - BLOCK_BIT_COUNT;
+
+    class TestBlocks
+    {
+    public:
+        std::vector<std::unique_ptr<XBlock>> m_owned_blocks;
+        std::vector<XBlock*> m_blocks;
+
+        explicit TestBlocks(const std::vector<size_t>& blockSizes)
+        {
+            for (auto i = 0u; i < blockSizes.size(); i++)
+            {
+                auto block = std::make_unique<XBlock>("block", static_cast<int>(i), XBlock::Type::BLOCK_TYPE_NORMAL);
+                block->Alloc(blockSizes[i]);
+
+                m_blocks.emplace_back(block.get());
+                m_owned_blocks.emplace_back(std::move(block));
+            }
+        }
+    };
+
+    void* MakeOffset(const uintptr_t block, const uintptr_t blockOffset)
+    {
+        // Offsets are moved by 1 so that block 0 offset 0 is not a nullptr
+        return reinterpret_cast<void*>((block << BLOCK_SHIFT | blockOffset) + 1u);
+    }
+
+    TEST_CASE("XBlockInputStream: Resolves offsets to the buffers of their blocks", "[zoneloading][stream]")
+    {
+        TestBlocks blocks({0x100u, 0u, 0x2000u});
+        const XBlockInputStream stream(blocks.m_blocks, nullptr, BLOCK_BIT_COUNT, 0);
+
+        REQUIRE(stream.ConvertOffsetToPointer(MakeOffset(0u, 0u)) == blocks.m_blocks[0]->m_buffer);
+        REQUIRE(stream.ConvertOffsetToPointer(MakeOffset(0u, 0xFFu)) == blocks.m_blocks[0]->m_buffer + 0xFFu);
+        REQUIRE(stream.ConvertOffsetToPointer(MakeOffset(2u, 0x1234u)) == blocks.m_blocks[2]->m_buffer + 0x1234u);
+    }
+
+    TEST_CASE("XBlockInputStream: Resolves aliases to the pointers stored in blocks", "[zoneloading][stream]")
+    {
+        TestBlocks blocks({0x100u});
+        const XBlockInputStream stream(blocks.m_blocks, nullptr, BLOCK_BIT_COUNT, 0);
+
+        int value = 0;
+        *reinterpret_cast<void**>(blocks.m_blocks[0]->m_buffer + 0x10u) = &value;
+
+        REQUIRE(stream.ConvertOffsetToAlias(MakeOffset(0u, 0x10u)) == &value);
+    }
+
+    TEST_CASE("XBlockInputStream: Throws for offsets outside of blocks", "[zoneloading][stream]")
+    {
+        TestBlocks blocks({0x100u, 0u});
+        const XBlockInputStream stream(blocks.m_blocks, nullptr, BLOCK_BIT_COUNT, 0);
+
+        REQUIRE_THROWS_AS(stream.ConvertOffsetToPointer(MakeOffset(0u, 0x100u)), InvalidOffsetBlockOffsetException);
+        REQUIRE_THROWS_AS(stream.ConvertOffsetToPointer(MakeOffset(1u, 0u)), InvalidOffsetBlockOffsetException);
+        REQUIRE_THROWS_AS(stream.ConvertOffsetToPointer(MakeOffset(5u, 0u)), InvalidOffsetBlockException);
+        REQUIRE_THROWS_AS(stream.ConvertOffsetToAlias(MakeOffset(0u, 0xFCu)), InvalidOffsetBlockOffsetException);
+        REQUIRE_THROWS_AS(stream.ConvertOffsetToAlias(MakeOffset(5u, 0u)), InvalidOffsetBlockException);
+    }
+
+    TEST_CASE("XBlockInputStream: Benchmark resolving offsets", "[.benchmark][zoneloading][stream]")
+    {
+        // Pointer heavy assets like a GfxWorld resolve offsets spread over all blocks
+        constexpr auto BLOCK_SIZE = 16u * 1024u * 1024u;
+        constexpr auto OFFSET_COUNT = 4u * 1024u * 1024u;
+
+        TestBlocks blocks({BLOCK_SIZE, BLOCK_SIZE, BLOCK_SIZE, BLOCK_SIZE, BLOCK_SIZE, BLOCK_SIZE, BLOCK_SIZE});
+        const XBlockInputStream stream(blocks.m_blocks, nullptr, BLOCK_BIT_COUNT, 0);
+
+        std::vector<void*> offsets(OFFSET_COUNT);
+        auto value = 0x12345678u;
+        for (auto& offset : offsets)
+        {
+            value = value * 1664525u + 1013904223u;
+            offset = MakeOffset(value % blocks.m_blocks.size(), (value >> 8u) % BLOCK_SIZE);
+        }
+
+        BENCHMARK_ADVANCED("ConvertOffsetToPointer per pointer")(Catch::Benchmark::Chronometer meter)
+        {
+            meter.measure(
+                [&stream, &offsets](const int i)
+                {
+                    return stream.ConvertOffsetToPointer(offsets[static_cast<size_t>(i) % OFFSET_COUNT]);
+                });
+        };
+    }
+} // namespace
@@ -0,0 +1,220 @@
+#include "Zone/Stream/Impl/InMemoryZoneOutputStream.h"
+
+#include "Writing/InMemoryZoneData.h"
+
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+namespace
+{
+    constexpr int BLOCK_BIT_COUNT = 4;
+    constexpr block_t NORMAL_BLOCK = 0;
+    constexpr block_t INSERT_BLOCK = 1;
+
+    class TestZoneOutput
+    {
+    public:
+        std::vector<std::unique_ptr<XBlock>> m_blocks;
+        InMemoryZoneData m_zone_data;
+        std::unique_ptr<InMemoryZoneOutputStream> m_stream;
+
+        TestZoneOutput()
+        {
+            m_blocks.emplace_back(std::make_unique<XBlock>("normal", NORMAL_BLOCK, XBlock::Type::BLOCK_TYPE_NORMAL));
+            m_blocks.emplace_back(std::make_unique<XBlock>("insert", INSERT_BLOCK, XBlock::Type::BLOCK_TYPE_NORMAL));
+
+            std::vector<XBlock*> blocks;
+            for (const auto& block : m_blocks)
+                blocks.emplace_back(block.get());
+
+            m_stream = std::make_unique<InMemoryZoneOutputStream>(&m_zone_data, std::move(blocks), BLOCK_BIT_COUNT, INSERT_BLOCK, false, nullptr);
+            m_stream->PushBlock(NORMAL_BLOCK);
+        }
+
+        ~TestZoneOutput()
+        {
+            m_stream->PopBlock();
+        }
+
+        TestZoneOutput(const TestZoneOutput& other) = delete;
+        TestZoneOutput(TestZoneOutput&& other) noexcept = delete;
+        TestZoneOutput& operator=(const TestZoneOutput& other) = delete;
+        TestZoneOutput& operator=(TestZoneOutput&& other) noexcept = delete;
+
+        /**
+         * \brief Adds an entry like a writer does after writing reusable data and returns the zone pointer it was written to.
+         */
+        uintptr_t AddEntry(uint8_t* ptr, const size_t entrySize, const size_t count) const
+        {
+            const auto zonePtr = CurrentZonePointer();
+            m_stream->ReusableAddOffset(ptr, entrySize, count, std::type_index(typeid(uint8_t)));
+            m_stream->IncBlockPos(entrySize * count);
+
+            return zonePtr;
+        }
+
+        /**
+         * \return The zone pointer the data is resolved to or \c 0 if it still has to be written.
+         */
+        [[nodiscard]] uintptr_t Resolve(uint8_t* ptr, const size_t entrySize = 1u) const
+        {
+            auto* resolvedPtr = reinterpret_cast<void*>(ptr);
+            if (m_stream->ReusableShouldWrite(&resolvedPtr, entrySize, std::type_index(typeid(uint8_t))))
+                return 0u;
+
+            return reinterpret_cast<uintptr_t>(resolvedPtr);
+        }
+
+        [[nodiscard]] uintptr_t CurrentZonePointer() const
+        {
+            return (m_blocks[NORMAL_BLOCK]->m_buffer_size | static_cast<uintptr_t>(NORMAL_BLOCK) << (sizeof(uintptr_t) * 8u - BLOCK_BIT_COUNT)) + 1u;
+        }
+    };
+
+    /**
+     * \brief Resolves pointers by scanning all entries in the order they were added, which is what the stream did before indexing them.
+     */
+    class LinearReusableEntries
+    {
+    public:
+        class Entry
+        {
+        public:
+            uintptr_t m_start;
+            uintptr_t m_end;
+            uintptr_t m_zone_ptr;
+        };
+
+        std::vector<Entry> m_entries;
+
+        void Add(const uint8_t* ptr, const size_t size, const uintptr_t zonePtr)
+        {
+            m_entries.emplace_back(reinterpret_cast<uintptr_t>(ptr), reinterpret_cast<uintptr_t>(ptr) + size, zonePtr);
+        }
+
+        [[nodiscard]] uintptr_t Resolve(const uint8_t* ptr) const
+        {
+            const auto address = reinterpret_cast<uintptr_t>(ptr);
+            for (const auto& entry : m_entries)
+            {
+                if (address >= entry.m_start && address < entry.m_end)
+                    return entry.m_zone_ptr + (address - entry.m_start);
+            }
+
+            return 0u;
+        }
+    };
+
+    TEST_CASE("InMemoryZoneOutputStream: Resolves pointers into reusable entries", "[zonewriting][stream]")
+    {
+        TestZoneOutput output;
+        std::vector<uint8_t> memory(0x100u);
+
+        output.m_stream->IncBlockPos(0x40u);
+        const auto zonePtr = output.AddEntry(&memory[0x10u], 4u, 8u);
+
+        REQUIRE(output.Resolve(&memory[0x10u], 4u) == zonePtr);
+        REQUIRE(output.Resolve(&memory[0x18u], 4u) == zonePtr + 8u);
+        REQUIRE(output.Resolve(&memory[0x2Cu], 4u) == zonePtr + 0x1Cu);
+        REQUIRE(output.Resolve(&memory[0x0Cu], 4u) == 0u);
+        REQUIRE(output.Resolve(&memory[0x30u], 4u) == 0u);
+    }
+
+    TEST_CASE("InMemoryZoneOutputStream: Overlapping entries resolve to the earliest added entry", "[zonewriting][stream]")
+    {
+        TestZoneOutput output;
+        std::vector<uint8_t> memory(0x100u);
+
+        const auto firstZonePtr = output.AddEntry(&memory[0x40u], 1u, 0x20u);
+        const auto secondZonePtr = output.AddEntry(&memory[0x30u], 1u, 0x40u);
+        const auto thirdZonePtr = output.AddEntry(&memory[0x00u], 1u, 0x100u);
+
+        REQUIRE(output.Resolve(&memory[0x00u]) == thirdZonePtr);
+        REQUIRE(output.Resolve(&memory[0x30u]) == secondZonePtr);
+        REQUIRE(output.Resolve(&memory[0x45u]) == firstZonePtr + 0x05u);
+        REQUIRE(output.Resolve(&memory[0x60u]) == secondZonePtr + 0x30u);
+        REQUIRE(output.Resolve(&memory[0x70u]) == thirdZonePtr + 0x70u);
+        REQUIRE(output.Resolve(&memory[0xFFu]) == thirdZonePtr + 0xFFu);
+    }
+
+    TEST_CASE("InMemoryZoneOutputStream: Resolves pointers like scanning all entries in order", "[zonewriting][stream]")
+    {
+        const auto seed = GENERATE(1u, 2u, 3u);
+
+        TestZoneOutput output;
+        LinearReusableEntries reference;
+        std::vector<uint8_t> memory(0x10000u);
+
+        auto value = seed;
+        const auto next = [&value](const uint32_t max)
+        {
+            value = value * 1664525u + 1013904223u;
+            return (value >> 8u) % max;
+        };
+
+        for (auto i = 0u; i < 20000u; i++)
+        {
+            if (next(3u) == 0u)
+            {
+                const auto start = next(static_cast<uint32_t>(memory.size()));
+                const auto size = 1u + next(std::min(0x400u, static_cast<uint32_t>(memory.size()) - start));
+                reference.Add(&memory[start], size, output.AddEntry(&memory[start], 1u, size));
+            }
+            else
+            {
+                auto* ptr = &memory[next(static_cast<uint32_t>(memory.size()))];
+                REQUIRE(output.Resolve(ptr) == reference.Resolve(ptr));
+            }
+        }
+    }
+
+    TEST_CASE("InMemoryZoneOutputStream: Benchmark reusable entry lookups", "[.benchmark][zonewriting][stream]")
+    {
+        const auto entryCount = GENERATE(5000u, 50000u);
+
+        // Shared assets are spread over the memory of the zone being written
+        constexpr auto ENTRY_SIZE = 64u;
+        std::vector<uint8_t> memory(static_cast<size_t>(entryCount) * ENTRY_SIZE * 2u);
+
+        std::vector<uint8_t*> pointers;
+        for (auto i = 0u; i < entryCount; i++)
+            pointers.emplace_back(&memory[(static_cast<size_t>(i) * 7919u % (entryCount * 2u)) * ENTRY_SIZE]);
+
+        BENCHMARK("Add " + std::to_string(entryCount) + " entries and look up a pointer after each")
+        {
+            TestZoneOutput output;
+            uintptr_t result = 0u;
+            for (auto* ptr : pointers)
+            {
+                result += output.Resolve(ptr, ENTRY_SIZE);
+                output.AddEntry(ptr, ENTRY_SIZE, 1u);
+            }
+
+            return result;
+        };
+
+        // Scanning all entries is quadratic, so it is only compared with the smaller amount of entries
+        if (entryCount <= 5000u)
+        {
+            BENCHMARK("Add " + std::to_string(entryCount) + " entries and look up a pointer after each by scanning all entries")
+            {
+                LinearReusableEntries entries;
+                uintptr_t result = 0u;
+                for (auto* ptr : pointers)
+                {
+                    result += entries.Resolve(ptr);
+                    entries.Add(ptr, ENTRY_SIZE, 1u);
+                }
+
+                return result;
+            };
+        }
+    }
+} // namespace
@@ -0,0 +1,155 @@
+#include "ZoneWriting.h"
+
+#include "Game/IW3/GameAssetPoolIW3.h"
+#include "Game/IW3/IW3.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <sstream>
+#include <string>
+
+using namespace IW3;
+
+namespace
+{
+    class ConfigurationRestorer
+    {
+    public:
+        ConfigurationRestorer()
+            : m_configuration(ZoneWriting::Configuration)
+        {
+        }
+
+        ~ConfigurationRestorer()
+        {
+            ZoneWriting::Configuration = m_configuration;
+        }
+
+        ConfigurationRestorer(const ConfigurationRestorer& other) = delete;
+        ConfigurationRestorer(ConfigurationRestorer&& other) noexcept = delete;
+        ConfigurationRestorer& operator=(const ConfigurationRestorer& other) = delete;
+        ConfigurationRestorer& operator=(ConfigurationRestorer&& other) noexcept = delete;
+
+    private:
+        ZoneWriting::Configuration_t m_configuration;
+    };
+
+    RawFile* CreateRawFile(ZoneMemory& memory, const std::string& name, const size_t size, uint32_t seed)
+    {
+        auto* buffer = memory.Alloc<char>(size + 1);
+        for (auto i = 0u; i < size; i++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            buffer[i] = static_cast<char>(seed >> 24);
+        }
+        buffer[size] = '\0';
+
+        auto* rawFile = memory.Alloc<RawFile>();
+        rawFile->name = memory.Dup(name.c_str());
+        rawFile->len = static_cast<int>(size);
+        rawFile->buffer = buffer;
+
+        return rawFile;
+    }
+
+    StringTable* CreateStringTable(ZoneMemory& memory, const std::string& name, const int columnCount, const int rowCount)
+    {
+        auto* stringTable = memory.Alloc<StringTable>();
+        stringTable->name = memory.Dup(name.c_str());
+        stringTable->columnCount = columnCount;
+        stringTable->rowCount = rowCount;
+        stringTable->values = memory.Alloc<const char*>(static_cast<size_t>(columnCount) * rowCount);
+
+        // Only a few distinct values, so the same strings are written many times
+        for (auto i = 0; i < columnCount * rowCount; i++)
+            stringTable->values[i] = memory.Dup(std::format("value{}", i % 7).c_str());
+
+        return stringTable;
+    }
+
+    LocalizeEntry* CreateLocalizeEntry(ZoneMemory& memory, const std::string& name, const std::string& value)
+    {
+        auto* localizeEntry = memory.Alloc<LocalizeEntry>();
+        localizeEntry->name = memory.Dup(name.c_str());
+        localizeEntry->value = memory.Dup(value.c_str());
+
+        return localizeEntry;
+    }
+
+    std::unique_ptr<Zone> CreateTestZone()
+    {
+        auto zone = std::make_unique<Zone>("test_zone", 0, IGame::GetGameById(GameId::IW3));
+        zone->m_pools = std::make_unique<GameAssetPoolIW3>(zone.get(), zone->m_priority);
+        for (auto assetType = 0; assetType < ASSET_TYPE_COUNT; assetType++)
+            zone->m_pools->InitPoolDynamic(assetType);
+
+        auto& memory = *zone->GetMemory();
+
+        // Larger than a single buffer of the in memory zone data
+        auto* bigRawFile = CreateRawFile(memory, "test/big.txt", 5 * 1024 * 1024 + 123, 1);
+        zone->m_pools->AddAsset(ASSET_TYPE_RAWFILE, bigRawFile->name, bigRawFile, {}, {}, {});
+
+        auto* smallRawFile = CreateRawFile(memory, "test/small.txt", 1000, 2);
+        zone->m_pools->AddAsset(ASSET_TYPE_RAWFILE, smallRawFile->name, smallRawFile, {}, {}, {});
+
+        // Same content as the previous raw file
+        auto* duplicateRawFile = CreateRawFile(memory, "test/small_copy.txt", 1000, 2);
+        zone->m_pools->AddAsset(ASSET_TYPE_RAWFILE, duplicateRawFile->name, duplicateRawFile, {}, {}, {});
+
+        auto* stringTable = CreateStringTable(memory, "mp/test_table.csv", 5, 20);
+        zone->m_pools->AddAsset(ASSET_TYPE_STRINGTABLE, stringTable->name, stringTable, {}, {}, {});
+
+        for (auto i = 0; i < 10; i++)
+        {
+            auto* localizeEntry = CreateLocalizeEntry(memory, std::format("TEST_ENTRY_{}", i), std::format("Value {}", i % 3));
+            zone->m_pools->AddAsset(ASSET_TYPE_LOCALIZE_ENTRY, localizeEntry->name, localizeEntry, {}, {}, {});
+        }
+
+        return zone;
+    }
+
+    std::string WriteTestZone(Zone& zone, const bool streamContent, const bool deduplicateContent)
+    {
+        ZoneWriting::Configuration.StreamContent = streamContent;
+        ZoneWriting::Configuration.DeduplicateContent = deduplicateContent;
+
+        std::ostringstream stream;
+        REQUIRE(ZoneWriting::WriteZone(stream, &zone));
+
+        return stream.str();
+    }
+
+    TEST_CASE("ZoneWriting: Streaming content writes the same zone as writing it to memory", "[zonewriting]")
+    {
+        ConfigurationRestorer restorer;
+        ZoneWriting::Configuration = ZoneWriting::Configuration_t();
+
+        const auto deduplicateContent = GENERATE(false, true);
+
+        const auto zone = CreateTestZone();
+        const auto inMemoryData = WriteTestZone(*zone, false, deduplicateContent);
+        const auto streamedData = WriteTestZone(*zone, true, deduplicateContent);
+
+        REQUIRE(!inMemoryData.empty());
+        REQUIRE(inMemoryData.size() == streamedData.size());
+        REQUIRE(inMemoryData == streamedData);
+    }
+
+    TEST_CASE("ZoneWriting: Writing the same zone twice writes the same data", "[zonewriting]")
+    {
+        ConfigurationRestorer restorer;
+        ZoneWriting::Configuration = ZoneWriting::Configuration_t();
+
+        const auto streamContent = GENERATE(false, true);
+        const auto deduplicateContent = GENERATE(false, true);
+
+        const auto zone = CreateTestZone();
+        const auto firstData = WriteTestZone(*zone, streamContent, deduplicateContent);
+        const auto secondData = WriteTestZone(*zone, streamContent, deduplicateContent);
+
+        REQUIRE(firstData == secondData);
+    }
+} // namespace